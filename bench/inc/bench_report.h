@@ -0,0 +1,85 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   bench_report.h
+ *
+ * @brief  Header file for benchmark statistics and machine-readable output
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup BenchModules
+ * @brief    Benchmark modules for measuring the engine
+ * @{
+ */
+
+/**
+ * @brief   Distribution of a set of timing samples
+ */
+struct SampleSummary {
+  double mean; /**< Arithmetic mean */
+  double min;  /**< Fastest sample */
+  double p50;  /**< Median */
+  double p90;  /**< 90th percentile */
+  double p99;  /**< 99th percentile */
+  double max;  /**< Slowest sample */
+};
+
+/**
+ * @brief   Summarise timing samples, percentiles use the nearest rank
+ * @param   samples Samples in any order, empty gives all zeros
+ */
+SampleSummary summarizeSamples(std::vector<double> samples);
+
+/**
+ * @brief   One line of benchmark output, a flat JSON object
+ * @details Every benchmark writes one record per result, so a run's output is JSON lines that scripts can filter and compare
+ *          without parsing anything else. Records start with a "kind" field saying which fields follow
+ */
+class BenchRecord {
+ public:
+  explicit BenchRecord(const char *kind);
+
+  BenchRecord &add(const char *key, const char *value);
+  BenchRecord &add(const char *key, const std::string &value);
+  BenchRecord &add(const char *key, double value);
+  BenchRecord &add(const char *key, uint64_t value);
+  BenchRecord &add(const char *key, uint32_t value);
+
+  /**
+   * @brief   Add the summary as prefixMean, prefixP50, ..., with every value multiplied by scale
+   */
+  BenchRecord &add(const char *prefix, const SampleSummary &summary, double scale = 1.0);
+
+  /**
+   * @brief   Write the record as one line and flush, so partial runs still leave complete lines
+   */
+  void write(std::ostream &out) const;
+
+ private:
+  std::string text;
+
+  void addKey(const char *key);
+};
+
+/**
+ * @brief   Stop the compiler from optimising away the computation of a value
+ */
+template <typename T>
+inline void keepAlive(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/** @} */
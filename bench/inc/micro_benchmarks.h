@@ -0,0 +1,39 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   micro_benchmarks.h
+ *
+ * @brief  Header file for micro-benchmarks of the math, collision and memory primitives
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstdint>
+#include <ostream>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup BenchModules
+ * @brief    Benchmark modules for measuring the engine
+ * @{
+ */
+
+struct MicroOptions {
+  uint32_t batches{50U}; /**< Timed batches per benchmark, the percentiles are over these */
+  uint32_t seed{1U};     /**< Seed for the random inputs */
+};
+
+/**
+ * @brief   Time Vector3D and Matrix3D operations, CollisionDetector routines, MemoryManager allocation, world state rollback and
+ *          state replication
+ * @details Writes one "micro" record per benchmark, with the time per operation in nanoseconds, and a "replication" record with
+ *          the encoded packet sizes per body
+ */
+void runMicroBenchmarks(std::ostream &out, const MicroOptions &options);
+
+/** @} */
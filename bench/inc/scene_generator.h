@@ -0,0 +1,54 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   scene_generator.h
+ *
+ * @brief  Header file for the benchmark scene generators
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstdint>
+#include <string>
+
+/* Inter-component Headers */
+#include "physics_world.h"
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup BenchModules
+ * @brief    Benchmark modules for measuring the engine
+ * @{
+ */
+
+enum class SceneType {
+  GAS,    /**< Spheres flying around a box with no gravity, lots of short lived contacts and broadphase churn */
+  PILE,   /**< Spheres dropped in a block onto the ground, settling into a resting pile. Solver heavy */
+  TOWERS, /**< Columns of spheres stacked on the ground, deep stacks that stress solver convergence */
+  MIXED,  /**< Spheres of very different sizes falling together, hard for uniform grids */
+  COUNT
+};
+
+struct SceneDesc {
+  SceneType type{SceneType::PILE};
+  uint32_t bodyCount{1000U}; /**< Dynamic bodies, the static ground comes on top */
+  uint32_t seed{1U};         /**< Seed for the random placement, the same seed gives the same scene */
+};
+
+const char *getSceneName(SceneType type);
+
+/**
+ * @brief   Look a scene up by the name getSceneName() gives it
+ * @return  false if no scene has that name
+ */
+bool parseSceneType(const std::string &name, SceneType &type);
+
+/**
+ * @brief   Fill an empty world with a scene. Scenes scale from a hundred to millions of bodies with the same density
+ */
+void generateScene(PhysicsWorld &world, const SceneDesc &desc);
+
+/** @} */
@@ -0,0 +1,112 @@
+/*******************************************************************************************************************************
+ * @file   bench_report.cc
+ *
+ * @brief  Source file for benchmark statistics and machine-readable output
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "bench_report.h"
+
+namespace {
+double getPercentile(const std::vector<double> &sorted, double percentile) {
+  size_t rank = static_cast<size_t>(std::ceil(percentile * static_cast<double>(sorted.size())));
+  return sorted[std::clamp<size_t>(rank, 1U, sorted.size()) - 1U];
+}
+}  // namespace
+
+SampleSummary summarizeSamples(std::vector<double> samples) {
+  SampleSummary summary{};
+  if (samples.empty()) {
+    return summary;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+  summary.min = samples.front();
+  summary.p50 = getPercentile(samples, 0.50);
+  summary.p90 = getPercentile(samples, 0.90);
+  summary.p99 = getPercentile(samples, 0.99);
+  summary.max = samples.back();
+  return summary;
+}
+
+BenchRecord::BenchRecord(const char *kind) : text("{") {
+  add("kind", kind);
+}
+
+BenchRecord &BenchRecord::add(const char *key, const char *value) {
+  return add(key, std::string(value));
+}
+
+BenchRecord &BenchRecord::add(const char *key, const std::string &value) {
+  addKey(key);
+  text += '"';
+  for (char character : value) {
+    if (character == '"' || character == '\\') {
+      text += '\\';
+    }
+    text += character;
+  }
+  text += '"';
+  return *this;
+}
+
+BenchRecord &BenchRecord::add(const char *key, double value) {
+  addKey(key);
+
+  /* JSON has no infinities or NaNs */
+  if (!std::isfinite(value)) {
+    text += "null";
+    return *this;
+  }
+
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+  text += buffer;
+  return *this;
+}
+
+BenchRecord &BenchRecord::add(const char *key, uint64_t value) {
+  addKey(key);
+  text += std::to_string(value);
+  return *this;
+}
+
+BenchRecord &BenchRecord::add(const char *key, uint32_t value) {
+  return add(key, static_cast<uint64_t>(value));
+}
+
+BenchRecord &BenchRecord::add(const char *prefix, const SampleSummary &summary, double scale) {
+  std::string name(prefix);
+  add((name + "Mean").c_str(), summary.mean * scale);
+  add((name + "Min").c_str(), summary.min * scale);
+  add((name + "P50").c_str(), summary.p50 * scale);
+  add((name + "P90").c_str(), summary.p90 * scale);
+  add((name + "P99").c_str(), summary.p99 * scale);
+  add((name + "Max").c_str(), summary.max * scale);
+  return *this;
+}
+
+void BenchRecord::write(std::ostream &out) const {
+  out << text << "}" << std::endl;
+}
+
+void BenchRecord::addKey(const char *key) {
+  if (text.size() > 1U) {
+    text += ", ";
+  }
+  text += '"';
+  text += key;
+  text += "\": ";
+}
@@ -0,0 +1,351 @@
+/*******************************************************************************************************************************
+ * @file   main.cc
+ *
+ * @brief  Main file for the benchmark suite, runs scene and micro-benchmarks and writes JSON lines to stdout
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Inter-component Headers */
+#include "float_pack.h"
+#include "physics_world.h"
+#include "profiler.h"
+
+/* Intra-component Headers */
+#include "bench_report.h"
+#include "micro_benchmarks.h"
+#include "scene_generator.h"
+
+namespace {
+const uint32_t ALL_PAIRS_BODY_LIMIT = 4000U; /**< All pairs is O(N^2), bigger scenes are skipped */
+
+const char *const BROADPHASE_NAMES[] = {"all_pairs", "sweep_and_prune", "spatial_hash", "dynamic_tree"};
+const char *const SOLVER_NAMES[] = {"baumgarte", "split_impulse"};
+
+struct BenchOptions {
+  std::vector<SceneType> scenes{SceneType::GAS, SceneType::PILE, SceneType::TOWERS, SceneType::MIXED};
+  std::vector<uint32_t> bodyCounts{100U, 1000U, 10000U};
+  std::vector<BroadphaseType> broadphases{BroadphaseType::SWEEP_AND_PRUNE, BroadphaseType::SPATIAL_HASH, BroadphaseType::DYNAMIC_TREE};
+  std::vector<PositionCorrection> solvers{PositionCorrection::SPLIT_IMPULSE};
+  std::vector<uint32_t> threadCounts{1U};
+  uint32_t warmUpSteps{30U};
+  uint32_t steps{60U};
+  uint32_t seed{1U};
+  bool sleeping{true};
+  bool runScenes{true};
+  bool runMicro{true};
+  std::string tracePath; /**< Chrome trace of every timed step, profiling builds only */
+  bool traceJobs{false}; /**< Also trace every job, which makes the steps measurably slower */
+};
+
+void printUsage() {
+  std::fprintf(stderr,
+               "Usage: PhysicsEngineBench [options]\n"
+               "  --scenes LIST       gas, pile, towers, mixed (default all)\n"
+               "  --bodies LIST       Dynamic body counts, 100 to 1000000 (default 100,1000,10000)\n"
+               "  --broadphase LIST   sweep_and_prune, spatial_hash, dynamic_tree, all_pairs (default all but all_pairs)\n"
+               "  --solver LIST       split_impulse, baumgarte (default split_impulse)\n"
+               "  --threads LIST      Thread counts, 0 for every hardware thread (default 1)\n"
+               "  --warmup N          Untimed steps before timing (default 30)\n"
+               "  --steps N           Timed steps per run (default 60)\n"
+               "  --seed N            Seed for the scene generators (default 1)\n"
+               "  --no-sleep          Keep every body awake\n"
+               "  --scenes-only       Skip the micro-benchmarks\n"
+               "  --micro-only        Skip the scene benchmarks\n"
+               "  --trace FILE        Write a Chrome trace of the timed steps (needs make PROFILE=1)\n"
+               "  --trace-jobs        Include every job in the trace, not just the phases\n"
+               "  --help              Show this message\n"
+               "Writes one JSON object per line to stdout\n");
+}
+
+std::vector<std::string> splitList(const std::string &list) {
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+/**
+ * @brief   Parse a comma separated list of names into the enum values at the same index in names
+ */
+template <typename T, size_t N>
+bool parseNames(const std::string &list, const char *const (&names)[N], std::vector<T> &values) {
+  values.clear();
+  for (const std::string &item : splitList(list)) {
+    size_t i = 0U;
+    while (i < N && item != names[i]) {
+      i++;
+    }
+    if (i == N) {
+      return false;
+    }
+    values.push_back(static_cast<T>(i));
+  }
+  return !values.empty();
+}
+
+bool parseNumbers(const std::string &list, std::vector<uint32_t> &values) {
+  values.clear();
+  for (const std::string &item : splitList(list)) {
+    char *end = nullptr;
+    unsigned long value = std::strtoul(item.c_str(), &end, 10);
+    if (*end != '\0') {
+      return false;
+    }
+    values.push_back(static_cast<uint32_t>(value));
+  }
+  return !values.empty();
+}
+
+bool parseArguments(int argc, char **argv, BenchOptions &options) {
+  for (int i = 1; i < argc; i++) {
+    std::string argument(argv[i]);
+    std::string value = (i + 1 < argc) ? argv[i + 1] : "";
+    std::vector<uint32_t> numbers;
+    bool valid = true;
+
+    if (argument == "--scenes") {
+      options.scenes.clear();
+      for (const std::string &name : splitList(value)) {
+        SceneType type;
+        valid = valid && parseSceneType(name, type);
+        options.scenes.push_back(type);
+      }
+      valid = valid && !options.scenes.empty();
+      i++;
+    } else if (argument == "--bodies") {
+      valid = parseNumbers(value, options.bodyCounts);
+      i++;
+    } else if (argument == "--broadphase") {
+      valid = parseNames(value, BROADPHASE_NAMES, options.broadphases);
+      i++;
+    } else if (argument == "--solver") {
+      valid = parseNames(value, SOLVER_NAMES, options.solvers);
+      i++;
+    } else if (argument == "--threads") {
+      valid = parseNumbers(value, options.threadCounts);
+      i++;
+    } else if (argument == "--warmup" || argument == "--steps" || argument == "--seed") {
+      valid = parseNumbers(value, numbers) && numbers.size() == 1U;
+      uint32_t &target = (argument == "--warmup") ? options.warmUpSteps : (argument == "--steps") ? options.steps : options.seed;
+      target = valid ? numbers[0] : target;
+      i++;
+    } else if (argument == "--trace") {
+      options.tracePath = value;
+      valid = !value.empty();
+      i++;
+    } else if (argument == "--trace-jobs") {
+      options.traceJobs = true;
+    } else if (argument == "--no-sleep") {
+      options.sleeping = false;
+    } else if (argument == "--scenes-only") {
+      options.runMicro = false;
+    } else if (argument == "--micro-only") {
+      options.runScenes = false;
+    } else {
+      valid = false;
+    }
+
+    if (!valid) {
+      std::fprintf(stderr, "Bad argument: %s %s\n", argument.c_str(), value.c_str());
+      return false;
+    }
+  }
+  return options.steps > 0U;
+}
+
+const char *getSimdName() {
+#if defined(PHYSICS_SIMD_AVX)
+  return "avx";
+#elif defined(PHYSICS_SIMD_SSE)
+  return "sse";
+#else
+  return "scalar";
+#endif
+}
+
+#if defined(PHYSICS_PROFILE)
+/**
+ * @brief   Add the mean of the step statistics over the timed steps, phases in milliseconds
+ */
+void addStepStats(BenchRecord &record, const StepStats &total, uint32_t steps) {
+  const double scale = 1000.0 / steps;
+  record.add("buildActiveListMs", total.buildActiveListSeconds * scale)
+      .add("detectCollisionsMs", total.detectCollisionsSeconds * scale)
+      .add("broadphaseMs", total.broadphaseSeconds * scale)
+      .add("narrowphaseMs", total.narrowphaseSeconds * scale)
+      .add("mergeContactsMs", total.mergeContactsSeconds * scale)
+      .add("integrateVelocitiesMs", total.integrateVelocitiesSeconds * scale)
+      .add("resolveCollisionsMs", total.resolveCollisionsSeconds * scale)
+      .add("integratePositionsMs", total.integratePositionsSeconds * scale)
+      .add("updateSleepMs", total.updateSleepSeconds * scale)
+      .add("broadphasePairs", static_cast<double>(total.broadphasePairs) / steps)
+      .add("pairsTested", static_cast<double>(total.pairsTested) / steps)
+      .add("contacts", static_cast<double>(total.contacts) / steps)
+      .add("bodiesIntegrated", static_cast<double>(total.bodiesIntegrated) / steps);
+}
+#endif
+
+void accumulateStepStats(StepStats &total, const StepStats &step) {
+  total.buildActiveListSeconds += step.buildActiveListSeconds;
+  total.detectCollisionsSeconds += step.detectCollisionsSeconds;
+  total.broadphaseSeconds += step.broadphaseSeconds;
+  total.narrowphaseSeconds += step.narrowphaseSeconds;
+  total.mergeContactsSeconds += step.mergeContactsSeconds;
+  total.integrateVelocitiesSeconds += step.integrateVelocitiesSeconds;
+  total.resolveCollisionsSeconds += step.resolveCollisionsSeconds;
+  total.integratePositionsSeconds += step.integratePositionsSeconds;
+  total.updateSleepSeconds += step.updateSleepSeconds;
+  total.broadphasePairs += step.broadphasePairs;
+  total.pairsTested += step.pairsTested;
+  total.contacts += step.contacts;
+  total.bodiesIntegrated += step.bodiesIntegrated;
+}
+
+/**
+ * @brief   Build one scene in a fresh world, step it and write a "scene" record
+ */
+void runScene(const BenchOptions &options, const SceneDesc &scene, BroadphaseType broadphase, PositionCorrection solver, uint32_t threadCount) {
+  auto setupStart = std::chrono::steady_clock::now();
+  PhysicsWorld world;
+  world.setThreadCount(threadCount);
+  world.setBroadphase(broadphase);
+  world.setPositionCorrection(solver);
+  world.setSleepingEnabled(options.sleeping);
+  generateScene(world, scene);
+  std::chrono::duration<double, std::milli> setup = std::chrono::steady_clock::now() - setupStart;
+
+  for (uint32_t step = 0U; step < options.warmUpSteps; step++) {
+    world.step();
+  }
+
+  std::vector<double> stepMilliseconds;
+  stepMilliseconds.reserve(options.steps);
+  double totalMilliseconds = 0.0;
+  StepStats totalStats{};
+  Profiler::getInstance().setCapturing(!options.tracePath.empty(), options.traceJobs);
+  for (uint32_t step = 0U; step < options.steps; step++) {
+    auto start = std::chrono::steady_clock::now();
+    world.step();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    stepMilliseconds.push_back(elapsed.count());
+    totalMilliseconds += elapsed.count();
+    accumulateStepStats(totalStats, world.getStepStats());
+  }
+  Profiler::getInstance().setCapturing(false);
+
+  /* ns per body is over every dynamic body, asleep or not, so it shows the benefit of sleeping too */
+  double meanMilliseconds = totalMilliseconds / options.steps;
+  BenchRecord record("scene");
+  record
+      .add("scene", getSceneName(scene.type))
+      .add("bodies", scene.bodyCount)
+      .add("broadphase", BROADPHASE_NAMES[static_cast<uint32_t>(broadphase)])
+      .add("solver", SOLVER_NAMES[static_cast<uint32_t>(solver)])
+      .add("threads", world.getThreadCount())
+      .add("sleeping", static_cast<uint32_t>(options.sleeping))
+      .add("steps", options.steps)
+      .add("setupMs", setup.count())
+      .add("stepsPerSecond", 1000.0 / meanMilliseconds)
+      .add("nsPerBody", meanMilliseconds * 1.0e6 / scene.bodyCount)
+      .add("stepMs", summarizeSamples(stepMilliseconds))
+      .add("awakeBodies", static_cast<uint64_t>(world.getAwakeBodyCount()));
+
+#if defined(PHYSICS_PROFILE)
+  addStepStats(record, totalStats, options.steps);
+#endif
+  record.write(std::cout);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  if (argc > 1 && std::string(argv[1]) == "--help") {
+    printUsage();
+    return EXIT_SUCCESS;
+  }
+
+  BenchOptions options;
+  if (!parseArguments(argc, argv, options)) {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+
+  /* What the numbers were measured with, so results from different builds and machines can be told apart */
+  BenchRecord("config")
+      .add("simd", getSimdName())
+      .add("packWidth", static_cast<uint64_t>(NATIVE_PACK_WIDTH))
+      .add("hardwareThreads", std::thread::hardware_concurrency())
+      .add("warmUpSteps", options.warmUpSteps)
+      .add("seed", options.seed)
+#if defined(PHYSICS_PROFILE)
+      .add("profile", 1U)
+#else
+      .add("profile", 0U)
+#endif
+      .write(std::cout);
+
+#if !defined(PHYSICS_PROFILE)
+  if (!options.tracePath.empty()) {
+    std::fprintf(stderr, "--trace needs a profiling build, rebuild with make PROFILE=1\n");
+    return EXIT_FAILURE;
+  }
+#endif
+
+  if (options.runMicro) {
+    MicroOptions micro;
+    micro.seed = options.seed;
+    runMicroBenchmarks(std::cout, micro);
+  }
+
+  if (options.runScenes) {
+    for (SceneType type : options.scenes) {
+      for (uint32_t bodyCount : options.bodyCounts) {
+        SceneDesc scene;
+        scene.type = type;
+        scene.bodyCount = bodyCount;
+        scene.seed = options.seed;
+
+        for (BroadphaseType broadphase : options.broadphases) {
+          if (broadphase == BroadphaseType::ALL_PAIRS && bodyCount > ALL_PAIRS_BODY_LIMIT) {
+            BenchRecord("skip").add("scene", getSceneName(type)).add("bodies", bodyCount).add("broadphase", BROADPHASE_NAMES[0]).add("reason", "all_pairs is O(N^2)").write(std::cout);
+            continue;
+          }
+
+          for (PositionCorrection solver : options.solvers) {
+            for (uint32_t threadCount : options.threadCounts) {
+              runScene(options, scene, broadphase, solver, threadCount);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  if (!options.tracePath.empty()) {
+    std::ofstream trace(options.tracePath);
+    Profiler::getInstance().writeChromeTrace(trace);
+    if (!trace) {
+      std::fprintf(stderr, "Could not write %s\n", options.tracePath.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
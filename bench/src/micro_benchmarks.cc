@@ -0,0 +1,391 @@
+/*******************************************************************************************************************************
+ * @file   micro_benchmarks.cc
+ *
+ * @brief  Source file for micro-benchmarks of the math, collision and memory primitives
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+/* Inter-component Headers */
+#include "body_store.h"
+#include "collision.h"
+#include "frame_arena.h"
+#include "matrix_3d.h"
+#include "memory_manager.h"
+#include "physics_world.h"
+#include "sphere.h"
+#include "state_replication.h"
+#include "vector_3d.h"
+
+/* Intra-component Headers */
+#include "bench_report.h"
+#include "micro_benchmarks.h"
+#include "scene_generator.h"
+
+namespace {
+const uint32_t VECTOR_COUNT = 4096U;
+const uint32_t MATRIX_COUNT = 1024U;
+const uint32_t SPHERE_PAIR_COUNT = 2048U;
+const uint32_t SMALL_ALLOCATION_COUNT = 256U;
+const size_t SMALL_ALLOCATION_MAX = 4096U;
+const uint32_t MEDIUM_ALLOCATION_COUNT = 64U; /**< Between SMALL_ALLOCATION_MAX and a slab, like AlignedArray growth */
+const uint32_t LARGE_ALLOCATION_COUNT = 16U;
+const uint32_t ROLLBACK_BODY_COUNT = 10000U;
+const uint32_t ROLLBACK_SETTLE_STEPS = 60U;
+const uint32_t ROLLBACK_SLOT_COUNT = 16U;
+const uint32_t REPLICATION_BODY_COUNT = 10000U;
+const uint32_t REPLICATION_SETTLE_STEPS = 60U;
+const uint32_t REPLICATION_TICK_COUNT = 16U;
+const uint32_t REPLICATION_LATENCY = 4U; /**< Ticks between the baseline and the encoded tick for the lagging observer */
+
+/**
+ * @brief   Time a batch of work repeatedly and write the time per operation
+ * @param   opsPerBatch Operations one call of batch performs
+ */
+template <typename Batch>
+void measure(std::ostream &out, const MicroOptions &options, const char *group, const char *name, uint32_t opsPerBatch, Batch &&batch) {
+  /* One untimed batch to warm the caches and the memory manager's pools */
+  batch();
+
+  std::vector<double> samples;
+  samples.reserve(options.batches);
+  for (uint32_t i = 0U; i < options.batches; i++) {
+    auto start = std::chrono::steady_clock::now();
+    batch();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    samples.push_back(elapsed.count() / opsPerBatch);
+  }
+
+  BenchRecord("micro").add("group", group).add("name", name).add("opsPerBatch", opsPerBatch).add("batches", options.batches).add("ns", summarizeSamples(samples)).write(out);
+}
+
+void runVectorBenchmarks(std::ostream &out, const MicroOptions &options, std::mt19937 &random) {
+  std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+  std::vector<Vector3D> a(VECTOR_COUNT);
+  std::vector<Vector3D> b(VECTOR_COUNT);
+  std::vector<Vector3D> result(VECTOR_COUNT);
+  for (uint32_t i = 0U; i < VECTOR_COUNT; i++) {
+    a[i] = Vector3D(value(random), value(random), value(random));
+    b[i] = Vector3D(value(random), value(random), value(random));
+  }
+
+  measure(out, options, "vector3d", "add", VECTOR_COUNT, [&]() {
+    for (uint32_t i = 0U; i < VECTOR_COUNT; i++) {
+      result[i] = a[i] + b[i];
+    }
+    keepAlive(result.data());
+  });
+
+  measure(out, options, "vector3d", "dot_product", VECTOR_COUNT, [&]() {
+    float sum = 0.0f;
+    for (uint32_t i = 0U; i < VECTOR_COUNT; i++) {
+      sum += a[i].dotProduct(b[i]);
+    }
+    keepAlive(sum);
+  });
+
+  measure(out, options, "vector3d", "cross_product", VECTOR_COUNT, [&]() {
+    for (uint32_t i = 0U; i < VECTOR_COUNT; i++) {
+      result[i] = a[i].crossProduct(b[i]);
+    }
+    keepAlive(result.data());
+  });
+
+  measure(out, options, "vector3d", "normalize", VECTOR_COUNT, [&]() {
+    for (uint32_t i = 0U; i < VECTOR_COUNT; i++) {
+      result[i] = a[i].normalize();
+    }
+    keepAlive(result.data());
+  });
+}
+
+void runMatrixBenchmarks(std::ostream &out, const MicroOptions &options, std::mt19937 &random) {
+  std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+  std::vector<Matrix3D> a(MATRIX_COUNT);
+  std::vector<Matrix3D> b(MATRIX_COUNT);
+  std::vector<Matrix3D> result(MATRIX_COUNT);
+  std::vector<Vector3D> vectors(MATRIX_COUNT);
+  std::vector<Vector3D> transformed(MATRIX_COUNT);
+  for (uint32_t i = 0U; i < MATRIX_COUNT; i++) {
+    /* Diagonally dominant, so every matrix is comfortably invertible */
+    a[i] = Matrix3D(3.0f + value(random), value(random), value(random), value(random), 3.0f + value(random), value(random), value(random), value(random),
+                    3.0f + value(random));
+    b[i] = Matrix3D(3.0f + value(random), value(random), value(random), value(random), 3.0f + value(random), value(random), value(random), value(random),
+                    3.0f + value(random));
+    vectors[i] = Vector3D(value(random), value(random), value(random));
+  }
+
+  measure(out, options, "matrix3d", "multiply", MATRIX_COUNT, [&]() {
+    for (uint32_t i = 0U; i < MATRIX_COUNT; i++) {
+      result[i] = a[i] * b[i];
+    }
+    keepAlive(result.data());
+  });
+
+  measure(out, options, "matrix3d", "multiply_vector", MATRIX_COUNT, [&]() {
+    for (uint32_t i = 0U; i < MATRIX_COUNT; i++) {
+      transformed[i] = a[i] * vectors[i];
+    }
+    keepAlive(transformed.data());
+  });
+
+  measure(out, options, "matrix3d", "transpose", MATRIX_COUNT, [&]() {
+    for (uint32_t i = 0U; i < MATRIX_COUNT; i++) {
+      result[i] = a[i].transpose();
+    }
+    keepAlive(result.data());
+  });
+
+  measure(out, options, "matrix3d", "inverse", MATRIX_COUNT, [&]() {
+    for (uint32_t i = 0U; i < MATRIX_COUNT; i++) {
+      result[i] = a[i].inverse();
+    }
+    keepAlive(result.data());
+  });
+}
+
+void runCollisionBenchmarks(std::ostream &out, const MicroOptions &options, std::mt19937 &random) {
+  /* Pairs of spheres at random separations, about half of them overlapping, and the same spheres straddling the plane y = 0 */
+  std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+  std::uniform_real_distribution<float> separation(0.5f, 1.5f);
+  std::uniform_real_distribution<float> height(-0.5f, 1.5f);
+  std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+
+  BodyStore store;
+  store.reserve(2U * SPHERE_PAIR_COUNT);
+  std::shared_ptr<Sphere> ball = std::make_shared<Sphere>(0.5f);
+  std::vector<BroadphasePair> pairs(SPHERE_PAIR_COUNT);
+  std::vector<uint32_t> spheres(2U * SPHERE_PAIR_COUNT);
+  for (uint32_t i = 0U; i < SPHERE_PAIR_COUNT; i++) {
+    Vector3D first(position(random), height(random), position(random));
+    Vector3D offset = Vector3D(direction(random), direction(random), direction(random)).normalize() * separation(random);
+
+    BodyDesc desc;
+    desc.shape = ball;
+    desc.position = first;
+    store.add(desc, nullptr);
+    desc.position = first + offset;
+    store.add(desc, nullptr);
+
+    pairs[i] = BroadphasePair{2U * i, 2U * i + 1U};
+    spheres[2U * i] = 2U * i;
+    spheres[2U * i + 1U] = 2U * i + 1U;
+  }
+
+  const Vector3D planeNormal(0.0f, 1.0f, 0.0f);
+  FrameArena arena;
+  FrameVector<Contact> contacts;
+
+  measure(out, options, "collision", "sphere_sphere", SPHERE_PAIR_COUNT, [&]() {
+    uint32_t hits = 0U;
+    Contact contact;
+    for (const BroadphasePair &pair : pairs) {
+      hits += CollisionDetector::sphereSphere(store, pair.a, pair.b, &contact) ? 1U : 0U;
+    }
+    keepAlive(hits);
+  });
+
+  measure(out, options, "collision", "sphere_sphere_batch", SPHERE_PAIR_COUNT, [&]() {
+    arena.reset();
+    rebindFrameVector(contacts, arena, SPHERE_PAIR_COUNT);
+    keepAlive(CollisionDetector::sphereSphereBatch(store, pairs.data(), SPHERE_PAIR_COUNT, contacts));
+  });
+
+  measure(out, options, "collision", "sphere_plane", 2U * SPHERE_PAIR_COUNT, [&]() {
+    uint32_t hits = 0U;
+    Contact contact;
+    for (uint32_t sphere : spheres) {
+      hits += CollisionDetector::spherePlane(store, sphere, planeNormal, 0.0f, &contact) ? 1U : 0U;
+    }
+    keepAlive(hits);
+  });
+
+  measure(out, options, "collision", "sphere_plane_batch", 2U * SPHERE_PAIR_COUNT, [&]() {
+    arena.reset();
+    rebindFrameVector(contacts, arena, 2U * SPHERE_PAIR_COUNT);
+    keepAlive(CollisionDetector::spherePlaneBatch(store, spheres.data(), 2U * SPHERE_PAIR_COUNT, planeNormal, 0.0f, contacts));
+  });
+}
+
+void runMemoryBenchmarks(std::ostream &out, const MicroOptions &options, std::mt19937 &random) {
+  /* The same mix of sizes for the manager and the C heap, allocated in a burst and freed in reverse, like a step's scratch */
+  std::uniform_int_distribution<size_t> smallSize(1U, SMALL_ALLOCATION_MAX);
+  std::uniform_int_distribution<size_t> mediumSize(SMALL_ALLOCATION_MAX + 1U, MemoryManager::SLAB_SIZE);
+  std::uniform_int_distribution<size_t> largeSize(MemoryManager::SLAB_SIZE, 16U * MemoryManager::SLAB_SIZE);
+  std::vector<size_t> smallSizes(SMALL_ALLOCATION_COUNT);
+  std::vector<size_t> mediumSizes(MEDIUM_ALLOCATION_COUNT);
+  std::vector<size_t> largeSizes(LARGE_ALLOCATION_COUNT);
+  for (size_t &size : smallSizes) {
+    size = smallSize(random);
+  }
+  for (size_t &size : mediumSizes) {
+    size = mediumSize(random);
+  }
+  for (size_t &size : largeSizes) {
+    size = largeSize(random);
+  }
+  std::vector<void *> blocks(SMALL_ALLOCATION_COUNT);
+  MemoryManager &memory = MemoryManager::getInstance();
+
+  measure(out, options, "memory", "memory_manager_small", 2U * SMALL_ALLOCATION_COUNT, [&]() {
+    for (uint32_t i = 0U; i < SMALL_ALLOCATION_COUNT; i++) {
+      blocks[i] = memory.allocate(smallSizes[i]);
+    }
+    keepAlive(blocks.data());
+    for (uint32_t i = SMALL_ALLOCATION_COUNT; i-- > 0U;) {
+      memory.deallocate(blocks[i]);
+    }
+  });
+
+  measure(out, options, "memory", "malloc_small", 2U * SMALL_ALLOCATION_COUNT, [&]() {
+    for (uint32_t i = 0U; i < SMALL_ALLOCATION_COUNT; i++) {
+      blocks[i] = std::malloc(smallSizes[i]);
+    }
+    keepAlive(blocks.data());
+    for (uint32_t i = SMALL_ALLOCATION_COUNT; i-- > 0U;) {
+      std::free(blocks[i]);
+    }
+  });
+
+  measure(out, options, "memory", "memory_manager_medium", 2U * MEDIUM_ALLOCATION_COUNT, [&]() {
+    for (uint32_t i = 0U; i < MEDIUM_ALLOCATION_COUNT; i++) {
+      blocks[i] = memory.allocate(mediumSizes[i]);
+    }
+    keepAlive(blocks.data());
+    for (uint32_t i = MEDIUM_ALLOCATION_COUNT; i-- > 0U;) {
+      memory.deallocate(blocks[i]);
+    }
+  });
+
+  measure(out, options, "memory", "malloc_medium", 2U * MEDIUM_ALLOCATION_COUNT, [&]() {
+    for (uint32_t i = 0U; i < MEDIUM_ALLOCATION_COUNT; i++) {
+      blocks[i] = std::malloc(mediumSizes[i]);
+    }
+    keepAlive(blocks.data());
+    for (uint32_t i = MEDIUM_ALLOCATION_COUNT; i-- > 0U;) {
+      std::free(blocks[i]);
+    }
+  });
+
+  measure(out, options, "memory", "memory_manager_large", 2U * LARGE_ALLOCATION_COUNT, [&]() {
+    for (uint32_t i = 0U; i < LARGE_ALLOCATION_COUNT; i++) {
+      blocks[i] = memory.allocate(largeSizes[i]);
+    }
+    keepAlive(blocks.data());
+    for (uint32_t i = LARGE_ALLOCATION_COUNT; i-- > 0U;) {
+      memory.deallocate(blocks[i]);
+    }
+  });
+
+  measure(out, options, "memory", "malloc_large", 2U * LARGE_ALLOCATION_COUNT, [&]() {
+    for (uint32_t i = 0U; i < LARGE_ALLOCATION_COUNT; i++) {
+      blocks[i] = std::malloc(largeSizes[i]);
+    }
+    keepAlive(blocks.data());
+    for (uint32_t i = LARGE_ALLOCATION_COUNT; i-- > 0U;) {
+      std::free(blocks[i]);
+    }
+  });
+}
+
+void runRollbackBenchmarks(std::ostream &out, const MicroOptions &options) {
+  /* A pile partway through settling, so the warm start cache is full and some islands are asleep */
+  PhysicsWorld world;
+  world.setBroadphase(BroadphaseType::SPATIAL_HASH);
+  generateScene(world, SceneDesc{SceneType::PILE, ROLLBACK_BODY_COUNT, options.seed});
+  for (uint32_t step = 0U; step < ROLLBACK_SETTLE_STEPS; step++) {
+    world.step();
+  }
+  world.setStateSlotCount(ROLLBACK_SLOT_COUNT);
+
+  /* One operation is a save or restore of the whole world */
+  measure(out, options, "rollback", "save_state_10k", ROLLBACK_SLOT_COUNT, [&]() {
+    for (uint32_t slot = 0U; slot < ROLLBACK_SLOT_COUNT; slot++) {
+      world.saveState(slot);
+    }
+  });
+
+  measure(out, options, "rollback", "restore_state_10k", ROLLBACK_SLOT_COUNT, [&]() {
+    for (uint32_t slot = 0U; slot < ROLLBACK_SLOT_COUNT; slot++) {
+      world.restoreState(slot);
+    }
+    keepAlive(world.getBodyStore().position.x.data());
+  });
+}
+
+void runReplicationBenchmarks(std::ostream &out, const MicroOptions &options) {
+  /* The same settling pile, captured for a run of ticks. Every tick is encoded against the one before, as for an observer one
+     tick behind, except the first, which goes out whole as for a new one */
+  PhysicsWorld world;
+  world.setBroadphase(BroadphaseType::SPATIAL_HASH);
+  generateScene(world, SceneDesc{SceneType::PILE, REPLICATION_BODY_COUNT, options.seed});
+  for (uint32_t step = 0U; step < REPLICATION_SETTLE_STEPS; step++) {
+    world.step();
+  }
+
+  ReplicationEncoder encoder;
+  std::vector<std::vector<uint8_t>> packets(REPLICATION_TICK_COUNT);
+  for (uint32_t tick = 0U; tick < REPLICATION_TICK_COUNT; tick++) {
+    world.step();
+    uint32_t sequence = encoder.capture(world);
+    packets[tick].resize(encoder.getMaxPacketSize());
+    packets[tick].resize(encoder.encode((tick == 0U) ? REPLICATION_NO_BASELINE : sequence - 1U, packets[tick]));
+  }
+
+  /* One operation is one body of one tick, so the results are per body */
+  const uint32_t bodies = static_cast<uint32_t>(world.getBodyCount());
+  const uint32_t latest = encoder.getLatestSequence();
+  std::vector<uint8_t> packet(encoder.getMaxPacketSize());
+  size_t fullSize = encoder.encode(REPLICATION_NO_BASELINE, packet);
+  size_t deltaSize = encoder.encode(latest - 1U, packet);
+  size_t laggingSize = encoder.encode(latest - REPLICATION_LATENCY, packet);
+
+  measure(out, options, "replication", "encode_full_10k", bodies, [&]() {
+    keepAlive(encoder.encode(REPLICATION_NO_BASELINE, packet));
+  });
+
+  measure(out, options, "replication", "encode_delta_10k", bodies, [&]() {
+    keepAlive(encoder.encode(latest - 1U, packet));
+  });
+
+  ReplicationDecoder decoder;
+  measure(out, options, "replication", "decode_10k", bodies * REPLICATION_TICK_COUNT, [&]() {
+    decoder.reset();
+    for (const std::vector<uint8_t> &tickPacket : packets) {
+      keepAlive(decoder.decode(tickPacket));
+    }
+  });
+
+  /* Last, since it captures the same world over and over and leaves nothing to encode */
+  measure(out, options, "replication", "capture_10k", bodies, [&]() {
+    keepAlive(encoder.capture(world));
+  });
+
+  BenchRecord("replication")
+      .add("bodies", bodies)
+      .add("fullBytesPerBody", static_cast<double>(fullSize) / bodies)
+      .add("deltaBytesPerBody", static_cast<double>(deltaSize) / bodies)
+      .add("laggingBytesPerBody", static_cast<double>(laggingSize) / bodies)
+      .add("laggingTicks", REPLICATION_LATENCY)
+      .add("awakeBodies", static_cast<uint64_t>(world.getAwakeBodyCount()))
+      .write(out);
+}
+}  // namespace
+
+void runMicroBenchmarks(std::ostream &out, const MicroOptions &options) {
+  std::mt19937 random(options.seed);
+  runVectorBenchmarks(out, options, random);
+  runMatrixBenchmarks(out, options, random);
+  runCollisionBenchmarks(out, options, random);
+  runMemoryBenchmarks(out, options, random);
+  runRollbackBenchmarks(out, options);
+  runReplicationBenchmarks(out, options);
+}
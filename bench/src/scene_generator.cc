@@ -0,0 +1,170 @@
+/*******************************************************************************************************************************
+ * @file   scene_generator.cc
+ *
+ * @brief  Source file for the benchmark scene generators
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+/* Inter-component Headers */
+#include "sphere.h"
+
+/* Intra-component Headers */
+#include "scene_generator.h"
+
+namespace {
+const char *const SCENE_NAMES[] = {"gas", "pile", "towers", "mixed"};
+
+const float BALL_RADIUS = 0.5f;
+const float GAS_VOLUME_FRACTION = 0.05f; /**< Share of the gas box filled by spheres */
+const float GAS_SPEED = 5.0f;
+const float PILE_SPACING = 1.02f;
+const uint32_t TOWER_HEIGHT = 10U;
+const float TOWER_SPACING = 2.5f;
+const float MIXED_MIN_RADIUS = 0.1f;
+const float MIXED_MAX_RADIUS = 2.0f;
+
+/* Square footprint side, in bodies, for a block of roughly cube proportions twice as wide as it is tall */
+uint32_t getFootprint(uint32_t bodyCount) {
+  return std::max(1U, static_cast<uint32_t>(std::ceil(std::cbrt(4.0 * bodyCount))));
+}
+
+/**
+ * @brief   Static ground sphere whose top sits at y = 0, flat enough across the scene to act as a floor
+ */
+void addGround(PhysicsWorld &world, float sceneWidth) {
+  float radius = std::max(1000.0f, sceneWidth * 50.0f);
+
+  BodyDesc ground;
+  ground.shape = std::make_shared<Sphere>(radius, 0.0f);
+  ground.position = Vector3D(0.0f, -radius, 0.0f);
+  world.createBody(ground);
+}
+
+std::shared_ptr<Sphere> makeBall(float radius, float restitution) {
+  std::shared_ptr<Sphere> ball = std::make_shared<Sphere>(radius);
+  ball->restitution = restitution;
+  ball->friction = 0.5f;
+  return ball;
+}
+
+void generateGas(std::vector<BodyDesc> &descs, std::mt19937 &random) {
+  float ballVolume = (4.0f / 3.0f) * 3.14159265f * BALL_RADIUS * BALL_RADIUS * BALL_RADIUS;
+  float side = std::cbrt(static_cast<float>(descs.size()) * ballVolume / GAS_VOLUME_FRACTION);
+  std::uniform_real_distribution<float> position(-0.5f * side, 0.5f * side);
+  std::uniform_real_distribution<float> velocity(-GAS_SPEED, GAS_SPEED);
+
+  std::shared_ptr<Sphere> ball = makeBall(BALL_RADIUS, 0.9f);
+  for (BodyDesc &desc : descs) {
+    desc.shape = ball;
+    desc.position = Vector3D(position(random), position(random), position(random));
+    desc.linearVelocity = Vector3D(velocity(random), velocity(random), velocity(random));
+  }
+}
+
+void generatePile(std::vector<BodyDesc> &descs, std::mt19937 &random) {
+  uint32_t footprint = getFootprint(static_cast<uint32_t>(descs.size()));
+  float offset = 0.5f * PILE_SPACING * static_cast<float>(footprint - 1U);
+  std::uniform_real_distribution<float> jitter(-0.01f, 0.01f);
+
+  std::shared_ptr<Sphere> ball = makeBall(BALL_RADIUS, 0.0f);
+  for (uint32_t i = 0U; i < descs.size(); i++) {
+    uint32_t column = i % footprint;
+    uint32_t row = (i / footprint) % footprint;
+    uint32_t layer = i / (footprint * footprint);
+
+    descs[i].shape = ball;
+    descs[i].position = Vector3D(column * PILE_SPACING - offset + jitter(random), BALL_RADIUS + 0.01f + layer * PILE_SPACING, row * PILE_SPACING - offset + jitter(random));
+  }
+}
+
+void generateTowers(std::vector<BodyDesc> &descs) {
+  uint32_t towerCount = (static_cast<uint32_t>(descs.size()) + TOWER_HEIGHT - 1U) / TOWER_HEIGHT;
+  uint32_t footprint = std::max(1U, static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(towerCount)))));
+  float offset = 0.5f * TOWER_SPACING * static_cast<float>(footprint - 1U);
+
+  std::shared_ptr<Sphere> ball = makeBall(BALL_RADIUS, 0.0f);
+  for (uint32_t i = 0U; i < descs.size(); i++) {
+    uint32_t tower = i / TOWER_HEIGHT;
+    uint32_t level = i % TOWER_HEIGHT;
+
+    descs[i].shape = ball;
+    descs[i].position = Vector3D((tower % footprint) * TOWER_SPACING - offset, BALL_RADIUS + level * 2.0f * BALL_RADIUS, (tower / footprint) * TOWER_SPACING - offset);
+  }
+}
+
+void generateMixed(std::vector<BodyDesc> &descs, std::mt19937 &random) {
+  /* Radii spread evenly on a log scale, so small and large bodies are equally common */
+  std::uniform_real_distribution<float> logRadius(std::log(MIXED_MIN_RADIUS), std::log(MIXED_MAX_RADIUS));
+  std::uniform_real_distribution<float> jitter(-0.1f, 0.1f);
+
+  uint32_t footprint = getFootprint(static_cast<uint32_t>(descs.size()));
+  float spacing = 2.0f * MIXED_MAX_RADIUS + 0.2f;
+  float offset = 0.5f * spacing * static_cast<float>(footprint - 1U);
+
+  for (uint32_t i = 0U; i < descs.size(); i++) {
+    uint32_t column = i % footprint;
+    uint32_t row = (i / footprint) % footprint;
+    uint32_t layer = i / (footprint * footprint);
+
+    descs[i].shape = makeBall(std::exp(logRadius(random)), 0.2f);
+    descs[i].position = Vector3D(column * spacing - offset + jitter(random), MIXED_MAX_RADIUS + layer * spacing, row * spacing - offset + jitter(random));
+  }
+}
+}  // namespace
+
+const char *getSceneName(SceneType type) {
+  return SCENE_NAMES[static_cast<uint32_t>(type)];
+}
+
+bool parseSceneType(const std::string &name, SceneType &type) {
+  for (uint32_t i = 0U; i < static_cast<uint32_t>(SceneType::COUNT); i++) {
+    if (name == SCENE_NAMES[i]) {
+      type = static_cast<SceneType>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+void generateScene(PhysicsWorld &world, const SceneDesc &desc) {
+  std::mt19937 random(desc.seed);
+  std::vector<BodyDesc> descs(desc.bodyCount);
+
+  switch (desc.type) {
+    case SceneType::GAS:
+      world.setGravity(Vector3D(0.0f, 0.0f, 0.0f));
+      generateGas(descs, random);
+      break;
+    case SceneType::PILE:
+      generatePile(descs, random);
+      break;
+    case SceneType::TOWERS:
+      generateTowers(descs);
+      break;
+    case SceneType::MIXED:
+      generateMixed(descs, random);
+      break;
+    default:
+      return;
+  }
+
+  if (desc.type != SceneType::GAS) {
+    float width = 0.0f;
+    for (const BodyDesc &body : descs) {
+      width = std::max(width, 2.0f * std::max(std::fabs(body.position.x), std::fabs(body.position.z)));
+    }
+    addGround(world, width);
+  }
+
+  std::vector<BodyId> ids(descs.size());
+  world.createBodies(descs, ids);
+}
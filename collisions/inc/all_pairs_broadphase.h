@@ -0,0 +1,53 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   all_pairs_broadphase.h
+ *
+ * @brief  Header file for the all-pairs broadphase
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstdint>
+#include <vector>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "broadphase.h"
+
+/**
+ * @defgroup CollisionModules
+ * @brief    Collision modules for handling interactions
+ * @{
+ */
+
+/**
+ * @brief   Tests the bounds of every proxy against every other proxy, O(N^2)
+ * @details Kept as the reference path to measure the other broadphases against
+ */
+class AllPairsBroadphase : public Broadphase {
+ public:
+  uint32_t createProxy(const AABB &box, uint32_t userData) override;
+  void destroyProxy(uint32_t proxyId) override;
+  void moveProxy(uint32_t proxyId, const AABB &box) override;
+  void setUserData(uint32_t proxyId, uint32_t userData) override;
+  void updatePairs() override;
+  const std::vector<BroadphasePair> &getPairs() const override;
+  void query(const AABB &box, std::vector<uint32_t> &results) const override;
+
+ private:
+  struct Proxy {
+    AABB box;          /**< Latest bounds */
+    uint32_t userData; /**< User data reported in pairs */
+    bool alive;        /**< False once destroyed */
+  };
+
+  std::vector<Proxy> proxies;
+  std::vector<uint32_t> freeProxies;
+  std::vector<BroadphasePair> pairs;
+};
+
+/** @} */
@@ -0,0 +1,155 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   broadphase.h
+ *
+ * @brief  Header file for the broadphase interface
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/* Inter-component Headers */
+#include "job_system.h"
+#include "vector_3d.h"
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup CollisionModules
+ * @brief    Collision modules for handling interactions
+ * @{
+ */
+
+struct AABB {
+  Vector3D min; /**< Minimum corner of the box */
+  Vector3D max; /**< Maximum corner of the box */
+
+  bool overlaps(const AABB &other) const {
+    return (min.x <= other.max.x && max.x >= other.min.x) && (min.y <= other.max.y && max.y >= other.min.y) && (min.z <= other.max.z && max.z >= other.min.z);
+  }
+
+  bool contains(const AABB &other) const {
+    return (min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z) && (max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z);
+  }
+
+  AABB merge(const AABB &other) const {
+    return AABB{Vector3D(std::min(min.x, other.min.x), std::min(min.y, other.min.y), std::min(min.z, other.min.z)),
+                Vector3D(std::max(max.x, other.max.x), std::max(max.y, other.max.y), std::max(max.z, other.max.z))};
+  }
+
+  float surfaceArea() const {
+    Vector3D extent = max - min;
+    return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+  }
+};
+
+enum class BroadphaseType {
+  ALL_PAIRS,       /**< Test every pair of bounds, O(N^2). Reference path */
+  SWEEP_AND_PRUNE, /**< Incremental sweep and prune, good general default */
+  SPATIAL_HASH,    /**< Hashed uniform grid, best for dense scenes of similarly sized bodies */
+  DYNAMIC_TREE     /**< Dynamic AABB tree, best when body sizes vary a lot */
+};
+
+struct BroadphasePair {
+  uint32_t a; /**< User data of the first proxy (always the smaller of the two) */
+  uint32_t b; /**< User data of the second proxy */
+};
+
+/**
+ * @brief   Interface for broadphase pair generation
+ * @details Proxies are owned by the broadphase and identified by the returned proxy ID. Every proxy carries a user data value
+ *          (The body index for PhysicsWorld) which is what gets reported in the overlapping pairs
+ */
+class Broadphase {
+ public:
+  static constexpr uint32_t NULL_PROXY = 0xFFFFFFFFU;
+
+  virtual ~Broadphase() = default;
+
+  /**
+   * @brief   Create an empty broadphase of the requested type
+   */
+  static std::unique_ptr<Broadphase> create(BroadphaseType type);
+
+  virtual uint32_t createProxy(const AABB &box, uint32_t userData) = 0;
+  virtual void destroyProxy(uint32_t proxyId) = 0;
+  virtual void moveProxy(uint32_t proxyId, const AABB &box) = 0;
+  virtual void setUserData(uint32_t proxyId, uint32_t userData) = 0;
+
+  /**
+   * @brief   Bring the pair list up to date with the latest proxy bounds
+   */
+  virtual void updatePairs() = 0;
+
+  /**
+   * @brief   Get all pairs with overlapping bounds, as of the last updatePairs() call
+   */
+  virtual const std::vector<BroadphasePair> &getPairs() const = 0;
+
+  /**
+   * @brief   Append the user data of every proxy whose bounds overlap the box
+   */
+  virtual void query(const AABB &box, std::vector<uint32_t> &results) const = 0;
+
+  /**
+   * @brief   Let pair generation run across the job system's threads. nullptr goes back to running serially
+   */
+  void setJobSystem(JobSystem *jobs);
+
+ protected:
+  static constexpr uint32_t PAIR_GRAIN_SIZE = 64U; /**< Items per chunk when pair generation runs in parallel */
+
+  JobSystem *jobs{nullptr};
+
+  /**
+   * @brief   Run function(begin, end, chunk) over [0, count) and append every chunk's pairs to output in chunk order
+   * @details Chunks write to their own buffer, so the output order is the same as the serial loop's on any thread count. The
+   *          buffers come from the job system's per-thread arenas and are only valid until output has been filled
+   */
+  template <typename Function>
+  void collectPairs(uint32_t count, std::vector<BroadphasePair> &output, Function &&function) {
+    if (!jobs || jobs->getThreadCount() == 1U || count <= PAIR_GRAIN_SIZE) {
+      if (chunkPairs.empty()) {
+        chunkPairs.resize(1U);
+      }
+
+      /* Without a job system there are no arenas, the broadphase's own is rewound on every call instead */
+      FrameArena &arena = jobs ? jobs->getFrameArena() : serialArena;
+      if (!jobs) {
+        serialArena.reset();
+      }
+      rebindFrameVector(chunkPairs[0], arena, output.capacity());
+      function(0U, count, chunkPairs[0]);
+      output.insert(output.end(), chunkPairs[0].begin(), chunkPairs[0].end());
+      return;
+    }
+
+    uint32_t chunkCount = (count + PAIR_GRAIN_SIZE - 1U) / PAIR_GRAIN_SIZE;
+    if (chunkPairs.size() < chunkCount) {
+      chunkPairs.resize(chunkCount);
+    }
+
+    jobs->parallelFor(count, PAIR_GRAIN_SIZE, [this, &function](uint32_t begin, uint32_t end) {
+      FrameVector<BroadphasePair> &chunk = chunkPairs[begin / PAIR_GRAIN_SIZE];
+      rebindFrameVector(chunk, jobs->getFrameArena(), PAIR_GRAIN_SIZE);
+      function(begin, end, chunk);
+    });
+
+    for (uint32_t chunk = 0U; chunk < chunkCount; chunk++) {
+      output.insert(output.end(), chunkPairs[chunk].begin(), chunkPairs[chunk].end());
+    }
+  }
+
+ private:
+  std::vector<FrameVector<BroadphasePair>> chunkPairs; /**< Per chunk scratch buffers, in the arena of the thread that ran the chunk */
+  FrameArena serialArena;
+};
+
+/** @} */
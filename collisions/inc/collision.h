@@ -10,15 +10,18 @@
  *******************************************************************************************************************************/
 
 /* Standard library Headers */
-#include <memory>
+#include <cstdint>
+#include <vector>
 
 /* Inter-component Headers */
+#include "body_store.h"
+#include "frame_arena.h"
 #include "matrix_3d.h"
-#include "rigid_body.h"
 #include "shape.h"
 #include "vector_3d.h"
 
 /* Intra-component Headers */
+#include "broadphase.h"
 
 /**
  * @defgroup CollisionModules
@@ -30,16 +33,64 @@ struct Contact {
   Vector3D point;    /**< World space contact point */
   Vector3D normal;   /**< Contact normal vector */
   float penetration; /**< Penetration depth */
-  RigidBody *bodyA;  /**< Collision object A */
-  RigidBody *bodyB;  /**< Collision object B */
+  uint32_t bodyA;    /**< Store index of collision object A */
+  uint32_t bodyB;    /**< Store index of collision object B, or BodyStore::INVALID_INDEX for static geometry */
   float restitution; /**< Combined restitution */
   float friction;    /**< Combined friction */
+
+  /**
+   * @brief   Key ordering contacts by body pair
+   */
+  uint64_t getPairKey() const {
+    return (static_cast<uint64_t>(bodyA) << 32U) | bodyB;
+  }
 };
 
 class CollisionDetector {
  public:
-  static bool sphereSphere(const RigidBody *a, const RigidBody *b, Contact *contact);
-  static bool spherePlane(const RigidBody *sphere, const Vector3D &planeNormal, float planeDistance, Contact *contact);
+  /**
+   * @brief   Batched narrowphase for pairs of bodies with one particular combination of shape types
+   */
+  using PairFunction = uint32_t (*)(const BodyStore &bodies, const BroadphasePair *pairs, uint32_t count, FrameVector<Contact> &contacts);
+
+  static constexpr uint32_t SHAPE_TYPE_COUNT = static_cast<uint32_t>(ShapeType::COUNT);
+  static constexpr uint32_t SHAPE_PAIR_COUNT = SHAPE_TYPE_COUNT * SHAPE_TYPE_COUNT;
+
+  /**
+   * @brief   Narrowphase routine for each [shape type of body A][shape type of body B], nullptr where the types never collide
+   * @details New shape pairs plug in here. A mixed pair fills both of its cells, the mirrored cell taking its pairs with the
+   *          bodies the other way around
+   */
+  static const PairFunction PAIR_FUNCTIONS[SHAPE_TYPE_COUNT][SHAPE_TYPE_COUNT];
+
+  /**
+   * @brief   Index of a pair's shape type combination in [0, SHAPE_PAIR_COUNT), typeA * SHAPE_TYPE_COUNT + typeB
+   */
+  static uint32_t getPairType(const BodyStore &bodies, const BroadphasePair &pair);
+
+  static bool sphereSphere(const BodyStore &bodies, uint32_t a, uint32_t b, Contact *contact);
+  static bool spherePlane(const BodyStore &bodies, uint32_t sphere, const Vector3D &planeNormal, float planeDistance, Contact *contact);
+
+  /**
+   * @brief   Test a list of sphere pairs a SIMD pack at a time, appending a contact for every overlapping pair
+   * @details Radii and positions are read straight from the store's columns, so rejecting a pair never touches the shapes.
+   *          Only hits look up the shape materials. Contacts come out in pair order
+   * @param   bodies Body storage the pairs index into
+   * @param   pairs Candidate pairs, both bodies must be spheres
+   * @param   count Number of pairs
+   * @param   contacts Stream the hits are appended to
+   * @return  Number of contacts appended
+   */
+  static uint32_t sphereSphereBatch(const BodyStore &bodies, const BroadphasePair *pairs, uint32_t count, FrameVector<Contact> &contacts);
+
+  /**
+   * @brief   Test a list of spheres against one plane a SIMD pack at a time, appending a contact for every hit
+   * @param   spheres Store indices of the spheres
+   * @param   count Number of spheres
+   * @return  Number of contacts appended
+   */
+  static uint32_t spherePlaneBatch(const BodyStore &bodies, const uint32_t *spheres, uint32_t count, const Vector3D &planeNormal, float planeDistance,
+                                   FrameVector<Contact> &contacts);
 };
 
 /** @} */
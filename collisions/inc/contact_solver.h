@@ -0,0 +1,186 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   contact_solver.h
+ *
+ * @brief  Header file for the sequential impulse contact solver
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/* Inter-component Headers */
+#include "body_store.h"
+#include "frame_arena.h"
+#include "job_system.h"
+#include "matrix_3d.h"
+#include "vector_3d.h"
+
+/* Intra-component Headers */
+#include "collision.h"
+
+/**
+ * @defgroup CollisionModules
+ * @brief    Collision modules for handling interactions
+ * @{
+ */
+
+enum class PositionCorrection {
+  BAUMGARTE,    /**< Feed a fraction of the penetration back into the velocity constraint. Cheap, but adds energy */
+  SPLIT_IMPULSE /**< Push bodies apart with separate pseudo velocities that never reach the real velocities */
+};
+
+/**
+ * @brief   Sequential impulse solver for contacts, with Coulomb friction
+ * @details Each contact gets a normal and two friction constraints, including the angular terms from the contact point offsets.
+ *          The accumulated impulses are kept per body pair between steps and used to warm start the next solve, which makes
+ *          stacks settle in far fewer iterations.
+ *
+ *          To solve in parallel the contacts are graph coloured into batches where no two contacts share a moving body, so a
+ *          batch can be split across threads freely. Static bodies never change velocity and don't link contacts. Contacts
+ *          that don't fit in any colour go to an overflow batch that is solved serially
+ */
+class ContactSolver {
+ public:
+  static constexpr uint32_t DEFAULT_VELOCITY_ITERATIONS = 8U;
+  static constexpr uint32_t DEFAULT_POSITION_ITERATIONS = 3U;
+
+  void setIterations(uint32_t velocityIterations, uint32_t positionIterations);
+  void setPositionCorrection(PositionCorrection mode);
+  void setWarmStarting(bool enabled);
+
+  /**
+   * @brief   Solve colour batches across the job system's threads. nullptr solves everything serially
+   */
+  void setJobSystem(JobSystem *jobs);
+
+  /**
+   * @brief   Number of colour batches used by the last solve, not counting the overflow batch
+   */
+  uint32_t getColorCount() const;
+
+  /**
+   * @brief   Solve the contacts, updating the velocities (And positions for split impulse) in the store
+   * @param   bodies Body storage the contacts index into
+   * @param   contacts Contacts for this step, in a deterministic order
+   * @param   deltaTime Step length
+   * @param   arena Per-step arena the solver scratch is allocated from, it must outlive the call
+   */
+  void solve(BodyStore &bodies, std::span<const Contact> contacts, float deltaTime, FrameArena &arena);
+
+  /**
+   * @brief   Forget all cached impulses
+   */
+  void clear();
+
+ private:
+  friend class PhysicsWorld; /**< Snapshots save and restore the settings and the impulse cache */
+
+  static constexpr float BAUMGARTE_FACTOR = 0.2f;      /**< Fraction of the penetration removed per step */
+  static constexpr float PENETRATION_SLOP = 0.01f;     /**< Penetration left alone so resting contacts don't jitter */
+  static constexpr float RESTITUTION_THRESHOLD = 1.0f; /**< Slower impacts don't bounce, so bodies can come to rest */
+  static constexpr uint32_t MAX_COLORS = 32U;          /**< One bit per colour in a body's colour mask */
+  static constexpr uint32_t BATCH_GRAIN_SIZE = 64U;    /**< Contacts per job within a batch */
+
+  struct ContactConstraint {
+    uint32_t bodyA;      /**< Store index, or INVALID_INDEX for static geometry */
+    uint32_t bodyB;      /**< Store index, or INVALID_INDEX for static geometry */
+    Vector3D normal;     /**< From A to B */
+    Vector3D tangent1;   /**< Friction directions, perpendicular to the normal and each other */
+    Vector3D tangent2;
+    Vector3D offsetA;    /**< Contact point relative to A's center */
+    Vector3D offsetB;    /**< Contact point relative to B's center */
+    Matrix3D inverseInertiaA;
+    Matrix3D inverseInertiaB;
+    float inverseMassA;
+    float inverseMassB;
+    float normalMass;    /**< Effective mass along the normal */
+    float tangentMass1;
+    float tangentMass2;
+    float velocityBias;  /**< Target separating speed from restitution (And Baumgarte) */
+    float positionBias;  /**< Target separating speed of the split impulse */
+    float friction;
+    float normalImpulse; /**< Accumulated impulses */
+    float tangentImpulse1;
+    float tangentImpulse2;
+    float pseudoImpulse;
+    uint64_t cacheKey;
+  };
+
+  struct CachedImpulse {
+    uint64_t cacheKey;
+    BodyId bodyA;
+    BodyId bodyB;
+    float normalImpulse;
+    Vector3D tangentImpulse; /**< World space, so it survives the friction directions changing between steps */
+  };
+
+  uint32_t velocityIterations{DEFAULT_VELOCITY_ITERATIONS};
+  uint32_t positionIterations{DEFAULT_POSITION_ITERATIONS};
+  PositionCorrection positionCorrection{PositionCorrection::SPLIT_IMPULSE};
+  bool warmStarting{true};
+
+  JobSystem *jobs{nullptr};
+
+  /* Per-step scratch, in the arena handed to solve() */
+  FrameVector<ContactConstraint> constraints; /**< Grouped by colour, the overflow batch last */
+  FrameVector<ContactConstraint> unsortedConstraints;
+  FrameVector<uint32_t> constraintColors;
+  FrameVector<uint32_t> batchStart;           /**< Start of each colour's batch in constraints, then the overflow batch */
+
+  std::vector<uint32_t> bodyColors; /**< Mask of the colours already used by each body's contacts, all zero between steps */
+  uint32_t colorCount{0U};
+
+  /* Impulses of last step's contacts, and of sleeping contacts, sorted by (slot of body A << 32 | slot of body B), and the ones
+     being written this step. Flat arrays swapped every step instead of a hash map, so the steady state allocates nothing */
+  std::vector<CachedImpulse> impulseCache;
+  std::vector<CachedImpulse> nextImpulseCache;
+
+  /* Split impulse pseudo velocities, indexed like the store */
+  Vector3DArray pseudoLinearVelocity;
+  Vector3DArray pseudoAngularVelocity;
+
+  void prepare(BodyStore &bodies, std::span<const Contact> contacts, float deltaTime);
+  void colorConstraints(const BodyStore &bodies);
+
+  /**
+   * @brief   Run function(constraint) over every constraint, a colour at a time with each colour split across threads
+   */
+  template <typename Function>
+  void forEachConstraint(Function &&function) {
+    for (uint32_t color = 0U; color < colorCount; color++) {
+      uint32_t begin = batchStart[color];
+      uint32_t count = batchStart[color + 1U] - begin;
+
+      if (jobs) {
+        jobs->parallelFor(count, BATCH_GRAIN_SIZE, [this, &function, begin](uint32_t first, uint32_t last) {
+          for (uint32_t i = begin + first; i < begin + last; i++) {
+            function(constraints[i]);
+          }
+        });
+      } else {
+        for (uint32_t i = begin; i < begin + count; i++) {
+          function(constraints[i]);
+        }
+      }
+    }
+
+    /* Overflow contacts can share bodies with each other, so they run on one thread */
+    for (uint32_t i = batchStart[colorCount]; i < constraints.size(); i++) {
+      function(constraints[i]);
+    }
+  }
+  void warmStart(BodyStore &bodies);
+  void solveVelocities(BodyStore &bodies);
+  void solvePositions(BodyStore &bodies, float deltaTime);
+  void storeImpulses(const BodyStore &bodies);
+
+  static void applyImpulse(BodyStore &bodies, const ContactConstraint &constraint, const Vector3D &impulse);
+};
+
+/** @} */
@@ -0,0 +1,127 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   dynamic_tree.h
+ *
+ * @brief  Header file for the dynamic AABB tree broadphase
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstdint>
+#include <vector>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "broadphase.h"
+#include "pair_map.h"
+
+/**
+ * @defgroup CollisionModules
+ * @brief    Collision modules for handling interactions
+ * @{
+ */
+
+/**
+ * @brief   Dynamic bounding volume hierarchy of fattened AABBs
+ * @details Leaves store a fat box (The real bounds grown by a margin) so a body that moves a little stays inside it and costs
+ *          nothing. Only bodies that leave their fat box get removed and reinserted, using a surface area heuristic to pick the
+ *          sibling and AVL style rotations to keep the tree balanced. Nodes live in a contiguous pool and link by index.
+ *          Fat box pairs only change when a leaf is reinserted, so the pair cache is updated from the moved leaves alone
+ */
+class DynamicTree : public Broadphase {
+ public:
+  static constexpr float DEFAULT_MARGIN = 0.1f;
+
+  explicit DynamicTree(float margin = DEFAULT_MARGIN);
+
+  uint32_t createProxy(const AABB &box, uint32_t userData) override;
+  void destroyProxy(uint32_t proxyId) override;
+  void moveProxy(uint32_t proxyId, const AABB &box) override;
+  void setUserData(uint32_t proxyId, uint32_t userData) override;
+  void updatePairs() override;
+  const std::vector<BroadphasePair> &getPairs() const override;
+  void query(const AABB &box, std::vector<uint32_t> &results) const override;
+
+  /**
+   * @brief   Visit every leaf whose fat box overlaps the given box
+   * @param   callback Called with the proxy ID of each leaf
+   */
+  template <typename Callback>
+  void queryLeaves(const AABB &box, Callback &&callback) const {
+    if (root == NULL_NODE) {
+      return;
+    }
+
+    uint32_t stack[MAX_QUERY_DEPTH];
+    unsigned int stackSize = 0U;
+    stack[stackSize++] = root;
+
+    while (stackSize > 0U) {
+      const Node &node = nodes[stack[--stackSize]];
+      if (!node.box.overlaps(box)) {
+        continue;
+      }
+
+      if (node.height == 0) {
+        callback(static_cast<uint32_t>(&node - nodes.data()));
+      } else {
+        stack[stackSize++] = node.child1;
+        stack[stackSize++] = node.child2;
+      }
+    }
+  }
+
+  /**
+   * @brief   Height of the tree, 0 for a single leaf
+   */
+  int32_t getHeight() const;
+
+ private:
+  static constexpr uint32_t NULL_NODE = 0xFFFFFFFFU;
+  /* The tree is height balanced, so this covers far more leaves than can fit in memory */
+  static constexpr unsigned int MAX_QUERY_DEPTH = 256U;
+
+  struct Node {
+    AABB box;          /**< Fat bounds for leaves, union of the children otherwise */
+    AABB tightBox;     /**< Real bounds of a leaf */
+    uint32_t parent;   /**< Parent node, or the next free node while in the free list */
+    uint32_t child1;   /**< First child, NULL_NODE for leaves */
+    uint32_t child2;   /**< Second child, NULL_NODE for leaves */
+    int32_t height;    /**< 0 for leaves, -1 for free nodes */
+    uint32_t userData; /**< User data reported in pairs */
+    bool moved;        /**< Leaf was (re)inserted since the last update */
+    bool alive;        /**< False once the proxy is destroyed */
+  };
+
+  float margin;
+  std::vector<Node> nodes;
+  uint32_t root{NULL_NODE};
+  uint32_t freeList{NULL_NODE};
+
+  std::vector<uint32_t> movedLeaves;
+  std::vector<uint32_t> destroyedLeaves;
+  std::vector<BroadphasePair> candidatePairs; /**< Leaf pairs found by the moved leaf queries, before deduplication */
+
+  /* Pairs with overlapping fat boxes, keyed by (lower proxy ID << 32 | higher proxy ID) */
+  std::vector<uint64_t> pairKeys;
+  PairMap pairLookup; /**< Index of each key in pairKeys */
+  std::vector<BroadphasePair> pairs;
+
+  uint32_t allocateNode();
+  void freeNode(uint32_t node);
+
+  void insertLeaf(uint32_t leaf);
+  void removeLeaf(uint32_t leaf);
+  uint32_t balance(uint32_t node);
+  void refitAncestors(uint32_t node);
+  void markMoved(uint32_t leaf);
+
+  void addPair(uint32_t leafA, uint32_t leafB);
+  void removePairAt(size_t index);
+};
+
+/** @} */
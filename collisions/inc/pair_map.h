@@ -0,0 +1,70 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   pair_map.h
+ *
+ * @brief  Header file for a flat hash map from proxy pair keys to indices
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup CollisionModules
+ * @brief    Collision modules for handling interactions
+ * @{
+ */
+
+/**
+ * @brief   Open addressing hash map from a pair key (lower proxy ID << 32 | higher proxy ID) to a 32 bit value
+ * @details Keys and values live in two flat arrays probed linearly, and erasing shifts the following entries back instead of
+ *          leaving tombstones. Nothing is allocated per entry and the arrays keep their capacity through erase() and clear(), so
+ *          once the table has grown to fit the scene, adding and removing pairs doesn't touch the heap
+ */
+class PairMap {
+ public:
+  /**
+   * @brief   Value for key, or nullptr if the key isn't in the map
+   */
+  uint32_t *find(uint64_t key);
+  const uint32_t *find(uint64_t key) const;
+
+  /**
+   * @brief   Add key with value
+   * @return  false if the key was already there, its value is left as it was
+   */
+  bool insert(uint64_t key, uint32_t value);
+
+  /**
+   * @brief   Remove key
+   * @return  false if the key wasn't there
+   */
+  bool erase(uint64_t key);
+
+  void clear();
+  size_t size() const;
+
+ private:
+  static constexpr uint64_t EMPTY_KEY = 0xFFFFFFFFFFFFFFFFULL; /**< Both proxy IDs at their maximum, never a real pair */
+  static constexpr size_t MIN_CAPACITY = 64U;
+
+  std::vector<uint64_t> keys;
+  std::vector<uint32_t> values;
+  size_t count{0U};
+  uint32_t shift{64U}; /**< 64 - log2(capacity), the hash keeps the top bits */
+
+  size_t home(uint64_t key) const;
+  size_t findSlot(uint64_t key) const;
+  void grow();
+};
+
+/** @} */
@@ -0,0 +1,87 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   spatial_hash_grid.h
+ *
+ * @brief  Header file for the spatial hash grid broadphase
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstdint>
+#include <vector>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "broadphase.h"
+
+/**
+ * @defgroup CollisionModules
+ * @brief    Collision modules for handling interactions
+ * @{
+ */
+
+/**
+ * @brief   Hashed uniform grid, rebuilt every update
+ * @details Each proxy is binned by the cell holding its center. The bins are built with a counting sort into flat arrays
+ *          (no per-cell allocations), and each proxy is only tested against the 27 cells around it. The cell size is picked
+ *          from the size distribution so that every regular proxy fits in one cell. Proxies much larger than the median are
+ *          kept out of the grid and tested against everything instead
+ */
+class SpatialHashGrid : public Broadphase {
+ public:
+  uint32_t createProxy(const AABB &box, uint32_t userData) override;
+  void destroyProxy(uint32_t proxyId) override;
+  void moveProxy(uint32_t proxyId, const AABB &box) override;
+  void setUserData(uint32_t proxyId, uint32_t userData) override;
+  void updatePairs() override;
+  const std::vector<BroadphasePair> &getPairs() const override;
+  void query(const AABB &box, std::vector<uint32_t> &results) const override;
+
+  /**
+   * @brief   Cell size picked by the last updatePairs() call
+   */
+  float getCellSize() const;
+
+ private:
+  static constexpr float OVERSIZED_FACTOR = 4.0f; /**< Proxies bigger than this multiple of the median radius skip the grid */
+  static constexpr float MIN_CELL_SIZE = 1e-4f;
+  static constexpr uint32_t NOT_BINNED = 0xFFFFFFFFU;
+
+  struct Proxy {
+    AABB box;          /**< Latest bounds */
+    uint32_t userData; /**< User data reported in pairs */
+    bool alive;        /**< False once destroyed */
+  };
+
+  std::vector<Proxy> proxies;
+  std::vector<uint32_t> freeProxies;
+  std::vector<BroadphasePair> pairs;
+  float cellSize{1.0f};
+
+  /* Per-update scratch arrays, kept around so steady state updates don't allocate */
+  std::vector<uint32_t> entryProxies; /**< Proxy ID of each live entry */
+  std::vector<float> entryRadii;      /**< Largest half extent of each entry */
+  std::vector<int32_t> entryCells;    /**< Cell coordinates of each entry, three per entry */
+  std::vector<uint32_t> entryBuckets; /**< Hash bucket of each entry, or NOT_BINNED */
+  std::vector<uint32_t> bucketStart;  /**< Start of each bucket in sortedEntries */
+  std::vector<uint32_t> sortedEntries;
+  std::vector<uint32_t> oversizedEntries;
+  std::vector<float> radiusScratch;
+
+  static uint32_t hashCell(int32_t x, int32_t y, int32_t z, uint32_t mask);
+
+  void chooseCellSize();
+  void binEntries();
+  BroadphasePair makePair(uint32_t entryA, uint32_t entryB) const;
+
+  /**
+   * @brief   Test the binned entries in [begin, end) against their neighbouring cells
+   */
+  void findGridPairs(uint32_t begin, uint32_t end, FrameVector<BroadphasePair> &output) const;
+};
+
+/** @} */
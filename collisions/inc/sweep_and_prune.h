@@ -0,0 +1,113 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   sweep_and_prune.h
+ *
+ * @brief  Header file for the incremental sweep and prune broadphase
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstdint>
+#include <vector>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "broadphase.h"
+#include "pair_map.h"
+
+/**
+ * @defgroup CollisionModules
+ * @brief    Collision modules for handling interactions
+ * @{
+ */
+
+/**
+ * @brief   Incremental sweep and prune over all three axes
+ * @details Sorted endpoint lists are kept between updates and re-sorted with insertion sort. Bodies move very little between
+ *          steps, so the lists are nearly sorted and each update costs O(N + swaps). Every swap of a min and max endpoint is
+ *          an overlap change, which is how the pair list and the added/removed deltas are maintained without a full rebuild
+ */
+class SweepAndPrune : public Broadphase {
+ public:
+  uint32_t createProxy(const AABB &box, uint32_t userData) override;
+  void destroyProxy(uint32_t proxyId) override;
+  void moveProxy(uint32_t proxyId, const AABB &box) override;
+  void setUserData(uint32_t proxyId, uint32_t userData) override;
+  void updatePairs() override;
+  const std::vector<BroadphasePair> &getPairs() const override;
+  void query(const AABB &box, std::vector<uint32_t> &results) const override;
+
+  /**
+   * @brief   Pairs that started overlapping during the last updatePairs() call
+   */
+  const std::vector<BroadphasePair> &getAddedPairs() const;
+
+  /**
+   * @brief   Pairs that stopped overlapping (Or lost a proxy) during the last updatePairs() call
+   * @details Named by the user data the proxies had when the pair was removed, a destroyed proxy by the user data it was
+   *          destroyed with
+   */
+  const std::vector<BroadphasePair> &getRemovedPairs() const;
+
+ private:
+  static constexpr unsigned int AXIS_COUNT = 3U;
+  static constexpr uint32_t MAX_ENDPOINT_FLAG = 0x80000000U;
+  /* Inserting one proxy incrementally is O(N), so large batches of new proxies re-sort from scratch instead */
+  static constexpr size_t INCREMENTAL_INSERT_LIMIT = 32U;
+
+  struct Endpoint {
+    float value;   /**< Position of the endpoint along the axis */
+    uint32_t data; /**< Proxy ID, with MAX_ENDPOINT_FLAG set for a max endpoint */
+  };
+
+  struct Proxy {
+    AABB box;                      /**< Latest bounds */
+    uint32_t userData;             /**< User data reported in pairs */
+    uint32_t minIndex[AXIS_COUNT]; /**< Index of the min endpoint in each axis list */
+    uint32_t maxIndex[AXIS_COUNT]; /**< Index of the max endpoint in each axis list */
+    bool alive;                    /**< False once destroyed */
+  };
+
+  std::vector<Proxy> proxies;
+  std::vector<uint32_t> freeProxies;
+  std::vector<uint32_t> destroyedProxies;
+  std::vector<Endpoint> endpoints[AXIS_COUNT];
+  size_t pendingInserts{0U};
+
+  /* Overlapping pairs, keyed by (lower proxy ID << 32 | higher proxy ID) */
+  std::vector<uint64_t> pairKeys;
+  PairMap pairLookup; /**< Index of each key in pairKeys */
+
+  /* Pairs touched during the current update, whether they existed before it, and their user data when last removed */
+  struct TouchedPair {
+    uint64_t key;
+    bool existed;
+    BroadphasePair removed;
+  };
+
+  std::vector<TouchedPair> touchedPairs;
+  PairMap touchedLookup; /**< Index of each key in touchedPairs */
+
+  std::vector<BroadphasePair> pairs;
+  std::vector<BroadphasePair> addedPairs;
+  std::vector<BroadphasePair> removedPairs;
+
+  static uint64_t makeKey(uint32_t proxyA, uint32_t proxyB);
+  static bool endpointLess(const Endpoint &a, const Endpoint &b);
+  BroadphasePair keyToPair(uint64_t key) const;
+
+  TouchedPair &touchPair(uint64_t key, bool existed);
+  void addPair(uint32_t proxyA, uint32_t proxyB);
+  void removePair(uint32_t proxyA, uint32_t proxyB);
+
+  void purgeDestroyedProxies();
+  void sortAxisIncremental(unsigned int axis);
+  void rebuild();
+  void publishPairs();
+};
+
+/** @} */
@@ -0,0 +1,78 @@
+/*******************************************************************************************************************************
+ * @file   all_pairs_broadphase.cc
+ *
+ * @brief  Source file for the all-pairs broadphase
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "all_pairs_broadphase.h"
+
+uint32_t AllPairsBroadphase::createProxy(const AABB &box, uint32_t userData) {
+  uint32_t proxyId;
+
+  if (!freeProxies.empty()) {
+    proxyId = freeProxies.back();
+    freeProxies.pop_back();
+  } else {
+    proxyId = static_cast<uint32_t>(proxies.size());
+    proxies.emplace_back();
+  }
+
+  proxies[proxyId] = Proxy{box, userData, true};
+  return proxyId;
+}
+
+void AllPairsBroadphase::destroyProxy(uint32_t proxyId) {
+  proxies[proxyId].alive = false;
+  freeProxies.push_back(proxyId);
+}
+
+void AllPairsBroadphase::moveProxy(uint32_t proxyId, const AABB &box) {
+  proxies[proxyId].box = box;
+}
+
+void AllPairsBroadphase::setUserData(uint32_t proxyId, uint32_t userData) {
+  proxies[proxyId].userData = userData;
+}
+
+void AllPairsBroadphase::updatePairs() {
+  pairs.clear();
+
+  /* Check all pairs of proxies. O(N^2) */
+  collectPairs(static_cast<uint32_t>(proxies.size()), pairs, [this](uint32_t begin, uint32_t end, FrameVector<BroadphasePair> &output) {
+    for (size_t i = begin; i < end; i++) {
+      if (!proxies[i].alive) {
+        continue;
+      }
+
+      for (size_t j = i + 1; j < proxies.size(); j++) {
+        if (!proxies[j].alive || !proxies[i].box.overlaps(proxies[j].box)) {
+          continue;
+        }
+
+        uint32_t userA = proxies[i].userData;
+        uint32_t userB = proxies[j].userData;
+        output.push_back((userA < userB) ? BroadphasePair{userA, userB} : BroadphasePair{userB, userA});
+      }
+    }
+  });
+}
+
+const std::vector<BroadphasePair> &AllPairsBroadphase::getPairs() const {
+  return pairs;
+}
+
+void AllPairsBroadphase::query(const AABB &box, std::vector<uint32_t> &results) const {
+  for (const Proxy &proxy : proxies) {
+    if (proxy.alive && proxy.box.overlaps(box)) {
+      results.push_back(proxy.userData);
+    }
+  }
+}
@@ -0,0 +1,37 @@
+/*******************************************************************************************************************************
+ * @file   broadphase.cc
+ *
+ * @brief  Source file for the broadphase interface
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "all_pairs_broadphase.h"
+#include "broadphase.h"
+#include "dynamic_tree.h"
+#include "spatial_hash_grid.h"
+#include "sweep_and_prune.h"
+
+std::unique_ptr<Broadphase> Broadphase::create(BroadphaseType type) {
+  switch (type) {
+    case BroadphaseType::ALL_PAIRS:
+      return std::make_unique<AllPairsBroadphase>();
+    case BroadphaseType::SPATIAL_HASH:
+      return std::make_unique<SpatialHashGrid>();
+    case BroadphaseType::DYNAMIC_TREE:
+      return std::make_unique<DynamicTree>();
+    case BroadphaseType::SWEEP_AND_PRUNE:
+    default:
+      return std::make_unique<SweepAndPrune>();
+  }
+}
+
+void Broadphase::setJobSystem(JobSystem *jobs) {
+  this->jobs = jobs;
+}
@@ -8,23 +8,34 @@
  *******************************************************************************************************************************/
 
 /* Standard library Headers */
+#include <algorithm>
+#include <bit>
 #include <iostream>
 
 /* Inter-component Headers */
+#include "float_pack.h"
 #include "math_utils.h"
-#include "sphere.h"
+#include "vector_pack.h"
 
 /* Intra-component Headers */
 #include "collision.h"
 
-bool CollisionDetector::sphereSphere(const RigidBody *a, const RigidBody *b, Contact *contact) {
-  auto sphereA = std::dynamic_pointer_cast<Sphere>(a->getShape());
-  auto sphereB = std::dynamic_pointer_cast<Sphere>(b->getShape());
+const CollisionDetector::PairFunction CollisionDetector::PAIR_FUNCTIONS[SHAPE_TYPE_COUNT][SHAPE_TYPE_COUNT] = {
+    /* SPHERE */ {&CollisionDetector::sphereSphereBatch},
+};
 
-  Vector3D aPos = a->getPosition();
-  Vector3D bPos = b->getPosition();
-  float aRadius = sphereA->getRadius();
-  float bRadius = sphereB->getRadius();
+uint32_t CollisionDetector::getPairType(const BodyStore &bodies, const BroadphasePair &pair) {
+  return (static_cast<uint32_t>(bodies.shapeType[pair.a]) * SHAPE_TYPE_COUNT) + static_cast<uint32_t>(bodies.shapeType[pair.b]);
+}
+
+bool CollisionDetector::sphereSphere(const BodyStore &bodies, uint32_t a, uint32_t b, Contact *contact) {
+  if (bodies.shapeType[a] != ShapeType::SPHERE || bodies.shapeType[b] != ShapeType::SPHERE)
+    return false;
+
+  Vector3D aPos = bodies.position.get(a);
+  Vector3D bPos = bodies.position.get(b);
+  float aRadius = bodies.getSphereRadius(a);
+  float bRadius = bodies.getSphereRadius(b);
 
   Vector3D normal = bPos - aPos;
   float distanceSquared = normal.lengthSquared();
@@ -50,24 +61,25 @@ bool CollisionDetector::sphereSphere(const RigidBody *a, const RigidBody *b, Con
 
     /* Contact point is halfway between sphere surfaces */
     contact->point = aPos + (normal * (aRadius + (contact->penetration * 0.5f)));
-    contact->bodyA = const_cast<RigidBody *>(a);
-    contact->bodyB = const_cast<RigidBody *>(b);
+    contact->bodyA = a;
+    contact->bodyB = b;
 
     /* Calculate combined restitution and friction */
-    contact->restitution = std::sqrt(sphereA->getRestitution() * sphereB->getRestitution());
-    contact->friction = std::sqrt(sphereA->getFriction() * sphereB->getFriction());
+    const Shape &shapeA = *bodies.shapes[a];
+    const Shape &shapeB = *bodies.shapes[b];
+    contact->restitution = std::sqrt(shapeA.getRestitution() * shapeB.getRestitution());
+    contact->friction = std::sqrt(shapeA.getFriction() * shapeB.getFriction());
   }
 
   return true;
 }
 
-bool CollisionDetector::spherePlane(const RigidBody *sphere, const Vector3D &planeNormal, float planeDistance, Contact *contact) {
-  auto sphereShape = std::dynamic_pointer_cast<Sphere>(sphere->getShape());
-  if (!sphereShape)
+bool CollisionDetector::spherePlane(const BodyStore &bodies, uint32_t sphere, const Vector3D &planeNormal, float planeDistance, Contact *contact) {
+  if (bodies.shapeType[sphere] != ShapeType::SPHERE)
     return false;
 
-  Vector3D pos = sphere->getPosition();
-  float radius = sphereShape->getRadius();
+  Vector3D pos = bodies.position.get(sphere);
+  float radius = bodies.getSphereRadius(sphere);
 
   // Calculate distance from sphere center to plane
   float distance = planeNormal.dotProduct(pos) - planeDistance;
@@ -82,13 +94,156 @@ bool CollisionDetector::spherePlane(const RigidBody *sphere, const Vector3D &pla
     contact->normal = distance > 0 ? planeNormal * -1.0f : planeNormal;
     contact->penetration = radius - std::abs(distance);
     contact->point = pos - (planeNormal * distance);
-    contact->bodyA = const_cast<RigidBody *>(sphere);
-    contact->bodyB = nullptr; /* Plane is static */
+    contact->bodyA = sphere;
+    contact->bodyB = BodyStore::INVALID_INDEX; /* Plane is static */
 
     /* Set restitution and friction (using sphere values only since plane is static) */
-    contact->restitution = sphereShape->getRestitution();
-    contact->friction = sphereShape->getFriction();
+    contact->restitution = bodies.shapes[sphere]->getRestitution();
+    contact->friction = bodies.shapes[sphere]->getFriction();
   }
 
   return true;
 }
+
+namespace {
+/* Contact data of a whole pack, spilled to memory so the hit lanes can be picked out one at a time */
+struct PackContacts {
+  alignas(64) float pointX[NATIVE_PACK_WIDTH];
+  alignas(64) float pointY[NATIVE_PACK_WIDTH];
+  alignas(64) float pointZ[NATIVE_PACK_WIDTH];
+  alignas(64) float normalX[NATIVE_PACK_WIDTH];
+  alignas(64) float normalY[NATIVE_PACK_WIDTH];
+  alignas(64) float normalZ[NATIVE_PACK_WIDTH];
+  alignas(64) float penetration[NATIVE_PACK_WIDTH];
+
+  void store(const Vec3xN &point, const Vec3xN &normal, const FloatxN &depth) {
+    point.x.store(pointX);
+    point.y.store(pointY);
+    point.z.store(pointZ);
+    normal.x.store(normalX);
+    normal.y.store(normalY);
+    normal.z.store(normalZ);
+    depth.store(penetration);
+  }
+
+  void fill(uint32_t lane, Contact &contact) const {
+    contact.point = Vector3D(pointX[lane], pointY[lane], pointZ[lane]);
+    contact.normal = Vector3D(normalX[lane], normalY[lane], normalZ[lane]);
+    contact.penetration = penetration[lane];
+  }
+};
+
+/* Mask with a bit set for each of the first valid lanes */
+uint32_t validLaneMask(uint32_t valid) {
+  return (valid >= 32U) ? 0xFFFFFFFFU : ((1U << valid) - 1U);
+}
+}  // namespace
+
+uint32_t CollisionDetector::sphereSphereBatch(const BodyStore &bodies, const BroadphasePair *pairs, uint32_t count, FrameVector<Contact> &contacts) {
+  const size_t firstContact = contacts.size();
+  alignas(64) uint32_t indicesA[NATIVE_PACK_WIDTH];
+  alignas(64) uint32_t indicesB[NATIVE_PACK_WIDTH];
+  alignas(64) uint32_t entriesA[NATIVE_PACK_WIDTH]; /* Sphere pool entries */
+  alignas(64) uint32_t entriesB[NATIVE_PACK_WIDTH];
+  PackContacts packContacts;
+
+  for (uint32_t first = 0U; first < count; first += NATIVE_PACK_WIDTH) {
+    /* A short last pack repeats its final pair, the repeats are masked off below */
+    const uint32_t valid = std::min<uint32_t>(count - first, NATIVE_PACK_WIDTH);
+    for (uint32_t lane = 0U; lane < NATIVE_PACK_WIDTH; lane++) {
+      const BroadphasePair &pair = pairs[first + std::min(lane, valid - 1U)];
+      indicesA[lane] = pair.a;
+      indicesB[lane] = pair.b;
+      entriesA[lane] = bodies.shapeIndex[pair.a];
+      entriesB[lane] = bodies.shapeIndex[pair.b];
+    }
+
+    Vec3xN positionA = Vec3xN::gather(bodies.position, indicesA);
+    Vec3xN positionB = Vec3xN::gather(bodies.position, indicesB);
+    FloatxN radiusA = FloatxN::gather(bodies.spheres.radius.data(), entriesA);
+    FloatxN radiusSum = radiusA + FloatxN::gather(bodies.spheres.radius.data(), entriesB);
+
+    /* Same rejection test as sphereSphere, without a square root */
+    Vec3xN delta = positionB - positionA;
+    FloatxN distanceSquared = ((delta.x * delta.x) + (delta.y * delta.y)) + (delta.z * delta.z);
+    uint32_t hits = (distanceSquared <= (radiusSum * radiusSum)).moveMask() & validLaneMask(valid);
+    if (hits == 0U) {
+      continue;
+    }
+
+    /* Build the contacts for the whole pack, then keep the hit lanes. Coincident centers get an arbitrary up normal */
+    FloatxN distance = FloatxN::sqrt(distanceSquared);
+    FloatxN separated = distance > FloatxN(math::EPSILON);
+    Vec3xN normal = Vec3xN::select(separated, delta * (FloatxN(1.0f) / distance), Vec3xN(Vector3D(0, 1, 0)));
+    FloatxN penetration = radiusSum - distance;
+    Vec3xN point = positionA + (normal * (radiusA + (penetration * FloatxN(0.5f))));
+    packContacts.store(point, normal, penetration);
+
+    while (hits != 0U) {
+      const uint32_t lane = static_cast<uint32_t>(std::countr_zero(hits));
+      hits &= hits - 1U;
+
+      Contact contact;
+      packContacts.fill(lane, contact);
+      contact.bodyA = indicesA[lane];
+      contact.bodyB = indicesB[lane];
+
+      const Shape &shapeA = *bodies.shapes[contact.bodyA];
+      const Shape &shapeB = *bodies.shapes[contact.bodyB];
+      contact.restitution = std::sqrt(shapeA.getRestitution() * shapeB.getRestitution());
+      contact.friction = std::sqrt(shapeA.getFriction() * shapeB.getFriction());
+      contacts.push_back(contact);
+    }
+  }
+
+  return static_cast<uint32_t>(contacts.size() - firstContact);
+}
+
+uint32_t CollisionDetector::spherePlaneBatch(const BodyStore &bodies, const uint32_t *spheres, uint32_t count, const Vector3D &planeNormal, float planeDistance,
+                                             FrameVector<Contact> &contacts) {
+  const size_t firstContact = contacts.size();
+  const Vec3xN normalPack(planeNormal);
+  const FloatxN distancePack(planeDistance);
+  alignas(64) uint32_t indices[NATIVE_PACK_WIDTH];
+  alignas(64) uint32_t entries[NATIVE_PACK_WIDTH];
+  PackContacts packContacts;
+
+  for (uint32_t first = 0U; first < count; first += NATIVE_PACK_WIDTH) {
+    const uint32_t valid = std::min<uint32_t>(count - first, NATIVE_PACK_WIDTH);
+    for (uint32_t lane = 0U; lane < NATIVE_PACK_WIDTH; lane++) {
+      indices[lane] = spheres[first + std::min(lane, valid - 1U)];
+      entries[lane] = bodies.shapeIndex[indices[lane]];
+    }
+
+    Vec3xN position = Vec3xN::gather(bodies.position, indices);
+    FloatxN radius = FloatxN::gather(bodies.spheres.radius.data(), entries);
+
+    /* Signed distance from the sphere center to the plane */
+    FloatxN distance = (((normalPack.x * position.x) + (normalPack.y * position.y)) + (normalPack.z * position.z)) - distancePack;
+    FloatxN absoluteDistance = FloatxN::max(distance, -distance);
+    uint32_t hits = (absoluteDistance <= radius).moveMask() & validLaneMask(valid);
+    if (hits == 0U) {
+      continue;
+    }
+
+    Vec3xN normal = Vec3xN::select(distance > FloatxN(0.0f), -normalPack, normalPack);
+    packContacts.store(position - (normalPack * distance), normal, radius - absoluteDistance);
+
+    while (hits != 0U) {
+      const uint32_t lane = static_cast<uint32_t>(std::countr_zero(hits));
+      hits &= hits - 1U;
+
+      Contact contact;
+      packContacts.fill(lane, contact);
+      contact.bodyA = indices[lane];
+      contact.bodyB = BodyStore::INVALID_INDEX; /* Plane is static */
+
+      const Shape &shape = *bodies.shapes[contact.bodyA];
+      contact.restitution = shape.getRestitution();
+      contact.friction = shape.getFriction();
+      contacts.push_back(contact);
+    }
+  }
+
+  return static_cast<uint32_t>(contacts.size() - firstContact);
+}
@@ -0,0 +1,399 @@
+/*******************************************************************************************************************************
+ * @file   contact_solver.cc
+ *
+ * @brief  Source file for the sequential impulse contact solver
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+/* Inter-component Headers */
+#include "profiler.h"
+
+/* Intra-component Headers */
+#include "contact_solver.h"
+
+namespace {
+/**
+ * @brief   Velocity of a point on a body, offset from its center
+ */
+Vector3D pointVelocity(const Vector3DArray &linear, const Vector3DArray &angular, uint32_t body, const Vector3D &offset) {
+  if (body == BodyStore::INVALID_INDEX) {
+    return Vector3D(0, 0, 0);
+  }
+
+  return linear.get(body) + angular.get(body).crossProduct(offset);
+}
+
+/**
+ * @brief   Inverse of the effective mass of the pair along a direction
+ */
+float inverseEffectiveMass(float inverseMassA, float inverseMassB, const Matrix3D &inverseInertiaA, const Matrix3D &inverseInertiaB, const Vector3D &offsetA,
+                           const Vector3D &offsetB, const Vector3D &direction) {
+  Vector3D angularA = offsetA.crossProduct(direction);
+  Vector3D angularB = offsetB.crossProduct(direction);
+
+  return inverseMassA + inverseMassB + angularA.dotProduct(inverseInertiaA * angularA) + angularB.dotProduct(inverseInertiaB * angularB);
+}
+}  // namespace
+
+void ContactSolver::setIterations(uint32_t velocityIterations, uint32_t positionIterations) {
+  this->velocityIterations = velocityIterations;
+  this->positionIterations = positionIterations;
+}
+
+void ContactSolver::setPositionCorrection(PositionCorrection mode) {
+  this->positionCorrection = mode;
+}
+
+void ContactSolver::setWarmStarting(bool enabled) {
+  this->warmStarting = enabled;
+}
+
+void ContactSolver::setJobSystem(JobSystem *jobs) {
+  this->jobs = jobs;
+}
+
+uint32_t ContactSolver::getColorCount() const {
+  return colorCount;
+}
+
+void ContactSolver::clear() {
+  constraints.clear();
+  impulseCache.clear();
+}
+
+void ContactSolver::solve(BodyStore &bodies, std::span<const Contact> contacts, float deltaTime, FrameArena &arena) {
+  rebindFrameVector(constraints, arena, contacts.size());
+  rebindFrameVector(unsortedConstraints, arena, contacts.size());
+  rebindFrameVector(constraintColors, arena, contacts.size());
+  rebindFrameVector(batchStart, arena, MAX_COLORS + 2U);
+
+  {
+    PROFILE_SCOPE(scope, "prepareContacts");
+    prepare(bodies, contacts, deltaTime);
+  }
+  {
+    PROFILE_SCOPE(scope, "colorConstraints");
+    colorConstraints(bodies);
+    PROFILE_VALUE(scope, "colors", colorCount);
+  }
+
+  if (warmStarting) {
+    PROFILE_SCOPE(scope, "warmStart");
+    warmStart(bodies);
+  }
+
+  {
+    PROFILE_SCOPE(scope, "solveVelocities");
+    PROFILE_VALUE(scope, "iterations", velocityIterations);
+    for (uint32_t iteration = 0U; iteration < velocityIterations; iteration++) {
+      solveVelocities(bodies);
+    }
+  }
+
+  if (positionCorrection == PositionCorrection::SPLIT_IMPULSE) {
+    PROFILE_SCOPE(scope, "solvePositions");
+    solvePositions(bodies, deltaTime);
+  }
+
+  storeImpulses(bodies);
+}
+
+void ContactSolver::prepare(BodyStore &bodies, std::span<const Contact> contacts, float deltaTime) {
+  unsortedConstraints.clear();
+
+  const Matrix3D zeroMatrix = Matrix3D() * 0.0f;
+
+  for (const Contact &contact : contacts) {
+    ContactConstraint constraint{};
+    constraint.bodyA = contact.bodyA;
+    constraint.bodyB = contact.bodyB;
+    constraint.inverseInertiaA = zeroMatrix;
+    constraint.inverseInertiaB = zeroMatrix;
+
+    /* Massless bodies and static geometry act as an immovable body at the origin */
+    if (contact.bodyA != BodyStore::INVALID_INDEX) {
+      constraint.offsetA = contact.point - bodies.position.get(contact.bodyA);
+      constraint.inverseMassA = bodies.inverseMass[contact.bodyA];
+      if (constraint.inverseMassA > 0.0f) {
+        constraint.inverseInertiaA = bodies.getWorldInverseInertia(contact.bodyA);
+      }
+    }
+
+    if (contact.bodyB != BodyStore::INVALID_INDEX) {
+      constraint.offsetB = contact.point - bodies.position.get(contact.bodyB);
+      constraint.inverseMassB = bodies.inverseMass[contact.bodyB];
+      if (constraint.inverseMassB > 0.0f) {
+        constraint.inverseInertiaB = bodies.getWorldInverseInertia(contact.bodyB);
+      }
+    }
+
+    if (constraint.inverseMassA + constraint.inverseMassB <= 0.0f) {
+      continue; /* Two static bodies */
+    }
+
+    /* Fixed friction basis from the normal */
+    const Vector3D &normal = contact.normal;
+    constraint.normal = normal;
+    if (std::abs(normal.z) > 0.7071f) {
+      float scale = 1.0f / std::sqrt(normal.y * normal.y + normal.z * normal.z);
+      constraint.tangent1 = Vector3D(0.0f, -normal.z * scale, normal.y * scale);
+    } else {
+      float scale = 1.0f / std::sqrt(normal.x * normal.x + normal.y * normal.y);
+      constraint.tangent1 = Vector3D(-normal.y * scale, normal.x * scale, 0.0f);
+    }
+    constraint.tangent2 = normal.crossProduct(constraint.tangent1);
+
+    constraint.normalMass = 1.0f / inverseEffectiveMass(constraint.inverseMassA, constraint.inverseMassB, constraint.inverseInertiaA, constraint.inverseInertiaB,
+                                                        constraint.offsetA, constraint.offsetB, constraint.normal);
+    constraint.tangentMass1 = 1.0f / inverseEffectiveMass(constraint.inverseMassA, constraint.inverseMassB, constraint.inverseInertiaA, constraint.inverseInertiaB,
+                                                          constraint.offsetA, constraint.offsetB, constraint.tangent1);
+    constraint.tangentMass2 = 1.0f / inverseEffectiveMass(constraint.inverseMassA, constraint.inverseMassB, constraint.inverseInertiaA, constraint.inverseInertiaB,
+                                                          constraint.offsetA, constraint.offsetB, constraint.tangent2);
+    constraint.friction = contact.friction;
+
+    /* Bounce off the approach speed from before the solve */
+    Vector3D relativeVelocity = pointVelocity(bodies.linearVelocity, bodies.angularVelocity, contact.bodyB, constraint.offsetB) -
+                                pointVelocity(bodies.linearVelocity, bodies.angularVelocity, contact.bodyA, constraint.offsetA);
+    float approachSpeed = relativeVelocity.dotProduct(normal);
+    if (approachSpeed < -RESTITUTION_THRESHOLD) {
+      constraint.velocityBias = -contact.restitution * approachSpeed;
+    }
+
+    float correctionSpeed = std::max(contact.penetration - PENETRATION_SLOP, 0.0f) * BAUMGARTE_FACTOR / deltaTime;
+    if (positionCorrection == PositionCorrection::BAUMGARTE) {
+      constraint.velocityBias += correctionSpeed;
+    } else {
+      constraint.positionBias = correctionSpeed;
+    }
+
+    /* Slots of the handles are stable across steps, dense indices are not */
+    uint64_t slotA = (contact.bodyA != BodyStore::INVALID_INDEX) ? bodies.ids[contact.bodyA].index : BodyStore::INVALID_INDEX;
+    uint64_t slotB = (contact.bodyB != BodyStore::INVALID_INDEX) ? bodies.ids[contact.bodyB].index : BodyStore::INVALID_INDEX;
+    constraint.cacheKey = (slotA << 32U) | slotB;
+
+    if (warmStarting) {
+      auto cached = std::lower_bound(impulseCache.begin(), impulseCache.end(), constraint.cacheKey,
+                                     [](const CachedImpulse &entry, uint64_t key) { return entry.cacheKey < key; });
+      BodyId idA = (contact.bodyA != BodyStore::INVALID_INDEX) ? bodies.ids[contact.bodyA] : BodyId();
+      BodyId idB = (contact.bodyB != BodyStore::INVALID_INDEX) ? bodies.ids[contact.bodyB] : BodyId();
+
+      /* A slot reused by a new body must not inherit the old body's impulses */
+      if (cached != impulseCache.end() && cached->cacheKey == constraint.cacheKey && cached->bodyA == idA && cached->bodyB == idB) {
+        constraint.normalImpulse = cached->normalImpulse;
+        constraint.tangentImpulse1 = cached->tangentImpulse.dotProduct(constraint.tangent1);
+        constraint.tangentImpulse2 = cached->tangentImpulse.dotProduct(constraint.tangent2);
+      }
+    }
+
+    unsortedConstraints.push_back(constraint);
+  }
+}
+
+void ContactSolver::colorConstraints(const BodyStore &bodies) {
+  const uint32_t constraintCount = static_cast<uint32_t>(unsortedConstraints.size());
+  if (bodyColors.size() < bodies.size()) {
+    bodyColors.resize(bodies.size(), 0U);
+  }
+  constraintColors.resize(constraintCount);
+  colorCount = 0U;
+
+  /* Greedy first fit in contact order. Only moving bodies link contacts, a static body can be in every batch at once */
+  for (uint32_t i = 0U; i < constraintCount; i++) {
+    const ContactConstraint &constraint = unsortedConstraints[i];
+    uint32_t used = 0U;
+    if (constraint.inverseMassA > 0.0f) {
+      used |= bodyColors[constraint.bodyA];
+    }
+    if (constraint.inverseMassB > 0.0f) {
+      used |= bodyColors[constraint.bodyB];
+    }
+
+    uint32_t color = static_cast<uint32_t>(std::countr_one(used));
+    if (color < MAX_COLORS) {
+      if (constraint.inverseMassA > 0.0f) {
+        bodyColors[constraint.bodyA] |= 1U << color;
+      }
+      if (constraint.inverseMassB > 0.0f) {
+        bodyColors[constraint.bodyB] |= 1U << color;
+      }
+      colorCount = std::max(colorCount, color + 1U);
+    }
+    constraintColors[i] = color;
+  }
+
+  /* Counting sort into batches, the overflow batch goes after the last colour */
+  batchStart.assign(colorCount + 2U, 0U);
+  for (uint32_t i = 0U; i < constraintCount; i++) {
+    batchStart[std::min(constraintColors[i], colorCount) + 1U]++;
+  }
+  for (uint32_t batch = 1U; batch < batchStart.size(); batch++) {
+    batchStart[batch] += batchStart[batch - 1U];
+  }
+
+  uint32_t cursor[MAX_COLORS + 1U];
+  std::copy(batchStart.begin(), batchStart.begin() + colorCount + 1U, cursor);
+  constraints.resize(constraintCount);
+  for (uint32_t i = 0U; i < constraintCount; i++) {
+    constraints[cursor[std::min(constraintColors[i], colorCount)]++] = unsortedConstraints[i];
+  }
+
+  /* Leave the masks clear for the next step */
+  for (const ContactConstraint &constraint : unsortedConstraints) {
+    if (constraint.inverseMassA > 0.0f) {
+      bodyColors[constraint.bodyA] = 0U;
+    }
+    if (constraint.inverseMassB > 0.0f) {
+      bodyColors[constraint.bodyB] = 0U;
+    }
+  }
+}
+
+void ContactSolver::applyImpulse(BodyStore &bodies, const ContactConstraint &constraint, const Vector3D &impulse) {
+  if (constraint.inverseMassA > 0.0f) {
+    bodies.linearVelocity.set(constraint.bodyA, bodies.linearVelocity.get(constraint.bodyA) - impulse * constraint.inverseMassA);
+    bodies.angularVelocity.set(constraint.bodyA, bodies.angularVelocity.get(constraint.bodyA) - constraint.inverseInertiaA * constraint.offsetA.crossProduct(impulse));
+  }
+
+  if (constraint.inverseMassB > 0.0f) {
+    bodies.linearVelocity.set(constraint.bodyB, bodies.linearVelocity.get(constraint.bodyB) + impulse * constraint.inverseMassB);
+    bodies.angularVelocity.set(constraint.bodyB, bodies.angularVelocity.get(constraint.bodyB) + constraint.inverseInertiaB * constraint.offsetB.crossProduct(impulse));
+  }
+}
+
+void ContactSolver::warmStart(BodyStore &bodies) {
+  forEachConstraint([&bodies](ContactConstraint &constraint) {
+    Vector3D impulse = constraint.normal * constraint.normalImpulse + constraint.tangent1 * constraint.tangentImpulse1 + constraint.tangent2 * constraint.tangentImpulse2;
+    applyImpulse(bodies, constraint, impulse);
+  });
+}
+
+void ContactSolver::solveVelocities(BodyStore &bodies) {
+  forEachConstraint([&bodies](ContactConstraint &constraint) {
+    /* Friction first, bounded by the current normal impulse (Coulomb friction, |Ft| <= mu * Fn) */
+    float maxFriction = constraint.friction * constraint.normalImpulse;
+
+    Vector3D relativeVelocity = pointVelocity(bodies.linearVelocity, bodies.angularVelocity, constraint.bodyB, constraint.offsetB) -
+                                pointVelocity(bodies.linearVelocity, bodies.angularVelocity, constraint.bodyA, constraint.offsetA);
+    float lambda = -constraint.tangentMass1 * relativeVelocity.dotProduct(constraint.tangent1);
+    float accumulated = std::clamp(constraint.tangentImpulse1 + lambda, -maxFriction, maxFriction);
+    lambda = accumulated - constraint.tangentImpulse1;
+    constraint.tangentImpulse1 = accumulated;
+    applyImpulse(bodies, constraint, constraint.tangent1 * lambda);
+
+    relativeVelocity = pointVelocity(bodies.linearVelocity, bodies.angularVelocity, constraint.bodyB, constraint.offsetB) -
+                       pointVelocity(bodies.linearVelocity, bodies.angularVelocity, constraint.bodyA, constraint.offsetA);
+    lambda = -constraint.tangentMass2 * relativeVelocity.dotProduct(constraint.tangent2);
+    accumulated = std::clamp(constraint.tangentImpulse2 + lambda, -maxFriction, maxFriction);
+    lambda = accumulated - constraint.tangentImpulse2;
+    constraint.tangentImpulse2 = accumulated;
+    applyImpulse(bodies, constraint, constraint.tangent2 * lambda);
+
+    /* Normal, the accumulated impulse can only ever push */
+    relativeVelocity = pointVelocity(bodies.linearVelocity, bodies.angularVelocity, constraint.bodyB, constraint.offsetB) -
+                       pointVelocity(bodies.linearVelocity, bodies.angularVelocity, constraint.bodyA, constraint.offsetA);
+    lambda = constraint.normalMass * (constraint.velocityBias - relativeVelocity.dotProduct(constraint.normal));
+    accumulated = std::max(constraint.normalImpulse + lambda, 0.0f);
+    lambda = accumulated - constraint.normalImpulse;
+    constraint.normalImpulse = accumulated;
+    applyImpulse(bodies, constraint, constraint.normal * lambda);
+  });
+}
+
+void ContactSolver::solvePositions(BodyStore &bodies, float deltaTime) {
+  if (positionIterations == 0U) {
+    return;
+  }
+
+  /* Only the bodies touched by a contact have pseudo velocities, and they are all zero between steps */
+  if (pseudoLinearVelocity.size() < bodies.size()) {
+    pseudoLinearVelocity.resize(bodies.size());
+    pseudoAngularVelocity.resize(bodies.size());
+  }
+
+  for (uint32_t iteration = 0U; iteration < positionIterations; iteration++) {
+    forEachConstraint([this](ContactConstraint &constraint) {
+      Vector3D relativeVelocity = pointVelocity(pseudoLinearVelocity, pseudoAngularVelocity, constraint.bodyB, constraint.offsetB) -
+                                  pointVelocity(pseudoLinearVelocity, pseudoAngularVelocity, constraint.bodyA, constraint.offsetA);
+      float lambda = constraint.normalMass * (constraint.positionBias - relativeVelocity.dotProduct(constraint.normal));
+      float accumulated = std::max(constraint.pseudoImpulse + lambda, 0.0f);
+      lambda = accumulated - constraint.pseudoImpulse;
+      constraint.pseudoImpulse = accumulated;
+
+      Vector3D impulse = constraint.normal * lambda;
+      if (constraint.inverseMassA > 0.0f) {
+        pseudoLinearVelocity.set(constraint.bodyA, pseudoLinearVelocity.get(constraint.bodyA) - impulse * constraint.inverseMassA);
+        pseudoAngularVelocity.set(constraint.bodyA, pseudoAngularVelocity.get(constraint.bodyA) - constraint.inverseInertiaA * constraint.offsetA.crossProduct(impulse));
+      }
+      if (constraint.inverseMassB > 0.0f) {
+        pseudoLinearVelocity.set(constraint.bodyB, pseudoLinearVelocity.get(constraint.bodyB) + impulse * constraint.inverseMassB);
+        pseudoAngularVelocity.set(constraint.bodyB, pseudoAngularVelocity.get(constraint.bodyB) + constraint.inverseInertiaB * constraint.offsetB.crossProduct(impulse));
+      }
+    });
+  }
+
+  /* Move each touched body by its pseudo velocity once, then zero it so the next step starts clean */
+  for (const ContactConstraint &constraint : constraints) {
+    for (uint32_t body : {constraint.bodyA, constraint.bodyB}) {
+      if (body == BodyStore::INVALID_INDEX || bodies.inverseMass[body] <= 0.0f) {
+        continue;
+      }
+
+      Vector3D linear = pseudoLinearVelocity.get(body);
+      Vector3D angular = pseudoAngularVelocity.get(body);
+      if (linear.lengthSquared() == 0.0f && angular.lengthSquared() == 0.0f) {
+        continue;
+      }
+
+      bodies.position.set(body, bodies.position.get(body) + linear * deltaTime);
+
+      bodies.orientation.set(body, bodies.orientation.get(body).integrate(angular, deltaTime));
+
+      pseudoLinearVelocity.set(body, Vector3D(0, 0, 0));
+      pseudoAngularVelocity.set(body, Vector3D(0, 0, 0));
+    }
+  }
+}
+
+void ContactSolver::storeImpulses(const BodyStore &bodies) {
+  /* This step's pairs are kept, pairs that stopped touching are dropped */
+  nextImpulseCache.clear();
+  for (const ContactConstraint &constraint : constraints) {
+    CachedImpulse cached;
+    cached.cacheKey = constraint.cacheKey;
+    cached.bodyA = (constraint.bodyA != BodyStore::INVALID_INDEX) ? bodies.ids[constraint.bodyA] : BodyId();
+    cached.bodyB = (constraint.bodyB != BodyStore::INVALID_INDEX) ? bodies.ids[constraint.bodyB] : BodyId();
+    cached.normalImpulse = constraint.normalImpulse;
+    cached.tangentImpulse = constraint.tangent1 * constraint.tangentImpulse1 + constraint.tangent2 * constraint.tangentImpulse2;
+    nextImpulseCache.push_back(cached);
+  }
+
+  /* The narrowphase skips pairs with neither body awake and moving, so a sleeping island has no contacts. Its impulses are
+     carried over while both bodies still are that way, so the island warm starts where it left off when it wakes. Those pairs
+     weren't tested, so none of them is also in this step's constraints */
+  auto isResting = [&bodies](BodyId id) {
+    if (id == BodyId()) {
+      return true;
+    }
+    if (!bodies.isValid(id)) {
+      return false;
+    }
+    const uint32_t index = bodies.indexOf(id);
+    return !bodies.isAwake(index) || bodies.inverseMass[index] <= 0.0f;
+  };
+  for (const CachedImpulse &cached : impulseCache) {
+    if (isResting(cached.bodyA) && isResting(cached.bodyB)) {
+      nextImpulseCache.push_back(cached);
+    }
+  }
+
+  /* Every pair produces at most one contact, so the keys are unique */
+  std::sort(nextImpulseCache.begin(), nextImpulseCache.end(), [](const CachedImpulse &a, const CachedImpulse &b) { return a.cacheKey < b.cacheKey; });
+  impulseCache.swap(nextImpulseCache);
+}
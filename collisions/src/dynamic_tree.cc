@@ -0,0 +1,354 @@
+/*******************************************************************************************************************************
+ * @file   dynamic_tree.cc
+ *
+ * @brief  Source file for the dynamic AABB tree broadphase
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "dynamic_tree.h"
+
+DynamicTree::DynamicTree(float margin) {
+  this->margin = margin;
+}
+
+uint32_t DynamicTree::allocateNode() {
+  if (freeList == NULL_NODE) {
+    /* Grow the pool, the new node goes straight into use */
+    nodes.emplace_back();
+    freeList = static_cast<uint32_t>(nodes.size() - 1U);
+    nodes[freeList].parent = NULL_NODE;
+  }
+
+  uint32_t node = freeList;
+  freeList = nodes[node].parent;
+
+  nodes[node].parent = NULL_NODE;
+  nodes[node].child1 = NULL_NODE;
+  nodes[node].child2 = NULL_NODE;
+  nodes[node].height = 0;
+  nodes[node].moved = false;
+  nodes[node].alive = true;
+  return node;
+}
+
+void DynamicTree::freeNode(uint32_t node) {
+  nodes[node].parent = freeList;
+  nodes[node].height = -1;
+  nodes[node].alive = false;
+  freeList = node;
+}
+
+uint32_t DynamicTree::createProxy(const AABB &box, uint32_t userData) {
+  uint32_t leaf = allocateNode();
+  Vector3D fatMargin(margin, margin, margin);
+
+  nodes[leaf].tightBox = box;
+  nodes[leaf].box = AABB{box.min - fatMargin, box.max + fatMargin};
+  nodes[leaf].userData = userData;
+
+  insertLeaf(leaf);
+  markMoved(leaf);
+  return leaf;
+}
+
+void DynamicTree::destroyProxy(uint32_t proxyId) {
+  /* The leaf leaves the tree now, but the node is only recycled once its pairs are purged on the next update */
+  removeLeaf(proxyId);
+  nodes[proxyId].alive = false;
+  destroyedLeaves.push_back(proxyId);
+}
+
+void DynamicTree::moveProxy(uint32_t proxyId, const AABB &box) {
+  Node &leaf = nodes[proxyId];
+  leaf.tightBox = box;
+
+  if (leaf.box.contains(box)) {
+    return;
+  }
+
+  Vector3D fatMargin(margin, margin, margin);
+  removeLeaf(proxyId);
+  nodes[proxyId].box = AABB{box.min - fatMargin, box.max + fatMargin};
+  insertLeaf(proxyId);
+  markMoved(proxyId);
+}
+
+void DynamicTree::setUserData(uint32_t proxyId, uint32_t userData) {
+  nodes[proxyId].userData = userData;
+}
+
+void DynamicTree::markMoved(uint32_t leaf) {
+  if (!nodes[leaf].moved) {
+    nodes[leaf].moved = true;
+    movedLeaves.push_back(leaf);
+  }
+}
+
+void DynamicTree::insertLeaf(uint32_t leaf) {
+  if (root == NULL_NODE) {
+    root = leaf;
+    nodes[root].parent = NULL_NODE;
+    return;
+  }
+
+  /* Walk down picking the cheapest sibling by surface area heuristic */
+  const AABB leafBox = nodes[leaf].box;
+  uint32_t index = root;
+
+  while (nodes[index].height > 0) {
+    uint32_t child1 = nodes[index].child1;
+    uint32_t child2 = nodes[index].child2;
+
+    float area = nodes[index].box.surfaceArea();
+    float combinedArea = nodes[index].box.merge(leafBox).surfaceArea();
+
+    /* Cost of making a new parent for this node and the leaf */
+    float cost = 2.0f * combinedArea;
+
+    /* Minimum cost of pushing the leaf further down the tree */
+    float inheritanceCost = 2.0f * (combinedArea - area);
+
+    float cost1 = leafBox.merge(nodes[child1].box).surfaceArea() + inheritanceCost;
+    if (nodes[child1].height > 0) {
+      cost1 -= nodes[child1].box.surfaceArea();
+    }
+
+    float cost2 = leafBox.merge(nodes[child2].box).surfaceArea() + inheritanceCost;
+    if (nodes[child2].height > 0) {
+      cost2 -= nodes[child2].box.surfaceArea();
+    }
+
+    if (cost < cost1 && cost < cost2) {
+      break;
+    }
+
+    index = (cost1 < cost2) ? child1 : child2;
+  }
+
+  /* Create a new parent for the sibling and the leaf */
+  uint32_t sibling = index;
+  uint32_t oldParent = nodes[sibling].parent;
+  uint32_t newParent = allocateNode();
+
+  nodes[newParent].parent = oldParent;
+  nodes[newParent].box = leafBox.merge(nodes[sibling].box);
+  nodes[newParent].height = nodes[sibling].height + 1;
+  nodes[newParent].child1 = sibling;
+  nodes[newParent].child2 = leaf;
+  nodes[sibling].parent = newParent;
+  nodes[leaf].parent = newParent;
+
+  if (oldParent != NULL_NODE) {
+    if (nodes[oldParent].child1 == sibling) {
+      nodes[oldParent].child1 = newParent;
+    } else {
+      nodes[oldParent].child2 = newParent;
+    }
+  } else {
+    root = newParent;
+  }
+
+  refitAncestors(nodes[leaf].parent);
+}
+
+void DynamicTree::removeLeaf(uint32_t leaf) {
+  if (leaf == root) {
+    root = NULL_NODE;
+    return;
+  }
+
+  uint32_t parent = nodes[leaf].parent;
+  uint32_t grandParent = nodes[parent].parent;
+  uint32_t sibling = (nodes[parent].child1 == leaf) ? nodes[parent].child2 : nodes[parent].child1;
+
+  /* The sibling takes the place of the parent */
+  if (grandParent != NULL_NODE) {
+    if (nodes[grandParent].child1 == parent) {
+      nodes[grandParent].child1 = sibling;
+    } else {
+      nodes[grandParent].child2 = sibling;
+    }
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+    refitAncestors(grandParent);
+  } else {
+    root = sibling;
+    nodes[sibling].parent = NULL_NODE;
+    freeNode(parent);
+  }
+
+  nodes[leaf].parent = NULL_NODE;
+}
+
+void DynamicTree::refitAncestors(uint32_t node) {
+  /* Rebalance and refit bounds and heights up to the root */
+  while (node != NULL_NODE) {
+    node = balance(node);
+
+    uint32_t child1 = nodes[node].child1;
+    uint32_t child2 = nodes[node].child2;
+
+    nodes[node].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+    nodes[node].box = nodes[child1].box.merge(nodes[child2].box);
+
+    node = nodes[node].parent;
+  }
+}
+
+uint32_t DynamicTree::balance(uint32_t indexA) {
+  /* Rotates the taller child up if the children differ in height by more than one. Returns the new subtree root */
+  if (nodes[indexA].height < 2) {
+    return indexA;
+  }
+
+  uint32_t indexB = nodes[indexA].child1;
+  uint32_t indexC = nodes[indexA].child2;
+  int32_t heightDifference = nodes[indexC].height - nodes[indexB].height;
+
+  if (heightDifference > 1 || heightDifference < -1) {
+    /* Rotate the taller child (Up) above A, and hand its shorter grandchild down to A */
+    bool rotateC = heightDifference > 1;
+    uint32_t indexUp = rotateC ? indexC : indexB;
+    uint32_t indexOther = rotateC ? indexB : indexC;
+    uint32_t indexF = nodes[indexUp].child1;
+    uint32_t indexG = nodes[indexUp].child2;
+
+    /* Swap A and Up */
+    nodes[indexUp].child1 = indexA;
+    nodes[indexUp].parent = nodes[indexA].parent;
+    nodes[indexA].parent = indexUp;
+
+    uint32_t upParent = nodes[indexUp].parent;
+    if (upParent != NULL_NODE) {
+      if (nodes[upParent].child1 == indexA) {
+        nodes[upParent].child1 = indexUp;
+      } else {
+        nodes[upParent].child2 = indexUp;
+      }
+    } else {
+      root = indexUp;
+    }
+
+    /* The taller grandchild stays with Up */
+    uint32_t keep = (nodes[indexF].height > nodes[indexG].height) ? indexF : indexG;
+    uint32_t give = (keep == indexF) ? indexG : indexF;
+
+    nodes[indexUp].child2 = keep;
+    if (rotateC) {
+      nodes[indexA].child2 = give;
+    } else {
+      nodes[indexA].child1 = give;
+    }
+    nodes[give].parent = indexA;
+
+    nodes[indexA].box = nodes[indexOther].box.merge(nodes[give].box);
+    nodes[indexA].height = 1 + std::max(nodes[indexOther].height, nodes[give].height);
+    nodes[indexUp].box = nodes[indexA].box.merge(nodes[keep].box);
+    nodes[indexUp].height = 1 + std::max(nodes[indexA].height, nodes[keep].height);
+
+    return indexUp;
+  }
+
+  return indexA;
+}
+
+void DynamicTree::addPair(uint32_t leafA, uint32_t leafB) {
+  uint64_t key = (leafA < leafB) ? ((static_cast<uint64_t>(leafA) << 32U) | leafB) : ((static_cast<uint64_t>(leafB) << 32U) | leafA);
+
+  if (pairLookup.insert(key, static_cast<uint32_t>(pairKeys.size()))) {
+    pairKeys.push_back(key);
+  }
+}
+
+void DynamicTree::removePairAt(size_t index) {
+  uint64_t key = pairKeys[index];
+  uint64_t lastKey = pairKeys.back();
+
+  pairKeys[index] = lastKey;
+  *pairLookup.find(lastKey) = static_cast<uint32_t>(index);
+  pairKeys.pop_back();
+  pairLookup.erase(key);
+}
+
+void DynamicTree::updatePairs() {
+  /* Drop pairs that lost a leaf, or whose fat boxes separated after a reinsert. Walking backwards keeps swap removal valid */
+  if (!movedLeaves.empty() || !destroyedLeaves.empty()) {
+    for (size_t i = pairKeys.size(); i-- > 0U;) {
+      const Node &leafA = nodes[static_cast<uint32_t>(pairKeys[i] >> 32U)];
+      const Node &leafB = nodes[static_cast<uint32_t>(pairKeys[i] & 0xFFFFFFFFU)];
+
+      if (!leafA.alive || !leafB.alive || ((leafA.moved || leafB.moved) && !leafA.box.overlaps(leafB.box))) {
+        removePairAt(i);
+      }
+    }
+  }
+
+  /* Only reinserted leaves can have gained pairs. The queries don't touch the tree so they can run in parallel, the cache is
+     then updated serially in the same order */
+  candidatePairs.clear();
+  collectPairs(static_cast<uint32_t>(movedLeaves.size()), candidatePairs, [this](uint32_t begin, uint32_t end, FrameVector<BroadphasePair> &output) {
+    for (uint32_t i = begin; i < end; i++) {
+      uint32_t leaf = movedLeaves[i];
+      if (!nodes[leaf].alive) {
+        continue;
+      }
+
+      queryLeaves(nodes[leaf].box, [leaf, &output](uint32_t other) {
+        if (other != leaf) {
+          output.push_back(BroadphasePair{leaf, other});
+        }
+      });
+    }
+  });
+
+  for (const BroadphasePair &candidate : candidatePairs) {
+    addPair(candidate.a, candidate.b);
+  }
+
+  for (uint32_t leaf : movedLeaves) {
+    nodes[leaf].moved = false;
+  }
+  movedLeaves.clear();
+
+  for (uint32_t leaf : destroyedLeaves) {
+    freeNode(leaf);
+  }
+  destroyedLeaves.clear();
+
+  /* The cache holds fat box pairs, only report the ones whose real bounds overlap */
+  pairs.clear();
+  for (uint64_t key : pairKeys) {
+    const Node &leafA = nodes[static_cast<uint32_t>(key >> 32U)];
+    const Node &leafB = nodes[static_cast<uint32_t>(key & 0xFFFFFFFFU)];
+
+    if (leafA.tightBox.overlaps(leafB.tightBox)) {
+      uint32_t userA = leafA.userData;
+      uint32_t userB = leafB.userData;
+      pairs.push_back((userA < userB) ? BroadphasePair{userA, userB} : BroadphasePair{userB, userA});
+    }
+  }
+}
+
+const std::vector<BroadphasePair> &DynamicTree::getPairs() const {
+  return pairs;
+}
+
+void DynamicTree::query(const AABB &box, std::vector<uint32_t> &results) const {
+  queryLeaves(box, [this, &box, &results](uint32_t leaf) {
+    if (nodes[leaf].tightBox.overlaps(box)) {
+      results.push_back(nodes[leaf].userData);
+    }
+  });
+}
+
+int32_t DynamicTree::getHeight() const {
+  return (root == NULL_NODE) ? 0 : nodes[root].height;
+}
@@ -0,0 +1,117 @@
+/*******************************************************************************************************************************
+ * @file   pair_map.cc
+ *
+ * @brief  Source file for a flat hash map from proxy pair keys to indices
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <bit>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "pair_map.h"
+
+size_t PairMap::home(uint64_t key) const {
+  /* Fibonacci hashing, the multiply spreads the two proxy IDs over the top bits */
+  return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> shift);
+}
+
+size_t PairMap::findSlot(uint64_t key) const {
+  const size_t mask = keys.size() - 1U;
+  size_t slot = home(key);
+
+  while (keys[slot] != key && keys[slot] != EMPTY_KEY) {
+    slot = (slot + 1U) & mask;
+  }
+  return slot;
+}
+
+uint32_t *PairMap::find(uint64_t key) {
+  return const_cast<uint32_t *>(static_cast<const PairMap *>(this)->find(key));
+}
+
+const uint32_t *PairMap::find(uint64_t key) const {
+  if (count == 0U) {
+    return nullptr;
+  }
+
+  size_t slot = findSlot(key);
+  return (keys[slot] == key) ? &values[slot] : nullptr;
+}
+
+bool PairMap::insert(uint64_t key, uint32_t value) {
+  /* Kept at most half full, so probe runs stay short */
+  if ((count + 1U) * 2U > keys.size()) {
+    grow();
+  }
+
+  size_t slot = findSlot(key);
+  if (keys[slot] == key) {
+    return false;
+  }
+
+  keys[slot] = key;
+  values[slot] = value;
+  count++;
+  return true;
+}
+
+bool PairMap::erase(uint64_t key) {
+  if (count == 0U) {
+    return false;
+  }
+
+  size_t hole = findSlot(key);
+  if (keys[hole] != key) {
+    return false;
+  }
+
+  /* Shift back every following entry of the run whose home isn't between the hole and itself, so lookups never need tombstones */
+  const size_t mask = keys.size() - 1U;
+  for (size_t slot = (hole + 1U) & mask; keys[slot] != EMPTY_KEY; slot = (slot + 1U) & mask) {
+    size_t distance = (slot - home(keys[slot])) & mask;
+    if (distance >= ((slot - hole) & mask)) {
+      keys[hole] = keys[slot];
+      values[hole] = values[slot];
+      hole = slot;
+    }
+  }
+
+  keys[hole] = EMPTY_KEY;
+  count--;
+  return true;
+}
+
+void PairMap::clear() {
+  if (count > 0U) {
+    keys.assign(keys.size(), EMPTY_KEY);
+    count = 0U;
+  }
+}
+
+size_t PairMap::size() const {
+  return count;
+}
+
+void PairMap::grow() {
+  std::vector<uint64_t> oldKeys;
+  std::vector<uint32_t> oldValues;
+  oldKeys.swap(keys);
+  oldValues.swap(values);
+
+  const size_t capacity = oldKeys.empty() ? MIN_CAPACITY : oldKeys.size() * 2U;
+  keys.assign(capacity, EMPTY_KEY);
+  values.resize(capacity);
+  shift = 64U - static_cast<uint32_t>(std::countr_zero(capacity));
+  count = 0U;
+
+  for (size_t slot = 0U; slot < oldKeys.size(); slot++) {
+    if (oldKeys[slot] != EMPTY_KEY) {
+      insert(oldKeys[slot], oldValues[slot]);
+    }
+  }
+}
@@ -0,0 +1,222 @@
+/*******************************************************************************************************************************
+ * @file   spatial_hash_grid.cc
+ *
+ * @brief  Source file for the spatial hash grid broadphase
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <cmath>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "spatial_hash_grid.h"
+
+uint32_t SpatialHashGrid::hashCell(int32_t x, int32_t y, int32_t z, uint32_t mask) {
+  /* Large primes from Teschner et al. "Optimized Spatial Hashing for Collision Detection of Deformable Objects" */
+  return ((static_cast<uint32_t>(x) * 73856093U) ^ (static_cast<uint32_t>(y) * 19349663U) ^ (static_cast<uint32_t>(z) * 83492791U)) & mask;
+}
+
+uint32_t SpatialHashGrid::createProxy(const AABB &box, uint32_t userData) {
+  uint32_t proxyId;
+
+  if (!freeProxies.empty()) {
+    proxyId = freeProxies.back();
+    freeProxies.pop_back();
+  } else {
+    proxyId = static_cast<uint32_t>(proxies.size());
+    proxies.emplace_back();
+  }
+
+  proxies[proxyId] = Proxy{box, userData, true};
+  return proxyId;
+}
+
+void SpatialHashGrid::destroyProxy(uint32_t proxyId) {
+  proxies[proxyId].alive = false;
+  freeProxies.push_back(proxyId);
+}
+
+void SpatialHashGrid::moveProxy(uint32_t proxyId, const AABB &box) {
+  proxies[proxyId].box = box;
+}
+
+void SpatialHashGrid::setUserData(uint32_t proxyId, uint32_t userData) {
+  proxies[proxyId].userData = userData;
+}
+
+float SpatialHashGrid::getCellSize() const {
+  return cellSize;
+}
+
+void SpatialHashGrid::chooseCellSize() {
+  /* Median radius, so a handful of huge bodies can't blow up the cell size */
+  radiusScratch.assign(entryRadii.begin(), entryRadii.end());
+  auto middle = radiusScratch.begin() + (radiusScratch.size() / 2U);
+  std::nth_element(radiusScratch.begin(), middle, radiusScratch.end());
+  float oversizedRadius = *middle * OVERSIZED_FACTOR;
+
+  /* Every regular entry has to fit in a single cell for the 27 cell search to find all pairs */
+  float largestRegular = 0.0f;
+  for (float radius : entryRadii) {
+    if (radius <= oversizedRadius) {
+      largestRegular = std::max(largestRegular, radius);
+    }
+  }
+
+  cellSize = std::max(2.0f * largestRegular, MIN_CELL_SIZE);
+}
+
+void SpatialHashGrid::binEntries() {
+  const size_t entryCount = entryProxies.size();
+  const float inverseCellSize = 1.0f / cellSize;
+  const float maxRadius = cellSize * 0.5f;
+
+  /* Power of two table with roughly two buckets per entry keeps hash collisions low */
+  uint32_t tableSize = 16U;
+  while (tableSize < entryCount * 2U) {
+    tableSize <<= 1U;
+  }
+  const uint32_t mask = tableSize - 1U;
+
+  bucketStart.assign(tableSize + 1U, 0U);
+  entryCells.resize(entryCount * 3U);
+  entryBuckets.resize(entryCount);
+  sortedEntries.resize(entryCount);
+  oversizedEntries.clear();
+
+  /* Counting pass */
+  for (size_t entry = 0U; entry < entryCount; entry++) {
+    if (entryRadii[entry] > maxRadius) {
+      entryBuckets[entry] = NOT_BINNED;
+      oversizedEntries.push_back(static_cast<uint32_t>(entry));
+      continue;
+    }
+
+    const AABB &box = proxies[entryProxies[entry]].box;
+    int32_t *cell = &entryCells[entry * 3U];
+    cell[0] = static_cast<int32_t>(std::floor((box.min.x + box.max.x) * 0.5f * inverseCellSize));
+    cell[1] = static_cast<int32_t>(std::floor((box.min.y + box.max.y) * 0.5f * inverseCellSize));
+    cell[2] = static_cast<int32_t>(std::floor((box.min.z + box.max.z) * 0.5f * inverseCellSize));
+
+    uint32_t bucket = hashCell(cell[0], cell[1], cell[2], mask);
+    entryBuckets[entry] = bucket;
+    bucketStart[bucket]++;
+  }
+
+  /* Inclusive prefix sum, each bucket now holds its end offset */
+  for (uint32_t bucket = 1U; bucket < tableSize; bucket++) {
+    bucketStart[bucket] += bucketStart[bucket - 1U];
+  }
+  bucketStart[tableSize] = bucketStart[tableSize - 1U];
+
+  /* Scatter backwards, which walks every offset down to its bucket start and keeps entries ascending within a bucket */
+  for (size_t entry = entryCount; entry-- > 0U;) {
+    uint32_t bucket = entryBuckets[entry];
+    if (bucket != NOT_BINNED) {
+      sortedEntries[--bucketStart[bucket]] = static_cast<uint32_t>(entry);
+    }
+  }
+}
+
+BroadphasePair SpatialHashGrid::makePair(uint32_t entryA, uint32_t entryB) const {
+  uint32_t userA = proxies[entryProxies[entryA]].userData;
+  uint32_t userB = proxies[entryProxies[entryB]].userData;
+  return (userA < userB) ? BroadphasePair{userA, userB} : BroadphasePair{userB, userA};
+}
+
+void SpatialHashGrid::findGridPairs(uint32_t begin, uint32_t end, FrameVector<BroadphasePair> &output) const {
+  const uint32_t mask = static_cast<uint32_t>(bucketStart.size() - 2U);
+
+  for (uint32_t entry = begin; entry < end; entry++) {
+    if (entryBuckets[entry] == NOT_BINNED) {
+      continue;
+    }
+
+    /* Gather the distinct buckets of the 27 neighbouring cells, hash collisions can map two cells to the same bucket */
+    const int32_t *cell = &entryCells[entry * 3U];
+    uint32_t neighbourBuckets[27];
+    unsigned int neighbourCount = 0U;
+
+    for (int32_t dx = -1; dx <= 1; dx++) {
+      for (int32_t dy = -1; dy <= 1; dy++) {
+        for (int32_t dz = -1; dz <= 1; dz++) {
+          uint32_t bucket = hashCell(cell[0] + dx, cell[1] + dy, cell[2] + dz, mask);
+          if (std::find(neighbourBuckets, neighbourBuckets + neighbourCount, bucket) == neighbourBuckets + neighbourCount) {
+            neighbourBuckets[neighbourCount++] = bucket;
+          }
+        }
+      }
+    }
+
+    /* Only look at higher entries so every pair is reported once */
+    const AABB &box = proxies[entryProxies[entry]].box;
+    for (unsigned int n = 0U; n < neighbourCount; n++) {
+      uint32_t bucket = neighbourBuckets[n];
+      for (uint32_t slot = bucketStart[bucket]; slot < bucketStart[bucket + 1U]; slot++) {
+        uint32_t other = sortedEntries[slot];
+        if (other > entry && box.overlaps(proxies[entryProxies[other]].box)) {
+          output.push_back(makePair(entry, other));
+        }
+      }
+    }
+  }
+}
+
+void SpatialHashGrid::updatePairs() {
+  pairs.clear();
+  entryProxies.clear();
+  entryRadii.clear();
+
+  for (size_t proxyId = 0U; proxyId < proxies.size(); proxyId++) {
+    const Proxy &proxy = proxies[proxyId];
+    if (!proxy.alive) {
+      continue;
+    }
+
+    Vector3D halfExtent = (proxy.box.max - proxy.box.min) * 0.5f;
+    entryProxies.push_back(static_cast<uint32_t>(proxyId));
+    entryRadii.push_back(std::max(halfExtent.x, std::max(halfExtent.y, halfExtent.z)));
+  }
+
+  if (entryProxies.size() < 2U) {
+    return;
+  }
+
+  chooseCellSize();
+  binEntries();
+
+  const uint32_t entryCount = static_cast<uint32_t>(entryProxies.size());
+  collectPairs(entryCount, pairs, [this](uint32_t begin, uint32_t end, FrameVector<BroadphasePair> &output) { findGridPairs(begin, end, output); });
+
+  /* Oversized entries aren't in the grid, test them against everything */
+  for (uint32_t oversized : oversizedEntries) {
+    const AABB &box = proxies[entryProxies[oversized]].box;
+
+    for (uint32_t other = 0U; other < entryCount; other++) {
+      if (other == oversized || (entryBuckets[other] == NOT_BINNED && other < oversized)) {
+        continue;
+      }
+
+      if (box.overlaps(proxies[entryProxies[other]].box)) {
+        pairs.push_back(makePair(oversized, other));
+      }
+    }
+  }
+}
+
+const std::vector<BroadphasePair> &SpatialHashGrid::getPairs() const {
+  return pairs;
+}
+
+void SpatialHashGrid::query(const AABB &box, std::vector<uint32_t> &results) const {
+  for (const Proxy &proxy : proxies) {
+    if (proxy.alive && proxy.box.overlaps(box)) {
+      results.push_back(proxy.userData);
+    }
+  }
+}
@@ -0,0 +1,352 @@
+/*******************************************************************************************************************************
+ * @file   sweep_and_prune.cc
+ *
+ * @brief  Source file for the incremental sweep and prune broadphase
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "sweep_and_prune.h"
+
+static float axisValue(const Vector3D &vector, unsigned int axis) {
+  return (axis == 0U) ? vector.x : ((axis == 1U) ? vector.y : vector.z);
+}
+
+uint64_t SweepAndPrune::makeKey(uint32_t proxyA, uint32_t proxyB) {
+  if (proxyA > proxyB) {
+    std::swap(proxyA, proxyB);
+  }
+  return (static_cast<uint64_t>(proxyA) << 32U) | proxyB;
+}
+
+bool SweepAndPrune::endpointLess(const Endpoint &a, const Endpoint &b) {
+  /* Min endpoints sort before max endpoints at the same value so touching boxes count as overlapping, as in AABB::overlaps(). The
+     incremental sort has to break ties the same way as the rebuild, or whether touching boxes pair up depends on their history */
+  if (a.value != b.value) {
+    return a.value < b.value;
+  }
+  return (a.data & MAX_ENDPOINT_FLAG) < (b.data & MAX_ENDPOINT_FLAG);
+}
+
+BroadphasePair SweepAndPrune::keyToPair(uint64_t key) const {
+  uint32_t userA = proxies[static_cast<uint32_t>(key >> 32U)].userData;
+  uint32_t userB = proxies[static_cast<uint32_t>(key & 0xFFFFFFFFU)].userData;
+
+  return (userA < userB) ? BroadphasePair{userA, userB} : BroadphasePair{userB, userA};
+}
+
+uint32_t SweepAndPrune::createProxy(const AABB &box, uint32_t userData) {
+  uint32_t proxyId;
+
+  if (!freeProxies.empty()) {
+    proxyId = freeProxies.back();
+    freeProxies.pop_back();
+  } else {
+    proxyId = static_cast<uint32_t>(proxies.size());
+    proxies.emplace_back();
+  }
+
+  Proxy &proxy = proxies[proxyId];
+  proxy.box = box;
+  proxy.userData = userData;
+  proxy.alive = true;
+
+  /* New endpoints go on the end of each list, the next update sorts them into place */
+  for (unsigned int axis = 0U; axis < AXIS_COUNT; axis++) {
+    proxy.minIndex[axis] = static_cast<uint32_t>(endpoints[axis].size());
+    endpoints[axis].push_back({axisValue(box.min, axis), proxyId});
+
+    proxy.maxIndex[axis] = static_cast<uint32_t>(endpoints[axis].size());
+    endpoints[axis].push_back({axisValue(box.max, axis), proxyId | MAX_ENDPOINT_FLAG});
+  }
+
+  pendingInserts++;
+  return proxyId;
+}
+
+void SweepAndPrune::destroyProxy(uint32_t proxyId) {
+  /* Endpoints and pairs are purged in bulk on the next update, so destroying many proxies stays linear */
+  proxies[proxyId].alive = false;
+  destroyedProxies.push_back(proxyId);
+}
+
+void SweepAndPrune::moveProxy(uint32_t proxyId, const AABB &box) {
+  Proxy &proxy = proxies[proxyId];
+  proxy.box = box;
+
+  for (unsigned int axis = 0U; axis < AXIS_COUNT; axis++) {
+    endpoints[axis][proxy.minIndex[axis]].value = axisValue(box.min, axis);
+    endpoints[axis][proxy.maxIndex[axis]].value = axisValue(box.max, axis);
+  }
+}
+
+void SweepAndPrune::setUserData(uint32_t proxyId, uint32_t userData) {
+  proxies[proxyId].userData = userData;
+}
+
+SweepAndPrune::TouchedPair &SweepAndPrune::touchPair(uint64_t key, bool existed) {
+  /* Only the first touch records the state from before this update */
+  if (touchedLookup.insert(key, static_cast<uint32_t>(touchedPairs.size()))) {
+    touchedPairs.push_back(TouchedPair{key, existed, BroadphasePair{}});
+    return touchedPairs.back();
+  }
+  return touchedPairs[*touchedLookup.find(key)];
+}
+
+void SweepAndPrune::addPair(uint32_t proxyA, uint32_t proxyB) {
+  uint64_t key = makeKey(proxyA, proxyB);
+
+  if (!pairLookup.insert(key, static_cast<uint32_t>(pairKeys.size()))) {
+    return;
+  }
+
+  touchPair(key, false);
+  pairKeys.push_back(key);
+}
+
+void SweepAndPrune::removePair(uint32_t proxyA, uint32_t proxyB) {
+  uint64_t key = makeKey(proxyA, proxyB);
+  const uint32_t *found = pairLookup.find(key);
+
+  if (found == nullptr) {
+    return;
+  }
+
+  /* Named at removal rather than at publishing, so later changes to the proxies' user data or slots don't rename it */
+  touchPair(key, true).removed = keyToPair(key);
+
+  /* Swap remove to keep the pair list dense */
+  uint32_t index = *found;
+  uint64_t lastKey = pairKeys.back();
+  pairKeys[index] = lastKey;
+  *pairLookup.find(lastKey) = index;
+  pairKeys.pop_back();
+  pairLookup.erase(key);
+}
+
+void SweepAndPrune::purgeDestroyedProxies() {
+  if (destroyedProxies.empty()) {
+    return;
+  }
+
+  /* Drop every pair that references a destroyed proxy. Walking backwards keeps swap removal valid */
+  for (size_t i = pairKeys.size(); i-- > 0U;) {
+    uint64_t key = pairKeys[i];
+    uint32_t proxyA = static_cast<uint32_t>(key >> 32U);
+    uint32_t proxyB = static_cast<uint32_t>(key & 0xFFFFFFFFU);
+
+    if (!proxies[proxyA].alive || !proxies[proxyB].alive) {
+      removePair(proxyA, proxyB);
+    }
+  }
+
+  /* Compact the endpoint lists, this keeps them sorted */
+  for (unsigned int axis = 0U; axis < AXIS_COUNT; axis++) {
+    std::vector<Endpoint> &list = endpoints[axis];
+    size_t writeIndex = 0U;
+
+    for (size_t readIndex = 0U; readIndex < list.size(); readIndex++) {
+      const Endpoint endpoint = list[readIndex];
+      uint32_t proxyId = endpoint.data & ~MAX_ENDPOINT_FLAG;
+
+      if (!proxies[proxyId].alive) {
+        continue;
+      }
+
+      if (endpoint.data & MAX_ENDPOINT_FLAG) {
+        proxies[proxyId].maxIndex[axis] = static_cast<uint32_t>(writeIndex);
+      } else {
+        proxies[proxyId].minIndex[axis] = static_cast<uint32_t>(writeIndex);
+      }
+      list[writeIndex++] = endpoint;
+    }
+
+    list.resize(writeIndex);
+  }
+
+  freeProxies.insert(freeProxies.end(), destroyedProxies.begin(), destroyedProxies.end());
+  destroyedProxies.clear();
+}
+
+void SweepAndPrune::sortAxisIncremental(unsigned int axis) {
+  std::vector<Endpoint> &list = endpoints[axis];
+
+  for (size_t i = 1U; i < list.size(); i++) {
+    const Endpoint key = list[i];
+
+    if (!endpointLess(key, list[i - 1U])) {
+      continue;
+    }
+
+    uint32_t keyProxy = key.data & ~MAX_ENDPOINT_FLAG;
+    bool keyIsMax = (key.data & MAX_ENDPOINT_FLAG) != 0U;
+    size_t j = i;
+
+    while (j > 0U && endpointLess(key, list[j - 1U])) {
+      const Endpoint previous = list[j - 1U];
+      uint32_t previousProxy = previous.data & ~MAX_ENDPOINT_FLAG;
+      bool previousIsMax = (previous.data & MAX_ENDPOINT_FLAG) != 0U;
+
+      if (keyProxy != previousProxy) {
+        if (!keyIsMax && previousIsMax) {
+          /* A min passed a max, the boxes may have started overlapping */
+          if (proxies[keyProxy].box.overlaps(proxies[previousProxy].box)) {
+            addPair(keyProxy, previousProxy);
+          }
+        } else if (keyIsMax && !previousIsMax) {
+          /* A max passed a min, the boxes are now separated on this axis */
+          removePair(keyProxy, previousProxy);
+        }
+      }
+
+      list[j] = previous;
+      if (previousIsMax) {
+        proxies[previousProxy].maxIndex[axis] = static_cast<uint32_t>(j);
+      } else {
+        proxies[previousProxy].minIndex[axis] = static_cast<uint32_t>(j);
+      }
+      j--;
+    }
+
+    list[j] = key;
+    if (keyIsMax) {
+      proxies[keyProxy].maxIndex[axis] = static_cast<uint32_t>(j);
+    } else {
+      proxies[keyProxy].minIndex[axis] = static_cast<uint32_t>(j);
+    }
+  }
+}
+
+void SweepAndPrune::rebuild() {
+  for (unsigned int axis = 0U; axis < AXIS_COUNT; axis++) {
+    std::vector<Endpoint> &list = endpoints[axis];
+    std::sort(list.begin(), list.end(), endpointLess);
+
+    for (size_t i = 0U; i < list.size(); i++) {
+      uint32_t proxyId = list[i].data & ~MAX_ENDPOINT_FLAG;
+      if (list[i].data & MAX_ENDPOINT_FLAG) {
+        proxies[proxyId].maxIndex[axis] = static_cast<uint32_t>(i);
+      } else {
+        proxies[proxyId].minIndex[axis] = static_cast<uint32_t>(i);
+      }
+    }
+  }
+
+  /* Sweep the X axis, keeping a set of open intervals */
+  std::vector<uint64_t> newKeys;
+  std::vector<uint32_t> active;
+  std::vector<uint32_t> activeSlot(proxies.size());
+
+  for (const Endpoint &endpoint : endpoints[0]) {
+    uint32_t proxyId = endpoint.data & ~MAX_ENDPOINT_FLAG;
+
+    if (endpoint.data & MAX_ENDPOINT_FLAG) {
+      uint32_t slot = activeSlot[proxyId];
+      uint32_t last = active.back();
+      active[slot] = last;
+      activeSlot[last] = slot;
+      active.pop_back();
+    } else {
+      for (uint32_t other : active) {
+        if (proxies[proxyId].box.overlaps(proxies[other].box)) {
+          newKeys.push_back(makeKey(proxyId, other));
+        }
+      }
+      activeSlot[proxyId] = static_cast<uint32_t>(active.size());
+      active.push_back(proxyId);
+    }
+  }
+
+  /* Diff against the existing pairs so the deltas stay accurate */
+  std::vector<uint8_t> keep(pairKeys.size(), 0U);
+  std::vector<uint64_t> newOnly;
+
+  for (uint64_t key : newKeys) {
+    const uint32_t *found = pairLookup.find(key);
+    if (found != nullptr) {
+      keep[*found] = 1U;
+    } else {
+      newOnly.push_back(key);
+    }
+  }
+
+  for (size_t i = pairKeys.size(); i-- > 0U;) {
+    if (!keep[i]) {
+      uint64_t key = pairKeys[i];
+      removePair(static_cast<uint32_t>(key >> 32U), static_cast<uint32_t>(key & 0xFFFFFFFFU));
+    }
+  }
+
+  for (uint64_t key : newOnly) {
+    addPair(static_cast<uint32_t>(key >> 32U), static_cast<uint32_t>(key & 0xFFFFFFFFU));
+  }
+}
+
+void SweepAndPrune::publishPairs() {
+  pairs.clear();
+  for (uint64_t key : pairKeys) {
+    pairs.push_back(keyToPair(key));
+  }
+
+  /* A pair can be removed and re-added in the same update, so compare against the state from before it */
+  for (const TouchedPair &touched : touchedPairs) {
+    bool exists = pairLookup.find(touched.key) != nullptr;
+
+    if (!touched.existed && exists) {
+      addedPairs.push_back(keyToPair(touched.key));
+    } else if (touched.existed && !exists) {
+      removedPairs.push_back(touched.removed);
+    }
+  }
+}
+
+void SweepAndPrune::updatePairs() {
+  addedPairs.clear();
+  removedPairs.clear();
+
+  /* Erasing the last update's keys costs what that update touched, clearing the whole table would cost its largest burst */
+  for (const TouchedPair &touched : touchedPairs) {
+    touchedLookup.erase(touched.key);
+  }
+  touchedPairs.clear();
+
+  purgeDestroyedProxies();
+
+  if (pendingInserts > INCREMENTAL_INSERT_LIMIT) {
+    rebuild();
+  } else {
+    for (unsigned int axis = 0U; axis < AXIS_COUNT; axis++) {
+      sortAxisIncremental(axis);
+    }
+  }
+  pendingInserts = 0U;
+
+  publishPairs();
+}
+
+const std::vector<BroadphasePair> &SweepAndPrune::getPairs() const {
+  return pairs;
+}
+
+void SweepAndPrune::query(const AABB &box, std::vector<uint32_t> &results) const {
+  for (const Proxy &proxy : proxies) {
+    if (proxy.alive && proxy.box.overlaps(box)) {
+      results.push_back(proxy.userData);
+    }
+  }
+}
+
+const std::vector<BroadphasePair> &SweepAndPrune::getAddedPairs() const {
+  return addedPairs;
+}
+
+const std::vector<BroadphasePair> &SweepAndPrune::getRemovedPairs() const {
+  return removedPairs;
+}
@@ -0,0 +1,296 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   aligned_array.h
+ *
+ * @brief  Header file for cache line aligned arrays
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "memory_manager.h"
+#include "quaternion.h"
+#include "vector_3d.h"
+
+/**
+ * @defgroup CoreModules
+ * @brief    Core modules to run on the CPU for physics management
+ * @{
+ */
+
+/**
+ * @brief   Growable array whose storage starts on a cache line boundary
+ * @details Only meant for plain data (Trivially copyable types), growth is a single memcpy. Storage comes from the
+ *          MemoryManager, so large columns follow its mapping and huge page options
+ */
+template <typename T>
+class AlignedArray {
+  static_assert(std::is_trivially_copyable<T>::value, "AlignedArray only holds trivially copyable types");
+
+ public:
+  using value_type = T;
+
+  static constexpr size_t ALIGNMENT = 64U;
+
+  AlignedArray() = default;
+
+  AlignedArray(const AlignedArray &other) {
+    *this = other;
+  }
+
+  AlignedArray(AlignedArray &&other) noexcept {
+    swap(other);
+  }
+
+  AlignedArray &operator=(const AlignedArray &other) {
+    if (this != &other) {
+      count = 0U;
+      reserve(other.count);
+      if (other.count > 0U) {
+        std::memcpy(elements, other.elements, other.count * sizeof(T));
+      }
+      count = other.count;
+    }
+    return *this;
+  }
+
+  AlignedArray &operator=(AlignedArray &&other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~AlignedArray() {
+    MemoryManager::getInstance().deallocate(elements);
+  }
+
+  T &operator[](size_t index) {
+    return elements[index];
+  }
+
+  const T &operator[](size_t index) const {
+    return elements[index];
+  }
+
+  T *data() {
+    return elements;
+  }
+
+  const T *data() const {
+    return elements;
+  }
+
+  size_t size() const {
+    return count;
+  }
+
+  size_t capacity() const {
+    return allocated;
+  }
+
+  bool empty() const {
+    return count == 0U;
+  }
+
+  T &back() {
+    return elements[count - 1U];
+  }
+
+  void reserve(size_t newCapacity) {
+    if (newCapacity <= allocated) {
+      return;
+    }
+
+    /* Pool blocks of 64 bytes and up, and large allocations, all start on a cache line, so rounding the size up is enough */
+    size_t bytes = ((newCapacity * sizeof(T)) + ALIGNMENT - 1U) & ~(ALIGNMENT - 1U);
+    MemoryManager &memory = MemoryManager::getInstance();
+    T *newElements = static_cast<T *>(memory.allocate(bytes));
+
+    if (count > 0U) {
+      std::memcpy(newElements, elements, count * sizeof(T));
+    }
+    memory.deallocate(elements);
+
+    elements = newElements;
+    allocated = memory.getBlockSize(newElements) / sizeof(T);
+  }
+
+  void resize(size_t newSize, const T &value = T()) {
+    reserve(newSize);
+    for (size_t i = count; i < newSize; i++) {
+      new (&elements[i]) T(value);
+    }
+    count = newSize;
+  }
+
+  /**
+   * @brief   Replace the contents with a copy of count elements, one memcpy
+   */
+  void assign(const T *values, size_t newSize) {
+    count = 0U;
+    reserve(newSize);
+    if (newSize > 0U) {
+      std::memcpy(elements, values, newSize * sizeof(T));
+    }
+    count = newSize;
+  }
+
+  void push_back(const T &value) {
+    if (count == allocated) {
+      reserve((allocated == 0U) ? 16U : allocated * 2U);
+    }
+    new (&elements[count++]) T(value);
+  }
+
+  void pop_back() {
+    count--;
+  }
+
+  void clear() {
+    count = 0U;
+  }
+
+  /**
+   * @brief   Move the last element into index and shrink by one. O(1), but does not keep the order
+   */
+  void swapRemove(size_t index) {
+    elements[index] = elements[count - 1U];
+    count--;
+  }
+
+  void swap(AlignedArray &other) noexcept {
+    std::swap(elements, other.elements);
+    std::swap(count, other.count);
+    std::swap(allocated, other.allocated);
+  }
+
+ private:
+  T *elements{nullptr};
+  size_t count{0U};
+  size_t allocated{0U};
+};
+
+/**
+ * @brief   Structure of arrays storage for vectors, one aligned array per component
+ */
+struct Vector3DArray {
+  AlignedArray<float> x;
+  AlignedArray<float> y;
+  AlignedArray<float> z;
+
+  Vector3D get(size_t index) const {
+    return Vector3D(x[index], y[index], z[index]);
+  }
+
+  void set(size_t index, const Vector3D &vector) {
+    x[index] = vector.x;
+    y[index] = vector.y;
+    z[index] = vector.z;
+  }
+
+  size_t size() const {
+    return x.size();
+  }
+
+  void reserve(size_t capacity) {
+    x.reserve(capacity);
+    y.reserve(capacity);
+    z.reserve(capacity);
+  }
+
+  void resize(size_t newSize, const Vector3D &value = Vector3D()) {
+    x.resize(newSize, value.x);
+    y.resize(newSize, value.y);
+    z.resize(newSize, value.z);
+  }
+
+  void push_back(const Vector3D &vector) {
+    x.push_back(vector.x);
+    y.push_back(vector.y);
+    z.push_back(vector.z);
+  }
+
+  void clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+  }
+
+  void swapRemove(size_t index) {
+    x.swapRemove(index);
+    y.swapRemove(index);
+    z.swapRemove(index);
+  }
+};
+
+/**
+ * @brief   Structure of arrays storage for quaternions, one aligned array per component
+ */
+struct QuaternionArray {
+  AlignedArray<float> w;
+  AlignedArray<float> x;
+  AlignedArray<float> y;
+  AlignedArray<float> z;
+
+  Quaternion get(size_t index) const {
+    return Quaternion(w[index], x[index], y[index], z[index]);
+  }
+
+  void set(size_t index, const Quaternion &quaternion) {
+    w[index] = quaternion.w;
+    x[index] = quaternion.x;
+    y[index] = quaternion.y;
+    z[index] = quaternion.z;
+  }
+
+  size_t size() const {
+    return w.size();
+  }
+
+  void reserve(size_t capacity) {
+    w.reserve(capacity);
+    x.reserve(capacity);
+    y.reserve(capacity);
+    z.reserve(capacity);
+  }
+
+  void resize(size_t newSize, const Quaternion &value = Quaternion()) {
+    w.resize(newSize, value.w);
+    x.resize(newSize, value.x);
+    y.resize(newSize, value.y);
+    z.resize(newSize, value.z);
+  }
+
+  void push_back(const Quaternion &quaternion) {
+    w.push_back(quaternion.w);
+    x.push_back(quaternion.x);
+    y.push_back(quaternion.y);
+    z.push_back(quaternion.z);
+  }
+
+  void clear() {
+    w.clear();
+    x.clear();
+    y.clear();
+    z.clear();
+  }
+
+  void swapRemove(size_t index) {
+    w.swapRemove(index);
+    x.swapRemove(index);
+    y.swapRemove(index);
+    z.swapRemove(index);
+  }
+};
+
+/** @} */
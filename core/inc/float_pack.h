@@ -0,0 +1,433 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   float_pack.h
+ *
+ * @brief  Header file for SIMD float packs
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(PHYSICS_SIMD_SCALAR) && defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup CoreModules
+ * @brief    Core modules to run on the CPU for physics management
+ * @{
+ */
+
+/*
+ * Backend selection happens at build time from the target flags (See SIMD in the Makefile):
+ *   - FloatPack<4> uses SSE when available
+ *   - FloatPack<8> uses AVX (And FMA) when available
+ *   - Everything else, or any build with PHYSICS_SIMD_SCALAR defined, uses the portable scalar loops below
+ * Comparisons return masks with every bit of a lane set or clear, meant for select() and moveMask()
+ */
+#if !defined(PHYSICS_SIMD_SCALAR) && defined(__SSE2__)
+#define PHYSICS_SIMD_SSE 1
+#endif
+
+#if !defined(PHYSICS_SIMD_SCALAR) && defined(__AVX__)
+#define PHYSICS_SIMD_AVX 1
+#endif
+
+/**
+ * @brief   N floats processed together, scalar fallback
+ */
+template <size_t N>
+struct FloatPack {
+  static constexpr size_t WIDTH = N;
+
+  float lanes[N];
+
+  FloatPack() = default;
+
+  explicit FloatPack(float value) {
+    for (size_t i = 0U; i < N; i++) {
+      lanes[i] = value;
+    }
+  }
+
+  static FloatPack load(const float *source) {
+    FloatPack result;
+    for (size_t i = 0U; i < N; i++) {
+      result.lanes[i] = source[i];
+    }
+    return result;
+  }
+
+  void store(float *destination) const {
+    for (size_t i = 0U; i < N; i++) {
+      destination[i] = lanes[i];
+    }
+  }
+
+  /**
+   * @brief   Load source[indices[i]] into lane i
+   */
+  static FloatPack gather(const float *source, const uint32_t *indices) {
+    FloatPack result;
+    for (size_t i = 0U; i < N; i++) {
+      result.lanes[i] = source[indices[i]];
+    }
+    return result;
+  }
+
+  float lane(size_t index) const {
+    return lanes[index];
+  }
+
+  template <typename Operation>
+  static FloatPack apply(const FloatPack &a, const FloatPack &b, Operation operation) {
+    FloatPack result;
+    for (size_t i = 0U; i < N; i++) {
+      result.lanes[i] = operation(a.lanes[i], b.lanes[i]);
+    }
+    return result;
+  }
+
+  static float maskFrom(bool condition) {
+    return std::bit_cast<float>(condition ? 0xFFFFFFFFU : 0U);
+  }
+
+  static uint32_t bits(float value) {
+    return std::bit_cast<uint32_t>(value);
+  }
+
+  FloatPack operator+(const FloatPack &other) const {
+    return apply(*this, other, [](float a, float b) { return a + b; });
+  }
+
+  FloatPack operator-(const FloatPack &other) const {
+    return apply(*this, other, [](float a, float b) { return a - b; });
+  }
+
+  FloatPack operator*(const FloatPack &other) const {
+    return apply(*this, other, [](float a, float b) { return a * b; });
+  }
+
+  FloatPack operator/(const FloatPack &other) const {
+    return apply(*this, other, [](float a, float b) { return a / b; });
+  }
+
+  FloatPack operator-() const {
+    return FloatPack(0.0f) - *this;
+  }
+
+  FloatPack operator<(const FloatPack &other) const {
+    return apply(*this, other, [](float a, float b) { return maskFrom(a < b); });
+  }
+
+  FloatPack operator<=(const FloatPack &other) const {
+    return apply(*this, other, [](float a, float b) { return maskFrom(a <= b); });
+  }
+
+  FloatPack operator>(const FloatPack &other) const {
+    return apply(*this, other, [](float a, float b) { return maskFrom(a > b); });
+  }
+
+  FloatPack operator>=(const FloatPack &other) const {
+    return apply(*this, other, [](float a, float b) { return maskFrom(a >= b); });
+  }
+
+  FloatPack operator&(const FloatPack &other) const {
+    return apply(*this, other, [](float a, float b) { return std::bit_cast<float>(bits(a) & bits(b)); });
+  }
+
+  FloatPack operator|(const FloatPack &other) const {
+    return apply(*this, other, [](float a, float b) { return std::bit_cast<float>(bits(a) | bits(b)); });
+  }
+
+  /**
+   * @brief   Per lane mask ? a : b
+   */
+  static FloatPack select(const FloatPack &mask, const FloatPack &a, const FloatPack &b) {
+    FloatPack result;
+    for (size_t i = 0U; i < N; i++) {
+      result.lanes[i] = (bits(mask.lanes[i]) != 0U) ? a.lanes[i] : b.lanes[i];
+    }
+    return result;
+  }
+
+  /**
+   * @brief   One bit per lane, set where the lane's sign bit is set (All mask lanes from a comparison)
+   */
+  uint32_t moveMask() const {
+    uint32_t result = 0U;
+    for (size_t i = 0U; i < N; i++) {
+      result |= (bits(lanes[i]) >> 31U) << i;
+    }
+    return result;
+  }
+
+  static FloatPack min(const FloatPack &a, const FloatPack &b) {
+    return apply(a, b, [](float x, float y) { return (x < y) ? x : y; });
+  }
+
+  static FloatPack max(const FloatPack &a, const FloatPack &b) {
+    return apply(a, b, [](float x, float y) { return (x > y) ? x : y; });
+  }
+
+  static FloatPack sqrt(const FloatPack &a) {
+    FloatPack result;
+    for (size_t i = 0U; i < N; i++) {
+      result.lanes[i] = std::sqrt(a.lanes[i]);
+    }
+    return result;
+  }
+
+  /**
+   * @brief   a * b + c
+   */
+  static FloatPack multiplyAdd(const FloatPack &a, const FloatPack &b, const FloatPack &c) {
+    return (a * b) + c;
+  }
+};
+
+#if defined(PHYSICS_SIMD_SSE)
+/**
+ * @brief   4 floats in an SSE register
+ */
+template <>
+struct FloatPack<4U> {
+  static constexpr size_t WIDTH = 4U;
+
+  __m128 value;
+
+  FloatPack() = default;
+
+  explicit FloatPack(float scalar) : value(_mm_set1_ps(scalar)) {}
+
+  explicit FloatPack(__m128 vector) : value(vector) {}
+
+  static FloatPack load(const float *source) {
+    return FloatPack(_mm_loadu_ps(source));
+  }
+
+  void store(float *destination) const {
+    _mm_storeu_ps(destination, value);
+  }
+
+  static FloatPack gather(const float *source, const uint32_t *indices) {
+    return FloatPack(_mm_setr_ps(source[indices[0U]], source[indices[1U]], source[indices[2U]], source[indices[3U]]));
+  }
+
+  float lane(size_t index) const {
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, value);
+    return lanes[index];
+  }
+
+  FloatPack operator+(const FloatPack &other) const {
+    return FloatPack(_mm_add_ps(value, other.value));
+  }
+
+  FloatPack operator-(const FloatPack &other) const {
+    return FloatPack(_mm_sub_ps(value, other.value));
+  }
+
+  FloatPack operator*(const FloatPack &other) const {
+    return FloatPack(_mm_mul_ps(value, other.value));
+  }
+
+  FloatPack operator/(const FloatPack &other) const {
+    return FloatPack(_mm_div_ps(value, other.value));
+  }
+
+  FloatPack operator-() const {
+    return FloatPack(_mm_xor_ps(value, _mm_set1_ps(-0.0f)));
+  }
+
+  FloatPack operator<(const FloatPack &other) const {
+    return FloatPack(_mm_cmplt_ps(value, other.value));
+  }
+
+  FloatPack operator<=(const FloatPack &other) const {
+    return FloatPack(_mm_cmple_ps(value, other.value));
+  }
+
+  FloatPack operator>(const FloatPack &other) const {
+    return FloatPack(_mm_cmpgt_ps(value, other.value));
+  }
+
+  FloatPack operator>=(const FloatPack &other) const {
+    return FloatPack(_mm_cmpge_ps(value, other.value));
+  }
+
+  FloatPack operator&(const FloatPack &other) const {
+    return FloatPack(_mm_and_ps(value, other.value));
+  }
+
+  FloatPack operator|(const FloatPack &other) const {
+    return FloatPack(_mm_or_ps(value, other.value));
+  }
+
+  static FloatPack select(const FloatPack &mask, const FloatPack &a, const FloatPack &b) {
+    return FloatPack(_mm_or_ps(_mm_and_ps(mask.value, a.value), _mm_andnot_ps(mask.value, b.value)));
+  }
+
+  uint32_t moveMask() const {
+    return static_cast<uint32_t>(_mm_movemask_ps(value));
+  }
+
+  static FloatPack min(const FloatPack &a, const FloatPack &b) {
+    return FloatPack(_mm_min_ps(a.value, b.value));
+  }
+
+  static FloatPack max(const FloatPack &a, const FloatPack &b) {
+    return FloatPack(_mm_max_ps(a.value, b.value));
+  }
+
+  static FloatPack sqrt(const FloatPack &a) {
+    return FloatPack(_mm_sqrt_ps(a.value));
+  }
+
+  static FloatPack multiplyAdd(const FloatPack &a, const FloatPack &b, const FloatPack &c) {
+#if defined(__FMA__)
+    return FloatPack(_mm_fmadd_ps(a.value, b.value, c.value));
+#else
+    return (a * b) + c;
+#endif
+  }
+};
+#endif
+
+#if defined(PHYSICS_SIMD_AVX)
+/**
+ * @brief   8 floats in an AVX register
+ */
+template <>
+struct FloatPack<8U> {
+  static constexpr size_t WIDTH = 8U;
+
+  __m256 value;
+
+  FloatPack() = default;
+
+  explicit FloatPack(float scalar) : value(_mm256_set1_ps(scalar)) {}
+
+  explicit FloatPack(__m256 vector) : value(vector) {}
+
+  static FloatPack load(const float *source) {
+    return FloatPack(_mm256_loadu_ps(source));
+  }
+
+  void store(float *destination) const {
+    _mm256_storeu_ps(destination, value);
+  }
+
+  static FloatPack gather(const float *source, const uint32_t *indices) {
+#if defined(__AVX2__)
+    return FloatPack(_mm256_i32gather_ps(source, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices)), sizeof(float)));
+#else
+    return FloatPack(_mm256_setr_ps(source[indices[0U]], source[indices[1U]], source[indices[2U]], source[indices[3U]], source[indices[4U]], source[indices[5U]],
+                                    source[indices[6U]], source[indices[7U]]));
+#endif
+  }
+
+  float lane(size_t index) const {
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, value);
+    return lanes[index];
+  }
+
+  FloatPack operator+(const FloatPack &other) const {
+    return FloatPack(_mm256_add_ps(value, other.value));
+  }
+
+  FloatPack operator-(const FloatPack &other) const {
+    return FloatPack(_mm256_sub_ps(value, other.value));
+  }
+
+  FloatPack operator*(const FloatPack &other) const {
+    return FloatPack(_mm256_mul_ps(value, other.value));
+  }
+
+  FloatPack operator/(const FloatPack &other) const {
+    return FloatPack(_mm256_div_ps(value, other.value));
+  }
+
+  FloatPack operator-() const {
+    return FloatPack(_mm256_xor_ps(value, _mm256_set1_ps(-0.0f)));
+  }
+
+  FloatPack operator<(const FloatPack &other) const {
+    return FloatPack(_mm256_cmp_ps(value, other.value, _CMP_LT_OQ));
+  }
+
+  FloatPack operator<=(const FloatPack &other) const {
+    return FloatPack(_mm256_cmp_ps(value, other.value, _CMP_LE_OQ));
+  }
+
+  FloatPack operator>(const FloatPack &other) const {
+    return FloatPack(_mm256_cmp_ps(value, other.value, _CMP_GT_OQ));
+  }
+
+  FloatPack operator>=(const FloatPack &other) const {
+    return FloatPack(_mm256_cmp_ps(value, other.value, _CMP_GE_OQ));
+  }
+
+  FloatPack operator&(const FloatPack &other) const {
+    return FloatPack(_mm256_and_ps(value, other.value));
+  }
+
+  FloatPack operator|(const FloatPack &other) const {
+    return FloatPack(_mm256_or_ps(value, other.value));
+  }
+
+  static FloatPack select(const FloatPack &mask, const FloatPack &a, const FloatPack &b) {
+    return FloatPack(_mm256_blendv_ps(b.value, a.value, mask.value));
+  }
+
+  uint32_t moveMask() const {
+    return static_cast<uint32_t>(_mm256_movemask_ps(value));
+  }
+
+  static FloatPack min(const FloatPack &a, const FloatPack &b) {
+    return FloatPack(_mm256_min_ps(a.value, b.value));
+  }
+
+  static FloatPack max(const FloatPack &a, const FloatPack &b) {
+    return FloatPack(_mm256_max_ps(a.value, b.value));
+  }
+
+  static FloatPack sqrt(const FloatPack &a) {
+    return FloatPack(_mm256_sqrt_ps(a.value));
+  }
+
+  static FloatPack multiplyAdd(const FloatPack &a, const FloatPack &b, const FloatPack &c) {
+#if defined(__FMA__)
+    return FloatPack(_mm256_fmadd_ps(a.value, b.value, c.value));
+#else
+    return (a * b) + c;
+#endif
+  }
+};
+#endif
+
+/**
+ * @brief   Widest pack the build has a native backend for
+ */
+#if defined(PHYSICS_SIMD_AVX)
+constexpr size_t NATIVE_PACK_WIDTH = 8U;
+#else
+constexpr size_t NATIVE_PACK_WIDTH = 4U;
+#endif
+
+using Floatx4 = FloatPack<4U>;
+using Floatx8 = FloatPack<8U>;
+
+/** @} */
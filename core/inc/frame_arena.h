@@ -0,0 +1,149 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   frame_arena.h
+ *
+ * @brief  Header file for the per-step bump allocator
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup CoreModules
+ * @brief    Core modules to run on the CPU for physics management
+ * @{
+ */
+
+/**
+ * @brief   Bump allocator for memory that only lives for one simulation step
+ * @details Allocation moves a cursor through the current block, and nothing is freed individually. reset() releases
+ *          everything at once. When a step needed more than one block, reset() swaps them for a single block big enough for
+ *          the whole step, so a repeating workload stops touching the heap after its first few steps.
+ *          Not thread-safe, every thread gets its own arena
+ */
+class FrameArena {
+ public:
+  static constexpr size_t DEFAULT_BLOCK_SIZE = 64U * 1024U;
+
+  explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+  ~FrameArena();
+
+  FrameArena(const FrameArena &) = delete;
+  FrameArena &operator=(const FrameArena &) = delete;
+
+  /**
+   * @brief   Bump allocate size bytes, valid until the next reset()
+   * @param   alignment Power of two
+   */
+  void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * @brief   Release every allocation made since the last reset
+   * @param   minimumCapacity Grow to at least this many bytes while the arena is empty, so the next frame fits without growing
+   */
+  void reset(size_t minimumCapacity = 0U);
+
+  /**
+   * @brief   Bytes handed out since the last reset, including alignment padding
+   */
+  size_t getUsedBytes() const;
+
+  /**
+   * @brief   Most bytes used between two resets
+   */
+  size_t getPeakBytes() const;
+
+  /**
+   * @brief   Total size of the blocks currently held
+   */
+  size_t getCapacity() const;
+
+ private:
+  struct Block {
+    Block *previous; /**< Block filled before this one */
+    size_t size;     /**< Usable bytes after the header */
+  };
+
+  size_t blockSize;
+  Block *current{nullptr};
+  uintptr_t cursor{0U};
+  uintptr_t end{0U};
+  size_t usedBytes{0U};      /**< Bytes used in the blocks before the current one */
+  size_t peakBytes{0U};
+  size_t capacity{0U};
+
+  void addBlock(size_t minimumSize);
+  void releaseBlocks();
+};
+
+/**
+ * @brief   Standard allocator handing out FrameArena memory, deallocation does nothing
+ * @details Moving or swapping a container moves its allocator with it, so a container can be pointed at a fresh arena by
+ *          assigning it a new empty container
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  /**
+   * @brief   Allocator with no arena, the container has to be given one before it allocates
+   */
+  ArenaAllocator() noexcept = default;
+
+  explicit ArenaAllocator(FrameArena &arena) noexcept : arena(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena(other.getArena()) {}
+
+  T *allocate(size_t count) {
+    return static_cast<T *>(arena->allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *, size_t) noexcept {}
+
+  FrameArena *getArena() const {
+    return arena;
+  }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U> &other) const {
+    return arena == other.getArena();
+  }
+
+ private:
+  FrameArena *arena{nullptr};
+};
+
+/**
+ * @brief   Vector that lives in a FrameArena. Rebind it to an arena each step before that arena is reset
+ */
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+/**
+ * @brief   Point a frame vector at an arena, dropping its contents, and reserve room for capacity elements
+ * @details The old contents are never touched, so the vector may still point into an arena that has been reset or destroyed
+ */
+template <typename T>
+void rebindFrameVector(FrameVector<T> &vector, FrameArena &arena, size_t capacity = 0U) {
+  static_assert(std::is_trivially_destructible_v<T>, "Frame vectors drop their contents without running destructors");
+  vector = FrameVector<T>(ArenaAllocator<T>(arena));
+  vector.reserve(capacity);
+}
+
+/** @} */
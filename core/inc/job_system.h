@@ -0,0 +1,170 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   job_system.h
+ *
+ * @brief  Header file for the work stealing job system
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "frame_arena.h"
+
+/**
+ * @defgroup CoreModules
+ * @brief    Core modules to run on the CPU for physics management
+ * @{
+ */
+
+class JobSystem;
+
+/**
+ * @brief   Set of jobs that can be waited on together
+ * @details Waiting doesn't block, the waiting thread runs queued jobs (Its own or stolen) until the group is done
+ */
+class TaskGroup {
+ public:
+  explicit TaskGroup(JobSystem &jobs);
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  void run(std::function<void()> function);
+  void wait();
+
+ private:
+  friend class JobSystem;
+
+  JobSystem &jobs;
+  std::atomic<uint32_t> pending{0U};
+};
+
+/**
+ * @brief   Thread pool where every thread owns a job queue and idle threads steal from the others
+ * @details The thread calling into the job system counts as one of the threads and helps out while it waits, so a thread count
+ *          of 1 runs everything inline with no workers at all. Owners take their newest job first, thieves take the oldest
+ */
+class JobSystem {
+ public:
+  /**
+   * @brief   Start the pool
+   * @param   threadCount Total threads working on jobs, including the caller. 0 picks the hardware thread count
+   */
+  explicit JobSystem(uint32_t threadCount = 0U);
+  ~JobSystem();
+
+  JobSystem(const JobSystem &) = delete;
+  JobSystem &operator=(const JobSystem &) = delete;
+
+  uint32_t getThreadCount() const;
+
+  /**
+   * @brief   Index of the calling thread in [0, getThreadCount()). Threads outside the pool report 0
+   */
+  static uint32_t getWorkerIndex();
+
+  /**
+   * @brief   Scratch arena of a thread, only that thread may allocate from it
+   * @details Arenas live as long as the pool. Whoever drives the pool resets them once per frame, see resetFrameArenas()
+   */
+  FrameArena &getFrameArena(uint32_t workerIndex);
+
+  /**
+   * @brief   Scratch arena of the calling thread
+   */
+  FrameArena &getFrameArena();
+
+  /**
+   * @brief   Reset every thread's arena. Must not be called while jobs are running
+   */
+  void resetFrameArenas();
+
+  /**
+   * @brief   Run function(begin, end) over [0, count) in chunks of grainSize, and wait for all of them
+   * @details Chunk boundaries only depend on count and grainSize, never on the thread count, so work that writes per chunk
+   *          results gives the same answer on any number of threads
+   */
+  template <typename Function>
+  void parallelFor(uint32_t count, uint32_t grainSize, Function &&function) {
+    if (grainSize == 0U) {
+      grainSize = 1U;
+    }
+
+    if (threadCount == 1U || count <= grainSize) {
+      for (uint32_t begin = 0U; begin < count; begin += grainSize) {
+        function(begin, std::min(begin + grainSize, count));
+      }
+      return;
+    }
+
+    TaskGroup group(*this);
+    for (uint32_t begin = 0U; begin < count; begin += grainSize) {
+      uint32_t end = std::min(begin + grainSize, count);
+      group.run([&function, begin, end]() { function(begin, end); });
+    }
+    group.wait();
+  }
+
+ private:
+  friend class TaskGroup;
+
+  struct Job {
+    std::function<void()> function;
+    TaskGroup *group;
+  };
+
+  /**
+   * @brief   Ring buffer of jobs that only ever grows, so steady state submits don't touch the heap
+   */
+  struct WorkQueue {
+    static constexpr size_t INITIAL_CAPACITY = 64U;
+
+    std::mutex mutex;
+    std::vector<Job> jobs = std::vector<Job>(INITIAL_CAPACITY);
+    size_t head{0U}; /**< Oldest job */
+    size_t count{0U};
+
+    void pushBack(Job job);
+    Job popBack();
+    Job popFront();
+  };
+
+  uint32_t threadCount;
+  std::vector<std::unique_ptr<WorkQueue>> queues;       /**< One per thread, queue 0 belongs to callers outside the pool */
+  std::vector<std::unique_ptr<FrameArena>> frameArenas; /**< One per thread, indexed like the queues */
+  std::vector<std::thread> workers;
+
+  std::mutex sleepMutex;
+  std::condition_variable wakeCondition;
+  std::atomic<uint32_t> queuedJobs{0U};
+  bool running{true};
+
+  void submit(Job job);
+  bool popJob(uint32_t queueIndex, Job &job);
+  bool stealJob(uint32_t thiefIndex, Job &job);
+
+  /**
+   * @brief   Run one queued job from the caller's own queue, or steal one
+   * @return  false if there was nothing to run
+   */
+  bool runPendingJob();
+  void workerLoop(uint32_t workerIndex);
+};
+
+/** @} */
@@ -10,8 +10,14 @@
  *******************************************************************************************************************************/
 
 /* Standard library Headers */
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <ostream>
 #include <vector>
 
 /* Inter-component Headers */
@@ -24,34 +30,295 @@
  * @{
  */
 
-class MemoryManager {
+/**
+ * @brief   Counters of one size class, see MemoryManager::getStats()
+ */
+struct SizeClassStats {
+  size_t blockSize;     /**< Block size of the class, 0 for the row of requests above MemoryManager::MAX_BLOCK_SIZE */
+  uint64_t allocations; /**< Blocks handed out */
+  uint64_t frees;       /**< Blocks given back */
+  uint64_t highWater;   /**< Most blocks out of the shared pool at once, live or waiting in a thread cache */
+  uint64_t fallbacks;   /**< Requests passed on to the system allocator, not served from a pool or the large cache */
+  uint64_t slabs;       /**< Slabs the pool holds, pools never shrink before cleanupPools() */
+  double fragmentation; /**< Share of the reserved bytes not holding a live allocation, 0 when nothing is reserved */
+};
+
+/**
+ * @brief   Where the manager gets its memory from, see MemoryManager::initializePools()
+ */
+struct PoolOptions {
+  bool mapMemory{false};                       /**< Reserve slabs and large allocations with mmap instead of the C heap */
+  bool hugePages{false};                       /**< Ask for transparent huge pages on mapped memory with madvise(MADV_HUGEPAGE), needs mapMemory */
+  bool prefault{false};                        /**< Touch every page as memory is reserved, so the first frames don't take the page faults */
+  uint32_t slabsPerPool{1U};                   /**< Slabs each size class gets up front */
+  size_t largeCacheBytes{16U * 1024U * 1024U}; /**< Freed allocations above MAX_BLOCK_SIZE kept for reuse, at most this many bytes */
+};
+
+/**
+ * @brief   Memory the manager has reserved from the system, see MemoryManager::getSystemStats()
+ */
+struct SystemMemoryStats {
+  uint64_t reservations;     /**< Slabs, chunks of slabs and large allocations taken from the system */
+  double reserveSeconds;     /**< Time spent reserving them, prefaulting included */
+  uint64_t prefaultFaults;   /**< Page faults taken while prefaulting */
+  uint64_t mappedBytes;      /**< Live bytes reserved with mmap */
+  uint64_t hugePageBytes;    /**< Live mapped bytes madvise(MADV_HUGEPAGE) was accepted for */
+  uint64_t mapFailures;      /**< mmap calls that failed and fell back to the C heap */
+  uint64_t hugePageFailures; /**< madvise calls refused, e.g. with transparent huge pages disabled */
+};
+
+/**
+ * @brief   Thread-safe pool allocator for small objects
+ * @details Blocks come from slabs of one size class each. A pool grows by chaining another slab when it runs dry. Slabs are
+ *          aligned to their size and start with a header, so freeing a block finds its size class in O(1) by rounding the pointer
+ *          down. Requests above the biggest size class get their own slab sized allocation with the same header, so they are
+ *          told apart from pool blocks the same way and never leak. Freed ones of up to LARGE_CACHE_SLABS slabs are kept on a free
+ *          list per slab count, so a buffer that keeps growing and shrinking doesn't go to the system every time.
+ *          Every thread keeps a small free list per size class that it uses without locking. The shared pools are only locked to
+ *          move a batch of blocks in or out of a thread's cache.
+ *          The manager is a std::pmr::memory_resource, so pmr containers can allocate from it directly.
+ *          Memory comes from the C heap by default. initializePools() can switch to mmap, where slabs are carved out of huge page
+ *          sized chunks so the kernel can back them with transparent huge pages, and can prefault everything it reserves
+ */
+class MemoryManager : public std::pmr::memory_resource {
  public:
+  static constexpr size_t SLAB_SIZE = 64U * 1024U;             /**< Size and alignment of a slab */
+  static constexpr size_t SLAB_HEADER_SIZE = 64U;              /**< Header at the start of every slab, keeps the blocks cache line aligned */
+  static constexpr size_t MAX_BLOCK_SIZE = 16384U;             /**< Bigger requests get their own allocation */
+  static constexpr size_t HUGE_PAGE_SIZE = 2U * 1024U * 1024U; /**< Size and alignment of mapped chunks of slabs */
+
+  MemoryManager();
+  ~MemoryManager();
+
+  MemoryManager(const MemoryManager &) = delete;
+  MemoryManager &operator=(const MemoryManager &) = delete;
+
+  /**
+   * @brief   Manager shared by the engine. It is never destroyed, so objects freed during static destruction still find it
+   */
+  static MemoryManager &getInstance();
+
   /**
    * @brief   Allocate memory
+   * @details Blocks are aligned to their size class up to 64 bytes, so at least to alignof(std::max_align_t)
    */
   void *allocate(size_t size);
+
+  /**
+   * @brief   Free memory from allocate() or reallocate() on this manager, from any thread. nullptr is ignored
+   */
   void deallocate(void *ptr);
   void *reallocate(void *ptr, size_t newSize);
-  void initializePools();
+
+  /**
+   * @brief   Usable size of an allocation, at least the size it was requested with
+   */
+  size_t getBlockSize(const void *ptr) const;
+
+  /**
+   * @brief   Snapshot of the counters, one row per size class and a last row for requests above MAX_BLOCK_SIZE
+   * @details Counters are kept per thread and summed here, so a snapshot taken while other threads allocate is approximate
+   */
+  std::vector<SizeClassStats> getStats() const;
+
+  /**
+   * @brief   Snapshot of the memory reserved from the system and what reserving it cost
+   */
+  SystemMemoryStats getSystemStats() const;
+
+  /**
+   * @brief   Write getStats() and getSystemStats() as a JSON object, with a "sizeClasses" array and a "system" object
+   */
+  void writeStatsJson(std::ostream &out) const;
+
+  /**
+   * @brief   Set where memory comes from and give every size class its first slabs up front. Pools grow on demand, so this is
+   *          optional with the default options
+   * @details Call it before anything is allocated, memory reserved earlier stays where it is. Each option falls back quietly
+   *          when the system can't provide it, getSystemStats() shows what was actually done
+   */
+  void initializePools(const PoolOptions &options = PoolOptions());
+
+  /**
+   * @brief   Release every slab. No pool blocks may be in use, blocks left in thread caches are dropped
+   */
   void cleanupPools();
 
  private:
-  static constexpr size_t POOL_SIZES[] = {16, 32, 64, 128, 256, 512, 1024};
-  static constexpr size_t BLOCKS_PER_POOL = 256;
-  static constexpr size_t BITMAP_WORDS = (BLOCKS_PER_POOL + 63) / 64; /* Rounded up to nearest 64 */
+  static constexpr size_t POOL_SIZES[] = {16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384};
+  static constexpr uint32_t POOL_COUNT = sizeof(POOL_SIZES) / sizeof(POOL_SIZES[0]);
+  static constexpr uint32_t LARGE_ALLOCATION = 0xFFFFFFFFU; /**< Pool index of allocations above MAX_BLOCK_SIZE */
+  static constexpr uint32_t CACHE_CAPACITY = 64U;           /**< Blocks a thread keeps per size class before handing some back */
+  static constexpr size_t CACHE_BYTES = 256U * 1024U;       /**< Fewer blocks of the biggest classes, so a thread doesn't hoard them */
+  static constexpr uint32_t LARGE_CACHE_SLABS = 32U;        /**< Largest allocation, in slabs, the large cache keeps */
+  static constexpr uint32_t MAX_THREAD_CACHES = 4U;         /**< Managers a thread keeps a cache for at once */
+
+  /**
+   * @brief   How a slab or large allocation was reserved, which decides how it is given back
+   */
+  enum class MemorySource : uint32_t {
+    HEAP,       /**< std::aligned_alloc, freed on its own */
+    MAPPED,     /**< Its own mapping, unmapped on its own */
+    HUGE_PAGES, /**< Its own mapping, advised for huge pages */
+    CHUNK       /**< Part of a chunk of slabs, released with the chunk */
+  };
+
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  struct alignas(SLAB_HEADER_SIZE) SlabHeader {
+    uint32_t poolIndex;   /**< Size class of the slab's blocks, or LARGE_ALLOCATION */
+    MemorySource source;  /**< How the slab was reserved */
+    SlabHeader *next;     /**< Next slab of the same pool */
+    size_t size;          /**< Usable bytes of a large allocation */
+    size_t requestedSize; /**< Bytes asked for by a large allocation */
+  };
+
+  struct Chunk {
+    void *memory;
+    MemorySource source; /**< MAPPED or HUGE_PAGES, or HEAP when mmap failed */
+  };
 
   struct Pool {
-    void *memory;                  /**< Start of memory pool*/
-    uint64_t bitmap[BITMAP_WORDS]; /**< 1 = allocated, 0 = free */
-    size_t blockSize;              /**< Size of each block */
+    std::mutex mutex;
+    size_t blockSize{0U};
+    FreeBlock *freeList{nullptr};
+    SlabHeader *slabs{nullptr}; /**< Every slab of the pool, chained through their headers */
+    uint64_t slabCount{0U};
+    uint64_t checkedOut{0U}; /**< Blocks out of the free list, live or in thread caches */
+    uint64_t highWater{0U};
+  };
+
+  /**
+   * @brief   Counters of one thread. Only the owning thread writes them, so they are bumped without atomic read-modify-writes
+   */
+  struct ThreadCounters {
+    std::atomic<uint64_t> allocations[POOL_COUNT]{};
+    std::atomic<uint64_t> frees[POOL_COUNT]{};
+  };
+
+  struct ThreadCache;
+
+  /**
+   * @brief   State shared with the thread caches, which keep it alive while they hand their blocks back on thread exit
+   */
+  struct CentralPools {
+    Pool pools[POOL_COUNT];
+    std::atomic<uint64_t> generation{0U}; /**< Bumped by cleanupPools(), caches from an older generation are stale */
+
+    /* Live thread caches for the stats, and the totals of the ones that are gone */
+    mutable std::mutex cachesMutex;
+    std::vector<ThreadCache *> caches;
+    uint64_t retiredAllocations[POOL_COUNT]{};
+    uint64_t retiredFrees[POOL_COUNT]{};
+
+    /* Allocations above MAX_BLOCK_SIZE are rare and much bigger than the work of a lock */
+    mutable std::mutex largeMutex;
+    SlabHeader *largeCache[LARGE_CACHE_SLABS]{}; /**< Freed large allocations of 1 to LARGE_CACHE_SLABS slabs, by slab count */
+    size_t largeCachedBytes{0U};
+    size_t largeCacheLimit{PoolOptions().largeCacheBytes};
+    uint64_t largeAllocations{0U};
+    uint64_t largeFrees{0U};
+    uint64_t largeReservations{0U}; /**< Large allocations the cache couldn't serve */
+    uint64_t largeHighWater{0U};
+    size_t largeRequestedBytes{0U}; /**< Of the live large allocations */
+    size_t largeReservedBytes{0U};
+
+    /* Memory from the system. Lock order is a pool's mutex, then this one */
+    mutable std::mutex systemMutex;
+    PoolOptions options;
+    std::vector<Chunk> chunks;
+    SlabHeader *spareSlabs{nullptr}; /**< Slabs of the chunks not given to a pool yet */
+    SystemMemoryStats systemStats{};
+
+    ~CentralPools();
+    void releaseSlabs();
+
+    /**
+     * @brief   Reserve size bytes aligned to alignment from the system, following the options
+     * @param   source Receives how the memory was reserved, HEAP, MAPPED or HUGE_PAGES
+     */
+    void *reserve(size_t size, size_t alignment, MemorySource &source);
+    void release(void *memory, size_t size, MemorySource source);
+
+    /**
+     * @brief   A slab for a pool, from a chunk when mapping or on its own from the heap
+     */
+    SlabHeader *takeSlab();
+  };
+
+  /**
+   * @brief   Free lists a single thread allocates from without locking
+   */
+  struct ThreadCache {
+    std::weak_ptr<CentralPools> central;
+    uint64_t generation{0U};
+    FreeBlock *blocks[POOL_COUNT]{};
+    uint32_t counts[POOL_COUNT]{};
+    ThreadCounters counters;
+
+    ~ThreadCache();
+    void drop();
+  };
+
+  struct ThreadCacheEntry {
+    uint64_t managerId{0U};
+    std::unique_ptr<ThreadCache> cache;
   };
 
-  std::vector<Pool> memoryPools;
+  std::shared_ptr<CentralPools> central;
+  uint64_t id; /**< Never reused, so a thread never mistakes a cache of a destroyed manager for ours */
+
+  static uint32_t getPoolIndex(size_t size);
+
+  /**
+   * @brief   Blocks of a size class a thread caches before handing half of them back
+   */
+  static constexpr uint32_t getCacheCapacity(uint32_t poolIndex) {
+    return static_cast<uint32_t>(std::min<size_t>(CACHE_CAPACITY, CACHE_BYTES / POOL_SIZES[poolIndex]));
+  }
+  static SlabHeader *getSlab(const void *ptr);
+
+  ThreadCache &getThreadCache();
+  void refill(ThreadCache &cache, uint32_t poolIndex);
+  static void flush(CentralPools &central, ThreadCache &cache, uint32_t poolIndex, uint32_t count);
+  void addSlab(Pool &pool, uint32_t poolIndex);
+
+  void *allocateLarge(size_t size);
+  void deallocateLarge(SlabHeader *slab);
+
+  /* std::pmr::memory_resource. Alignments up to 64 come from the pools, stricter ones go to the default resource */
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+};
+
+/**
+ * @brief   Standard allocator on top of MemoryManager::getInstance(), for std::allocate_shared and containers
+ */
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+
+  PoolAllocator() noexcept = default;
+
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+  T *allocate(size_t count) {
+    return static_cast<T *>(MemoryManager::getInstance().allocate(count * sizeof(T)));
+  }
+
+  void deallocate(T *pointer, size_t) noexcept {
+    MemoryManager::getInstance().deallocate(pointer);
+  }
 
-  static inline int findFirstZeroBit(uint64_t word);
-  size_t findFreeBlock(Pool &pool);
-  size_t getBlockIndex(const Pool &pool, void *ptr);
-  bool isPointerInPool(const Pool &pool, void *ptr);
+  template <typename U>
+  bool operator==(const PoolAllocator<U> &) const {
+    return true;
+  }
 };
 
 /** @} */
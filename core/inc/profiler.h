@@ -0,0 +1,197 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   profiler.h
+ *
+ * @brief  Header file for the built-in instrumentation scopes and Chrome trace export
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup CoreModules
+ * @brief    Core modules to run on the CPU for physics management
+ * @{
+ */
+
+/**
+ * @brief   One recorded scope or counter sample
+ */
+struct ProfileEvent {
+  const char *name;    /**< Scope or counter name, a string literal */
+  const char *argName; /**< Name of the value attached to a scope, nullptr for none */
+  uint64_t startNs;    /**< Nanoseconds on the steady clock, see Profiler::now() */
+  uint64_t durationNs; /**< Length of a scope, unused for counters */
+  uint64_t value;      /**< Attached value of a scope, or the counter's value */
+  bool counter;        /**< Counter sample rather than a scope */
+};
+
+/**
+ * @brief   Collects instrumentation scopes from every thread and writes them out as a Chrome trace
+ * @details Every thread records into its own buffer, so recording never takes a lock after a thread's first event. Events are
+ *          only kept while capturing is on, scopes still feed their step statistics when it is off. Scopes around single jobs
+ *          are many times more numerous than the rest and are only timed when asked for, so a default capture stays cheap.
+ *          Reading or clearing the events must not overlap a step.
+ *          Only built in with PHYSICS_PROFILE (make PROFILE=1), otherwise the PROFILE_ macros below compile to nothing
+ */
+class Profiler {
+ public:
+  static constexpr size_t INITIAL_EVENT_CAPACITY = 16384U; /**< Events reserved per thread up front */
+
+  static Profiler &getInstance();
+
+  /**
+   * @brief   Nanoseconds on the steady clock, which every event uses. Traces are written relative to their first event
+   */
+  static uint64_t now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  /**
+   * @brief   Start or stop keeping events. Off by default, so a long run doesn't grow the buffers without bound
+   * @param   jobs Also time the scopes around single jobs, off by default as they cost far more than the phase scopes
+   */
+  void setCapturing(bool capturing, bool jobs = false);
+  bool isCapturing() const {
+    return capturing.load(std::memory_order_relaxed);
+  }
+  bool isCapturingJobs() const {
+    return capturingJobs.load(std::memory_order_relaxed);
+  }
+
+  void recordScope(const char *name, uint64_t startNs, uint64_t durationNs, const char *argName, uint64_t value);
+  void recordCounter(const char *name, uint64_t value);
+
+  /**
+   * @brief   Drop every captured event
+   */
+  void clear();
+
+  size_t getEventCount() const;
+
+  /**
+   * @brief   Write the captured events in the Chrome trace event format, for chrome://tracing or Perfetto
+   * @details Scopes become complete ("X") events with their attached value in args, counters become "C" events
+   */
+  void writeChromeTrace(std::ostream &out) const;
+
+ private:
+  struct ThreadBuffer {
+    uint32_t threadId;
+    std::vector<ProfileEvent> events;
+  };
+
+  std::atomic<bool> capturing{false};
+  std::atomic<bool> capturingJobs{false};
+  mutable std::mutex mutex; /**< Guards the list of buffers, not their contents */
+  std::vector<std::unique_ptr<ThreadBuffer>> threads;
+
+  Profiler() = default;
+
+  ThreadBuffer &getThreadBuffer();
+};
+
+/**
+ * @brief   Times the enclosing block. Adds its length to a statistic if given one, and records an event while capturing
+ */
+class ProfileScope {
+ public:
+  explicit ProfileScope(const char *name, double *seconds = nullptr) : name(name), seconds(seconds), startNs(Profiler::now()) {}
+
+  ~ProfileScope() {
+    uint64_t durationNs = Profiler::now() - startNs;
+    if (seconds) {
+      *seconds += static_cast<double>(durationNs) * 1.0e-9;
+    }
+
+    Profiler &profiler = Profiler::getInstance();
+    if (profiler.isCapturing()) {
+      profiler.recordScope(name, startNs, durationNs, argName, value);
+    }
+  }
+
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+  /**
+   * @brief   Attach a value to the scope's event, e.g. how many pairs it tested
+   */
+  void setValue(const char *argName, uint64_t value) {
+    this->argName = argName;
+    this->value = value;
+  }
+
+ private:
+  const char *name;
+  double *seconds;
+  uint64_t startNs;
+  const char *argName{nullptr};
+  uint64_t value{0U};
+};
+
+/**
+ * @brief   Times the enclosing job, but only while capturing jobs. Jobs feed no statistic, so otherwise it doesn't read the clock
+ */
+class ProfileJobScope {
+ public:
+  explicit ProfileJobScope(const char *name) : name(name), timed(Profiler::getInstance().isCapturingJobs()), startNs(timed ? Profiler::now() : 0U) {}
+
+  ~ProfileJobScope() {
+    if (timed) {
+      Profiler::getInstance().recordScope(name, startNs, Profiler::now() - startNs, argName, value);
+    }
+  }
+
+  ProfileJobScope(const ProfileJobScope &) = delete;
+  ProfileJobScope &operator=(const ProfileJobScope &) = delete;
+
+  void setValue(const char *argName, uint64_t value) {
+    this->argName = argName;
+    this->value = value;
+  }
+
+ private:
+  const char *name;
+  bool timed;
+  uint64_t startNs;
+  const char *argName{nullptr};
+  uint64_t value{0U};
+};
+
+#if defined(PHYSICS_PROFILE)
+/** Time the rest of the block as a scope called name */
+#define PROFILE_SCOPE(scope, name) ProfileScope scope(name)
+/** Time the rest of the block, also adding its length in seconds to the double statistic */
+#define PROFILE_SCOPE_STAT(scope, name, statistic) ProfileScope scope(name, &(statistic))
+/** Time the rest of a job's block, only while capturing jobs */
+#define PROFILE_JOB_SCOPE(scope, name) ProfileJobScope scope(name)
+/** Attach a value to a scope's event */
+#define PROFILE_VALUE(scope, argName, value) (scope).setValue(argName, value)
+/** Record a counter sample */
+#define PROFILE_COUNTER(name, value) Profiler::getInstance().recordCounter(name, value)
+/** Code that only exists in profiling builds, such as updating statistics */
+#define PROFILE_ONLY(...) __VA_ARGS__
+#else
+#define PROFILE_SCOPE(scope, name)
+#define PROFILE_SCOPE_STAT(scope, name, statistic)
+#define PROFILE_JOB_SCOPE(scope, name)
+#define PROFILE_VALUE(scope, argName, value)
+#define PROFILE_COUNTER(name, value)
+#define PROFILE_ONLY(...)
+#endif
+
+/** @} */
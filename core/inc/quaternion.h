@@ -0,0 +1,86 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   quaternion.h
+ *
+ * @brief  Header file for a quaternion library
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "matrix_3d.h"
+#include "vector_3d.h"
+
+/**
+ * @defgroup CoreModules
+ * @brief    Core modules to run on the CPU for physics management
+ * @{
+ */
+
+/**
+ * @brief   Rotation stored as a unit quaternion (w + xi + yj + zk)
+ * @details Half the size of a rotation matrix, and it only drifts in length, which one multiply-add pass fixes
+ */
+class Quaternion {
+ public:
+  float w, x, y, z;
+
+  /**
+   * @brief   Identity rotation
+   */
+  Quaternion();
+  Quaternion(float w, float x, float y, float z);
+
+  static Quaternion fromAxisAngle(const Vector3D &axis, float angle);
+
+  /**
+   * @brief   Rotation matching an orthonormal rotation matrix
+   */
+  static Quaternion fromMatrix(const Matrix3D &rotation);
+
+  Quaternion operator+(const Quaternion &other) const {
+    return Quaternion(this->w + other.w, this->x + other.x, this->y + other.y, this->z + other.z);
+  };
+
+  Quaternion operator*(float scale) const {
+    return Quaternion(this->w * scale, this->x * scale, this->y * scale, this->z * scale);
+  };
+
+  /**
+   * @brief   Hamilton product, the result rotates by other first and then by this
+   */
+  Quaternion operator*(const Quaternion &other) const {
+    return Quaternion((this->w * other.w) - (this->x * other.x) - (this->y * other.y) - (this->z * other.z),
+                      (this->w * other.x) + (this->x * other.w) + (this->y * other.z) - (this->z * other.y),
+                      (this->w * other.y) - (this->x * other.z) + (this->y * other.w) + (this->z * other.x),
+                      (this->w * other.z) + (this->x * other.y) - (this->y * other.x) + (this->z * other.w));
+  };
+
+  float lengthSquared() const;
+  float length() const;
+  Quaternion normalize() const;
+
+  /**
+   * @brief   Inverse rotation (For unit quaternions)
+   */
+  Quaternion conjugate() const;
+
+  Vector3D rotate(const Vector3D &vector) const;
+
+  /**
+   * @brief   Rotate by a world space angular velocity over a time step (q' = q + 0.5 * (0, w) * q * dt), normalized
+   * @details The step grows the length squared by |w|^2 * dt^2 / 4, a Newton step of 1 / sqrt can't take that back out for fast
+   *          spinners, so this takes the square root
+   */
+  Quaternion integrate(const Vector3D &angularVelocity, float deltaTime) const;
+
+  Matrix3D toMatrix() const;
+};
+
+/** @} */
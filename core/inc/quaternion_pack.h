@@ -0,0 +1,131 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   quaternion_pack.h
+ *
+ * @brief  Header file for SIMD packs of quaternions
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstddef>
+#include <cstdint>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "aligned_array.h"
+#include "float_pack.h"
+#include "quaternion.h"
+#include "vector_pack.h"
+
+/**
+ * @defgroup CoreModules
+ * @brief    Core modules to run on the CPU for physics management
+ * @{
+ */
+
+/**
+ * @brief   N quaternions stored as one pack per component, mirroring QuaternionArray
+ * @details The operations follow the scalar Quaternion ones term for term, so both paths agree up to rounding
+ */
+template <size_t N>
+struct QuatPack {
+  using Pack = FloatPack<N>;
+
+  Pack w;
+  Pack x;
+  Pack y;
+  Pack z;
+
+  QuatPack() = default;
+
+  QuatPack(const Pack &w, const Pack &x, const Pack &y, const Pack &z) : w(w), x(x), y(y), z(z) {}
+
+  static QuatPack load(const QuaternionArray &array, size_t index) {
+    return QuatPack(Pack::load(array.w.data() + index), Pack::load(array.x.data() + index), Pack::load(array.y.data() + index), Pack::load(array.z.data() + index));
+  }
+
+  void store(QuaternionArray &array, size_t index) const {
+    w.store(array.w.data() + index);
+    x.store(array.x.data() + index);
+    y.store(array.y.data() + index);
+    z.store(array.z.data() + index);
+  }
+
+  static QuatPack gather(const QuaternionArray &array, const uint32_t *indices) {
+    return QuatPack(Pack::gather(array.w.data(), indices), Pack::gather(array.x.data(), indices), Pack::gather(array.y.data(), indices), Pack::gather(array.z.data(), indices));
+  }
+
+  /**
+   * @brief   Store the N quaternions to the given indices, which must all be different
+   */
+  void scatter(QuaternionArray &array, const uint32_t *indices) const {
+    alignas(64) float lanes[4U][N];
+    w.store(lanes[0U]);
+    x.store(lanes[1U]);
+    y.store(lanes[2U]);
+    z.store(lanes[3U]);
+    for (size_t i = 0U; i < N; i++) {
+      array.w[indices[i]] = lanes[0U][i];
+      array.x[indices[i]] = lanes[1U][i];
+      array.y[indices[i]] = lanes[2U][i];
+      array.z[indices[i]] = lanes[3U][i];
+    }
+  }
+
+  Quaternion lane(size_t index) const {
+    return Quaternion(w.lane(index), x.lane(index), y.lane(index), z.lane(index));
+  }
+
+  QuatPack operator+(const QuatPack &other) const {
+    return QuatPack(w + other.w, x + other.x, y + other.y, z + other.z);
+  }
+
+  QuatPack operator*(const Pack &scale) const {
+    return QuatPack(w * scale, x * scale, y * scale, z * scale);
+  }
+
+  QuatPack operator*(const QuatPack &other) const {
+    return QuatPack((w * other.w) - (x * other.x) - (y * other.y) - (z * other.z), (w * other.x) + (x * other.w) + (y * other.z) - (z * other.y),
+                    (w * other.y) - (x * other.z) + (y * other.w) + (z * other.x), (w * other.z) + (x * other.y) - (y * other.x) + (z * other.w));
+  }
+
+  Pack lengthSquared() const {
+    return (w * w) + (x * x) + (y * y) + (z * z);
+  }
+
+  /**
+   * @brief   Scale to unit length. Unlike Quaternion::normalize a zero quaternion isn't turned into the identity, integrate() never
+   *          makes one
+   */
+  QuatPack normalize() const {
+    return *this * (Pack(1.0f) / Pack::sqrt(lengthSquared()));
+  }
+
+  QuatPack conjugate() const {
+    return QuatPack(w, -x, -y, -z);
+  }
+
+  Vec3Pack<N> rotate(const Vec3Pack<N> &vector) const {
+    Vec3Pack<N> axis(x, y, z);
+    Vec3Pack<N> twiceCross = axis.crossProduct(vector) * Pack(2.0f);
+    return vector + (twiceCross * w) + axis.crossProduct(twiceCross);
+  }
+
+  /**
+   * @brief   Advance the orientations by the angular velocities over deltaTime, see Quaternion::integrate
+   */
+  QuatPack integrate(const Vec3Pack<N> &angularVelocity, const Pack &deltaTime) const {
+    QuatPack spin(Pack(0.0f), angularVelocity.x, angularVelocity.y, angularVelocity.z);
+    return (*this + (spin * *this) * (Pack(0.5f) * deltaTime)).normalize();
+  }
+};
+
+using Quatx4 = QuatPack<4U>;
+using Quatx8 = QuatPack<8U>;
+using QuatxN = QuatPack<NATIVE_PACK_WIDTH>;
+
+/** @} */
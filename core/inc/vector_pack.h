@@ -0,0 +1,265 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   vector_pack.h
+ *
+ * @brief  Header file for SIMD packs of 3D vectors and 3x3 matrices
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstddef>
+#include <cstdint>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "aligned_array.h"
+#include "float_pack.h"
+#include "matrix_3d.h"
+#include "vector_3d.h"
+
+/**
+ * @defgroup CoreModules
+ * @brief    Core modules to run on the CPU for physics management
+ * @{
+ */
+
+/**
+ * @brief   N 3D vectors stored as one pack per component (SoA), so every operation works on all N at once
+ * @details Loads and stores line up with Vector3DArray, where each component is already its own contiguous array
+ */
+template <size_t N>
+struct Vec3Pack {
+  using Pack = FloatPack<N>;
+
+  Pack x;
+  Pack y;
+  Pack z;
+
+  Vec3Pack() = default;
+
+  Vec3Pack(const Pack &x, const Pack &y, const Pack &z) : x(x), y(y), z(z) {}
+
+  /**
+   * @brief   Same vector in every lane
+   */
+  explicit Vec3Pack(const Vector3D &vector) : x(vector.x), y(vector.y), z(vector.z) {}
+
+  /**
+   * @brief   Load N consecutive vectors starting at index
+   */
+  static Vec3Pack load(const Vector3DArray &array, size_t index) {
+    return Vec3Pack(Pack::load(array.x.data() + index), Pack::load(array.y.data() + index), Pack::load(array.z.data() + index));
+  }
+
+  /**
+   * @brief   Store into N consecutive vectors starting at index
+   */
+  void store(Vector3DArray &array, size_t index) const {
+    x.store(array.x.data() + index);
+    y.store(array.y.data() + index);
+    z.store(array.z.data() + index);
+  }
+
+  /**
+   * @brief   Load the N vectors at the given (Possibly scattered) indices
+   */
+  static Vec3Pack gather(const Vector3DArray &array, const uint32_t *indices) {
+    return Vec3Pack(Pack::gather(array.x.data(), indices), Pack::gather(array.y.data(), indices), Pack::gather(array.z.data(), indices));
+  }
+
+  /**
+   * @brief   Store the N vectors to the given indices, which must all be different
+   */
+  void scatter(Vector3DArray &array, const uint32_t *indices) const {
+    alignas(64) float lanes[3U][N];
+    x.store(lanes[0U]);
+    y.store(lanes[1U]);
+    z.store(lanes[2U]);
+    for (size_t i = 0U; i < N; i++) {
+      array.x[indices[i]] = lanes[0U][i];
+      array.y[indices[i]] = lanes[1U][i];
+      array.z[indices[i]] = lanes[2U][i];
+    }
+  }
+
+  Vector3D lane(size_t index) const {
+    return Vector3D(x.lane(index), y.lane(index), z.lane(index));
+  }
+
+  Vec3Pack operator+(const Vec3Pack &other) const {
+    return Vec3Pack(x + other.x, y + other.y, z + other.z);
+  }
+
+  Vec3Pack operator-(const Vec3Pack &other) const {
+    return Vec3Pack(x - other.x, y - other.y, z - other.z);
+  }
+
+  Vec3Pack operator-() const {
+    return Vec3Pack(-x, -y, -z);
+  }
+
+  Vec3Pack operator*(const Pack &scale) const {
+    return Vec3Pack(x * scale, y * scale, z * scale);
+  }
+
+  Vec3Pack operator/(const Pack &scale) const {
+    return Vec3Pack(x / scale, y / scale, z / scale);
+  }
+
+  Pack lengthSquared() const {
+    return dotProduct(*this);
+  }
+
+  Pack length() const {
+    return Pack::sqrt(lengthSquared());
+  }
+
+  /**
+   * @brief   Unit vectors, lanes with a zero length vector are left at zero instead of turning into NaN
+   */
+  Vec3Pack normalize() const {
+    Pack lengths = length();
+    Pack nonZero = lengths > Pack(0.0f);
+    Pack inverse = Pack::select(nonZero, Pack(1.0f) / lengths, Pack(0.0f));
+    return *this * inverse;
+  }
+
+  Pack dotProduct(const Vec3Pack &other) const {
+    return Pack::multiplyAdd(x, other.x, Pack::multiplyAdd(y, other.y, z * other.z));
+  }
+
+  Vec3Pack crossProduct(const Vec3Pack &other) const {
+    return Vec3Pack((y * other.z) - (z * other.y), (z * other.x) - (x * other.z), (x * other.y) - (y * other.x));
+  }
+
+  /**
+   * @brief   this * scale + offset, fused where the backend supports it
+   */
+  Vec3Pack multiplyAdd(const Pack &scale, const Vec3Pack &offset) const {
+    return Vec3Pack(Pack::multiplyAdd(x, scale, offset.x), Pack::multiplyAdd(y, scale, offset.y), Pack::multiplyAdd(z, scale, offset.z));
+  }
+
+  /**
+   * @brief   Per lane mask ? a : b
+   */
+  static Vec3Pack select(const Pack &mask, const Vec3Pack &a, const Vec3Pack &b) {
+    return Vec3Pack(Pack::select(mask, a.x, b.x), Pack::select(mask, a.y, b.y), Pack::select(mask, a.z, b.z));
+  }
+};
+
+/**
+ * @brief   N 3x3 matrices stored as one pack per element, laid out like Matrix3D (matrix[row][col])
+ */
+template <size_t N>
+struct Mat3Pack {
+  using Pack = FloatPack<N>;
+
+  Pack matrix[3U][3U];
+
+  Mat3Pack() = default;
+
+  /**
+   * @brief   Same matrix in every lane
+   */
+  explicit Mat3Pack(const Matrix3D &source) {
+    for (size_t row = 0U; row < 3U; row++) {
+      for (size_t col = 0U; col < 3U; col++) {
+        matrix[row][col] = Pack(source.matrix[row][col]);
+      }
+    }
+  }
+
+  static Mat3Pack identity() {
+    Mat3Pack result;
+    for (size_t row = 0U; row < 3U; row++) {
+      for (size_t col = 0U; col < 3U; col++) {
+        result.matrix[row][col] = Pack((row == col) ? 1.0f : 0.0f);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief   Build from the N matrices at the given indices of an array of Matrix3D
+   */
+  static Mat3Pack gather(const Matrix3D *source, const uint32_t *indices) {
+    alignas(64) float lanes[N];
+    Mat3Pack result;
+    for (size_t row = 0U; row < 3U; row++) {
+      for (size_t col = 0U; col < 3U; col++) {
+        for (size_t i = 0U; i < N; i++) {
+          lanes[i] = source[indices[i]].matrix[row][col];
+        }
+        result.matrix[row][col] = Pack::load(lanes);
+      }
+    }
+    return result;
+  }
+
+  Matrix3D lane(size_t index) const {
+    return Matrix3D(matrix[0U][0U].lane(index), matrix[0U][1U].lane(index), matrix[0U][2U].lane(index), matrix[1U][0U].lane(index), matrix[1U][1U].lane(index),
+                    matrix[1U][2U].lane(index), matrix[2U][0U].lane(index), matrix[2U][1U].lane(index), matrix[2U][2U].lane(index));
+  }
+
+  Vec3Pack<N> operator*(const Vec3Pack<N> &vector) const {
+    return Vec3Pack<N>(Pack::multiplyAdd(matrix[0U][0U], vector.x, Pack::multiplyAdd(matrix[0U][1U], vector.y, matrix[0U][2U] * vector.z)),
+                       Pack::multiplyAdd(matrix[1U][0U], vector.x, Pack::multiplyAdd(matrix[1U][1U], vector.y, matrix[1U][2U] * vector.z)),
+                       Pack::multiplyAdd(matrix[2U][0U], vector.x, Pack::multiplyAdd(matrix[2U][1U], vector.y, matrix[2U][2U] * vector.z)));
+  }
+
+  Mat3Pack operator*(const Mat3Pack &other) const {
+    Mat3Pack result;
+    for (size_t row = 0U; row < 3U; row++) {
+      for (size_t col = 0U; col < 3U; col++) {
+        result.matrix[row][col] = Pack::multiplyAdd(matrix[row][0U], other.matrix[0U][col], Pack::multiplyAdd(matrix[row][1U], other.matrix[1U][col], matrix[row][2U] * other.matrix[2U][col]));
+      }
+    }
+    return result;
+  }
+
+  Mat3Pack operator+(const Mat3Pack &other) const {
+    Mat3Pack result;
+    for (size_t row = 0U; row < 3U; row++) {
+      for (size_t col = 0U; col < 3U; col++) {
+        result.matrix[row][col] = matrix[row][col] + other.matrix[row][col];
+      }
+    }
+    return result;
+  }
+
+  Mat3Pack operator*(const Pack &scale) const {
+    Mat3Pack result;
+    for (size_t row = 0U; row < 3U; row++) {
+      for (size_t col = 0U; col < 3U; col++) {
+        result.matrix[row][col] = matrix[row][col] * scale;
+      }
+    }
+    return result;
+  }
+
+  Mat3Pack transpose() const {
+    Mat3Pack result;
+    for (size_t row = 0U; row < 3U; row++) {
+      for (size_t col = 0U; col < 3U; col++) {
+        result.matrix[row][col] = matrix[col][row];
+      }
+    }
+    return result;
+  }
+};
+
+using Vec3x4 = Vec3Pack<4U>;
+using Vec3x8 = Vec3Pack<8U>;
+using Mat3x4 = Mat3Pack<4U>;
+using Mat3x8 = Mat3Pack<8U>;
+
+/* Native width for the build, what batched kernels should default to */
+using FloatxN = FloatPack<NATIVE_PACK_WIDTH>;
+using Vec3xN = Vec3Pack<NATIVE_PACK_WIDTH>;
+using Mat3xN = Mat3Pack<NATIVE_PACK_WIDTH>;
+
+/** @} */
@@ -0,0 +1,95 @@
+/*******************************************************************************************************************************
+ * @file   frame_arena.cc
+ *
+ * @brief  Source file for the per-step bump allocator
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "frame_arena.h"
+#include "memory_manager.h"
+
+FrameArena::FrameArena(size_t blockSize) : blockSize(blockSize) {}
+
+FrameArena::~FrameArena() {
+  releaseBlocks();
+}
+
+void *FrameArena::allocate(size_t size, size_t alignment) {
+  uintptr_t start = (cursor + alignment - 1U) & ~(static_cast<uintptr_t>(alignment) - 1U);
+
+  if (!current || start + size > end) {
+    addBlock(size + alignment);
+    start = (cursor + alignment - 1U) & ~(static_cast<uintptr_t>(alignment) - 1U);
+  }
+
+  cursor = start + size;
+  peakBytes = std::max(peakBytes, getUsedBytes());
+  return reinterpret_cast<void *>(start);
+}
+
+void FrameArena::reset(size_t minimumCapacity) {
+  /* A step that spilled into more blocks gets one block that fits all of it, so the next step runs without growing */
+  if ((current && current->previous) || capacity < minimumCapacity) {
+    size_t total = std::max(capacity, minimumCapacity);
+    releaseBlocks();
+    addBlock(total);
+  }
+
+  usedBytes = 0U;
+  if (current) {
+    cursor = reinterpret_cast<uintptr_t>(current + 1);
+  }
+}
+
+size_t FrameArena::getUsedBytes() const {
+  return current ? usedBytes + (cursor - reinterpret_cast<uintptr_t>(current + 1)) : 0U;
+}
+
+size_t FrameArena::getPeakBytes() const {
+  return peakBytes;
+}
+
+size_t FrameArena::getCapacity() const {
+  return capacity;
+}
+
+void FrameArena::addBlock(size_t minimumSize) {
+  /* Blocks double so a step needs few of them, the space left in the old block is given up */
+  size_t size = std::max(minimumSize, std::max(blockSize, current ? current->size * 2U : 0U));
+  Block *block = static_cast<Block *>(MemoryManager::getInstance().allocate(sizeof(Block) + size));
+
+  /* The manager rounds big blocks up to whole slabs, the rounding is usable too */
+  size = MemoryManager::getInstance().getBlockSize(block) - sizeof(Block);
+
+  if (current) {
+    usedBytes += cursor - reinterpret_cast<uintptr_t>(current + 1);
+  }
+
+  block->previous = current;
+  block->size = size;
+  current = block;
+  cursor = reinterpret_cast<uintptr_t>(block + 1);
+  end = cursor + size;
+  capacity += size;
+}
+
+void FrameArena::releaseBlocks() {
+  while (current) {
+    Block *previous = current->previous;
+    MemoryManager::getInstance().deallocate(current);
+    current = previous;
+  }
+
+  cursor = 0U;
+  end = 0U;
+  usedBytes = 0U;
+  capacity = 0U;
+}
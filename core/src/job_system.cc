@@ -0,0 +1,194 @@
+/*******************************************************************************************************************************
+ * @file   job_system.cc
+ *
+ * @brief  Source file for the work stealing job system
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "job_system.h"
+
+namespace {
+thread_local uint32_t currentWorkerIndex = 0U;
+}
+
+void JobSystem::WorkQueue::pushBack(Job job) {
+  if (count == jobs.size()) {
+    /* Unroll the ring into a bigger buffer, oldest job first */
+    std::vector<Job> grown(jobs.size() * 2U);
+    for (size_t i = 0U; i < count; i++) {
+      grown[i] = std::move(jobs[(head + i) % jobs.size()]);
+    }
+    jobs.swap(grown);
+    head = 0U;
+  }
+
+  jobs[(head + count) % jobs.size()] = std::move(job);
+  count++;
+}
+
+JobSystem::Job JobSystem::WorkQueue::popBack() {
+  count--;
+  return std::move(jobs[(head + count) % jobs.size()]);
+}
+
+JobSystem::Job JobSystem::WorkQueue::popFront() {
+  Job job = std::move(jobs[head]);
+  head = (head + 1U) % jobs.size();
+  count--;
+  return job;
+}
+
+TaskGroup::TaskGroup(JobSystem &jobs) : jobs(jobs) {}
+
+TaskGroup::~TaskGroup() {
+  wait();
+}
+
+void TaskGroup::run(std::function<void()> function) {
+  pending.fetch_add(1U, std::memory_order_relaxed);
+  jobs.submit(JobSystem::Job{std::move(function), this});
+}
+
+void TaskGroup::wait() {
+  /* Help out instead of blocking, the jobs we wait on may be sitting in our own queue */
+  while (pending.load(std::memory_order_acquire) > 0U) {
+    if (!jobs.runPendingJob()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+JobSystem::JobSystem(uint32_t threadCount) {
+  if (threadCount == 0U) {
+    threadCount = std::max(1U, std::thread::hardware_concurrency());
+  }
+  this->threadCount = threadCount;
+
+  for (uint32_t i = 0U; i < threadCount; i++) {
+    queues.push_back(std::make_unique<WorkQueue>());
+    frameArenas.push_back(std::make_unique<FrameArena>());
+  }
+
+  for (uint32_t i = 1U; i < threadCount; i++) {
+    workers.emplace_back(&JobSystem::workerLoop, this, i);
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    running = false;
+  }
+  wakeCondition.notify_all();
+
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+uint32_t JobSystem::getThreadCount() const {
+  return threadCount;
+}
+
+uint32_t JobSystem::getWorkerIndex() {
+  return currentWorkerIndex;
+}
+
+FrameArena &JobSystem::getFrameArena(uint32_t workerIndex) {
+  return *frameArenas[workerIndex];
+}
+
+FrameArena &JobSystem::getFrameArena() {
+  return *frameArenas[currentWorkerIndex];
+}
+
+void JobSystem::resetFrameArenas() {
+  /* Work stealing decides how much of a frame each thread ends up doing, so every arena is grown to fit the largest one */
+  size_t capacity = 0U;
+  for (const std::unique_ptr<FrameArena> &arena : frameArenas) {
+    capacity = std::max(capacity, arena->getCapacity());
+  }
+
+  for (std::unique_ptr<FrameArena> &arena : frameArenas) {
+    arena->reset(capacity);
+  }
+}
+
+void JobSystem::submit(Job job) {
+  WorkQueue &queue = *queues[currentWorkerIndex];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.pushBack(std::move(job));
+  }
+
+  /* Counted under the sleep mutex so a worker can't miss the wake up between checking and waiting */
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    queuedJobs.fetch_add(1U, std::memory_order_relaxed);
+  }
+  wakeCondition.notify_one();
+}
+
+bool JobSystem::popJob(uint32_t queueIndex, Job &job) {
+  WorkQueue &queue = *queues[queueIndex];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+
+  if (queue.count == 0U) {
+    return false;
+  }
+
+  /* Newest first, it is the most likely to still be in cache */
+  job = queue.popBack();
+  return true;
+}
+
+bool JobSystem::stealJob(uint32_t thiefIndex, Job &job) {
+  for (uint32_t offset = 1U; offset < threadCount; offset++) {
+    WorkQueue &queue = *queues[(thiefIndex + offset) % threadCount];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.count > 0U) {
+      /* Oldest first, it is usually the biggest piece of remaining work and least contended by the owner */
+      job = queue.popFront();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool JobSystem::runPendingJob() {
+  Job job;
+  if (!popJob(currentWorkerIndex, job) && !stealJob(currentWorkerIndex, job)) {
+    return false;
+  }
+
+  queuedJobs.fetch_sub(1U, std::memory_order_relaxed);
+  job.function();
+  job.group->pending.fetch_sub(1U, std::memory_order_release);
+  return true;
+}
+
+void JobSystem::workerLoop(uint32_t workerIndex) {
+  currentWorkerIndex = workerIndex;
+
+  while (true) {
+    if (runPendingJob()) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    wakeCondition.wait(lock, [this]() { return !running || queuedJobs.load(std::memory_order_relaxed) > 0U; });
+    if (!running) {
+      return;
+    }
+  }
+}
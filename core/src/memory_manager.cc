@@ -9,92 +9,172 @@
 
 /* Standard library Headers */
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <new>
+
+#if defined(__unix__)
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
 
 /* Inter-component Headers */
 
 /* Intra-component Headers */
 #include "memory_manager.h"
 
-int MemoryManager::findFirstZeroBit(uint64_t word) {
-/* Returns position of first zero bit, or -1 if none found */
-/* Using compiler intrinsic for efficiency */
-#if defined(__GNUC__) || defined(__clang__)
-  if (word == ~0ULL)
-    return -1;
-  return __builtin_ffsll(~word) - 1;
+namespace {
+std::atomic<uint64_t> nextManagerId{1U};
+
+/* Counter with a single writer, a plain load and store is enough and avoids a locked instruction */
+void increment(std::atomic<uint64_t> &counter) {
+  counter.store(counter.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+}
+
+/* Minor and major page faults taken by the calling thread so far */
+uint64_t getPageFaults() {
+#if defined(__unix__)
+  rusage usage{};
+#if defined(RUSAGE_THREAD)
+  getrusage(RUSAGE_THREAD, &usage);
 #else
-  /* Fallback for other compilers */
-  for (int i = 0; i < 64; i++) {
-    if ((word & (1ULL << i)) == 0)
-      return i;
+  getrusage(RUSAGE_SELF, &usage);
+#endif
+  return static_cast<uint64_t>(usage.ru_minflt) + static_cast<uint64_t>(usage.ru_majflt);
+#else
+  return 0U;
+#endif
+}
+
+/* Map size bytes aligned to alignment, by mapping extra and trimming both ends. nullptr on failure */
+void *mapAligned(size_t size, size_t alignment) {
+#if defined(__unix__)
+  size_t padded = size + alignment;
+  void *mapping = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) {
+    return nullptr;
   }
-  return -1;
+
+  uintptr_t start = reinterpret_cast<uintptr_t>(mapping);
+  uintptr_t aligned = (start + alignment - 1U) & ~(static_cast<uintptr_t>(alignment) - 1U);
+  if (aligned > start) {
+    munmap(mapping, aligned - start);
+  }
+  if (aligned + size < start + padded) {
+    munmap(reinterpret_cast<void *>(aligned + size), (start + padded) - (aligned + size));
+  }
+  return reinterpret_cast<void *>(aligned);
+#else
+  (void)size;
+  (void)alignment;
+  return nullptr;
 #endif
 }
+}  // namespace
 
-size_t MemoryManager::findFreeBlock(Pool &pool) {
-  /* Search through bitmap words */
-  for (size_t i = 0; i < BITMAP_WORDS; i++) {
-    int bit = findFirstZeroBit(pool.bitmap[i]);
-    if (bit != -1) {
-      /* Mark the bit as allocated */
-      pool.bitmap[i] |= (1ULL << bit);
-      return i * 64 + bit;
-    }
+MemoryManager::MemoryManager() : central(std::make_shared<CentralPools>()), id(nextManagerId.fetch_add(1U)) {
+  for (uint32_t i = 0U; i < POOL_COUNT; i++) {
+    central->pools[i].blockSize = POOL_SIZES[i];
   }
-  return BLOCKS_PER_POOL; /* No free blocks found */
 }
 
-size_t MemoryManager::getBlockIndex(const Pool &pool, void *ptr) {
-  size_t offset = static_cast<char *>(ptr) - static_cast<char *>(pool.memory);
-  return offset / pool.blockSize;
+MemoryManager::~MemoryManager() {
+  /* The slabs go with the last reference to the pools. Thread caches only hold weak ones, so they drop their blocks untouched */
 }
 
-bool MemoryManager::isPointerInPool(const Pool &pool, void *ptr) {
-  char *charPtr = static_cast<char *>(ptr);
-  char *poolStart = static_cast<char *>(pool.memory);
-  char *poolEnd = poolStart + (pool.blockSize * BLOCKS_PER_POOL);
-  return charPtr >= poolStart && charPtr < poolEnd;
+MemoryManager &MemoryManager::getInstance() {
+  static MemoryManager *instance = new MemoryManager();
+  return *instance;
 }
 
-void *MemoryManager::allocate(size_t size) {
+uint32_t MemoryManager::getPoolIndex(size_t size) {
   /* Find the correct memory pool */
-  auto p_poolsizeIndex = std::lower_bound(POOL_SIZES, POOL_SIZES + sizeof(POOL_SIZES) / sizeof(POOL_SIZES[0]), size);
+  auto p_poolsizeIndex = std::lower_bound(POOL_SIZES, POOL_SIZES + POOL_COUNT, size);
+  return (p_poolsizeIndex == POOL_SIZES + POOL_COUNT) ? LARGE_ALLOCATION : static_cast<uint32_t>(p_poolsizeIndex - POOL_SIZES);
+}
 
-  /* Fallback for allocations bigger than the supported pool sizes */
-  if (p_poolsizeIndex == POOL_SIZES + sizeof(POOL_SIZES) / sizeof(POOL_SIZES[0])) {
-    return std::malloc(size);
+MemoryManager::SlabHeader *MemoryManager::getSlab(const void *ptr) {
+  /* Pool blocks are inside their slab and large allocations start one header past theirs, both round down to the header */
+  return reinterpret_cast<SlabHeader *>(reinterpret_cast<uintptr_t>(ptr) & ~(static_cast<uintptr_t>(SLAB_SIZE) - 1U));
+}
+
+MemoryManager::ThreadCache &MemoryManager::getThreadCache() {
+  thread_local ThreadCacheEntry entries[MAX_THREAD_CACHES];
+  thread_local uint32_t nextEntry = 0U;
+
+  for (ThreadCacheEntry &entry : entries) {
+    if (entry.managerId == id) {
+      return *entry.cache;
+    }
+  }
+
+  /* First allocation from this thread, take over the oldest entry. Its blocks go back to their manager if it still exists */
+  ThreadCacheEntry &entry = entries[nextEntry];
+  nextEntry = (nextEntry + 1U) % MAX_THREAD_CACHES;
+
+  entry.cache = std::make_unique<ThreadCache>();
+  entry.cache->central = central;
+  entry.cache->generation = central->generation.load(std::memory_order_acquire);
+  entry.managerId = id;
+  {
+    std::lock_guard<std::mutex> lock(central->cachesMutex);
+    central->caches.push_back(entry.cache.get());
   }
+  return *entry.cache;
+}
+
+void *MemoryManager::allocate(size_t size) {
+  uint32_t poolIndex = getPoolIndex(size);
 
-  size_t poolIndex = p_poolsizeIndex - POOL_SIZES;
-  Pool &pool = memoryPools[poolIndex];
+  /* Fallback for allocations bigger than the supported pool sizes */
+  if (poolIndex == LARGE_ALLOCATION) {
+    return allocateLarge(size);
+  }
 
-  /* Find a free block */
-  size_t blockIndex = findFreeBlock(pool);
+  ThreadCache &cache = getThreadCache();
+  if (cache.generation != central->generation.load(std::memory_order_acquire)) {
+    cache.drop();
+    cache.generation = central->generation.load(std::memory_order_acquire);
+  }
 
-  /* If the pool is full, fallback to malloc */
-  if (blockIndex >= BLOCKS_PER_POOL) {
-    return std::malloc(size);
+  if (!cache.blocks[poolIndex]) {
+    refill(cache, poolIndex);
   }
 
-  return static_cast<char *>(pool.memory) + (blockIndex * pool.blockSize);
+  FreeBlock *block = cache.blocks[poolIndex];
+  cache.blocks[poolIndex] = block->next;
+  cache.counts[poolIndex]--;
+  increment(cache.counters.allocations[poolIndex]);
+  return block;
 }
 
 void MemoryManager::deallocate(void *ptr) {
   if (!ptr)
     return;
 
-  for (Pool &pool : memoryPools) {
-    if (isPointerInPool(pool, ptr)) {
-      int blockIndex = getBlockIndex(pool, ptr);
-      int wordIndex = blockIndex / 64;
-      int bitIndex = blockIndex % 64;
+  SlabHeader *slab = getSlab(ptr);
+  if (slab->poolIndex == LARGE_ALLOCATION) {
+    deallocateLarge(slab);
+    return;
+  }
 
-      /* Mark as unused */
-      pool.bitmap[wordIndex] &= ~(1ULL << bitIndex);
-    }
+  ThreadCache &cache = getThreadCache();
+  if (cache.generation != central->generation.load(std::memory_order_acquire)) {
+    cache.drop();
+    cache.generation = central->generation.load(std::memory_order_acquire);
+  }
+
+  /* Mark as unused. The block goes to this thread's cache, whichever thread allocated it */
+  FreeBlock *block = static_cast<FreeBlock *>(ptr);
+  block->next = cache.blocks[slab->poolIndex];
+  cache.blocks[slab->poolIndex] = block;
+  cache.counts[slab->poolIndex]++;
+  increment(cache.counters.frees[slab->poolIndex]);
+
+  if (cache.counts[slab->poolIndex] > getCacheCapacity(slab->poolIndex)) {
+    flush(*central, cache, slab->poolIndex, getCacheCapacity(slab->poolIndex) / 2U);
   }
 }
 
@@ -102,48 +182,436 @@ void *MemoryManager::reallocate(void *ptr, size_t newSize) {
   if (!ptr)
     return allocate(newSize);
 
-  for (Pool &pool : memoryPools) {
-    if (isPointerInPool(pool, ptr)) {
-      /* If the pointer fits in the current pool return the same pointer */
-      if (newSize <= pool.blockSize)
-        return ptr;
-
-      /* Allocate new block and copy the data */
-      void *newPtr = allocate(newSize);
-      if (newPtr) {
-        std::memcpy(newPtr, ptr, pool.blockSize);
-        deallocate(ptr);
-      }
+  /* If the new size still fits the block return the same pointer */
+  size_t blockSize = getBlockSize(ptr);
+  if (newSize <= blockSize)
+    return ptr;
+
+  /* Allocate new block and copy the data */
+  void *newPtr = allocate(newSize);
+  std::memcpy(newPtr, ptr, blockSize);
+  deallocate(ptr);
+  return newPtr;
+}
 
-      return newPtr;
+size_t MemoryManager::getBlockSize(const void *ptr) const {
+  const SlabHeader *slab = getSlab(ptr);
+  return (slab->poolIndex == LARGE_ALLOCATION) ? slab->size : POOL_SIZES[slab->poolIndex];
+}
+
+std::vector<SizeClassStats> MemoryManager::getStats() const {
+  std::vector<SizeClassStats> stats(POOL_COUNT + 1U);
+
+  {
+    std::lock_guard<std::mutex> lock(central->cachesMutex);
+    for (uint32_t i = 0U; i < POOL_COUNT; i++) {
+      stats[i].allocations = central->retiredAllocations[i];
+      stats[i].frees = central->retiredFrees[i];
+      for (const ThreadCache *cache : central->caches) {
+        stats[i].allocations += cache->counters.allocations[i].load(std::memory_order_relaxed);
+        stats[i].frees += cache->counters.frees[i].load(std::memory_order_relaxed);
+      }
     }
   }
 
-  /* If the size is not supported, use built in realloc */
-  return std::realloc(ptr, newSize);
+  for (uint32_t i = 0U; i < POOL_COUNT; i++) {
+    Pool &pool = central->pools[i];
+    std::lock_guard<std::mutex> lock(pool.mutex);
+
+    SizeClassStats &row = stats[i];
+    row.blockSize = pool.blockSize;
+    row.highWater = pool.highWater;
+    row.fallbacks = 0U;
+    row.slabs = pool.slabCount;
+
+    /* Slab headers and the tail too small for a block count as fragmentation, as do free blocks */
+    double reserved = static_cast<double>(pool.slabCount * SLAB_SIZE);
+    double live = static_cast<double>((row.allocations - std::min(row.frees, row.allocations)) * pool.blockSize);
+    row.fragmentation = (reserved > 0.0) ? std::max(0.0, 1.0 - (live / reserved)) : 0.0;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(central->largeMutex);
+    SizeClassStats &row = stats[POOL_COUNT];
+    row.blockSize = 0U;
+    row.allocations = central->largeAllocations;
+    row.frees = central->largeFrees;
+    row.highWater = central->largeHighWater;
+    row.fallbacks = central->largeReservations;
+    row.slabs = 0U;
+    row.fragmentation = (central->largeReservedBytes > 0U)
+                            ? 1.0 - (static_cast<double>(central->largeRequestedBytes) / static_cast<double>(central->largeReservedBytes))
+                            : 0.0;
+  }
+
+  return stats;
 }
 
-void MemoryManager::initializePools() {
-  /* One pool for each memory pool size */
-  memoryPools.resize(sizeof(POOL_SIZES) / sizeof(POOL_SIZES[0]));
+SystemMemoryStats MemoryManager::getSystemStats() const {
+  std::lock_guard<std::mutex> lock(central->systemMutex);
+  return central->systemStats;
+}
 
-  for (size_t i = 0; i < memoryPools.size(); i++) {
-    Pool &pool = memoryPools[i];
-    pool.blockSize = POOL_SIZES[i];
+void MemoryManager::writeStatsJson(std::ostream &out) const {
+  std::vector<SizeClassStats> stats = getStats();
+  SystemMemoryStats system = getSystemStats();
 
-    /* Allocate pool memory */
-    pool.memory = std::malloc(pool.blockSize * BLOCKS_PER_POOL);
+  out << "{\n  \"sizeClasses\": [\n";
+  for (size_t i = 0U; i < stats.size(); i++) {
+    const SizeClassStats &row = stats[i];
+    out << "    {\"blockSize\": " << row.blockSize << ", \"allocations\": " << row.allocations << ", \"frees\": " << row.frees
+        << ", \"highWater\": " << row.highWater << ", \"fallbacks\": " << row.fallbacks << ", \"slabs\": " << row.slabs
+        << ", \"fragmentation\": " << row.fragmentation << "}" << ((i + 1U < stats.size()) ? ",\n" : "\n");
+  }
+  out << "  ],\n";
+  out << "  \"system\": {\"reservations\": " << system.reservations << ", \"reserveSeconds\": " << system.reserveSeconds
+      << ", \"prefaultFaults\": " << system.prefaultFaults << ", \"mappedBytes\": " << system.mappedBytes << ", \"hugePageBytes\": " << system.hugePageBytes
+      << ", \"mapFailures\": " << system.mapFailures << ", \"hugePageFailures\": " << system.hugePageFailures << "}\n";
+  out << "}\n";
+}
+
+void MemoryManager::initializePools(const PoolOptions &options) {
+  {
+    std::lock_guard<std::mutex> lock(central->systemMutex);
+    central->options = options;
+  }
+  {
+    std::lock_guard<std::mutex> lock(central->largeMutex);
+    central->largeCacheLimit = options.largeCacheBytes;
+  }
 
-    /* Initialize the bitmap to 0 */
-    std::memset(pool.bitmap, 0, sizeof(pool.bitmap));
+  /* The first slabs for each memory pool size */
+  for (uint32_t i = 0U; i < POOL_COUNT; i++) {
+    Pool &pool = central->pools[i];
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    while (pool.slabCount < options.slabsPerPool) {
+      addSlab(pool, i);
+    }
   }
 }
 
 void MemoryManager::cleanupPools() {
-  for (Pool &pool : memoryPools) {
-    std::free(pool.memory);
+  central->generation.fetch_add(1U, std::memory_order_acq_rel);
+  central->releaseSlabs();
+}
+
+void MemoryManager::refill(ThreadCache &cache, uint32_t poolIndex) {
+  Pool &pool = central->pools[poolIndex];
+  std::lock_guard<std::mutex> lock(pool.mutex);
+
+  if (!pool.freeList) {
+    addSlab(pool, poolIndex);
   }
-  memoryPools.clear();
+
+  /* Move a batch over so the next allocations don't lock */
+  const uint32_t batch = getCacheCapacity(poolIndex) / 2U;
+  for (uint32_t i = 0U; i < batch && pool.freeList; i++) {
+    FreeBlock *block = pool.freeList;
+    pool.freeList = block->next;
+    block->next = cache.blocks[poolIndex];
+    cache.blocks[poolIndex] = block;
+    cache.counts[poolIndex]++;
+    pool.checkedOut++;
+  }
+  pool.highWater = std::max(pool.highWater, pool.checkedOut);
+}
+
+void MemoryManager::flush(CentralPools &central, ThreadCache &cache, uint32_t poolIndex, uint32_t count) {
+  Pool &pool = central.pools[poolIndex];
+  std::lock_guard<std::mutex> lock(pool.mutex);
+
+  for (uint32_t i = 0U; i < count && cache.blocks[poolIndex]; i++) {
+    FreeBlock *block = cache.blocks[poolIndex];
+    cache.blocks[poolIndex] = block->next;
+    cache.counts[poolIndex]--;
+    block->next = pool.freeList;
+    pool.freeList = block;
+    pool.checkedOut--;
+  }
+}
+
+void MemoryManager::addSlab(Pool &pool, uint32_t poolIndex) {
+  SlabHeader *slab = central->takeSlab();
+  slab->poolIndex = poolIndex;
+  slab->next = pool.slabs;
+  slab->size = SLAB_SIZE - SLAB_HEADER_SIZE;
+  slab->requestedSize = 0U;
+  pool.slabs = slab;
+  pool.slabCount++;
+
+  /* Thread every block of the slab onto the free list, in address order */
+  char *first = reinterpret_cast<char *>(slab) + SLAB_HEADER_SIZE;
+  size_t blockCount = (SLAB_SIZE - SLAB_HEADER_SIZE) / pool.blockSize;
+  for (size_t i = blockCount; i-- > 0U;) {
+    FreeBlock *block = reinterpret_cast<FreeBlock *>(first + (i * pool.blockSize));
+    block->next = pool.freeList;
+    pool.freeList = block;
+  }
+}
+
+void *MemoryManager::allocateLarge(size_t size) {
+  /* Rounded to whole slabs so the header can be found the same way as a pool block's */
+  size_t total = ((size + SLAB_HEADER_SIZE + SLAB_SIZE - 1U) / SLAB_SIZE) * SLAB_SIZE;
+  size_t slabCount = total / SLAB_SIZE;
+  SlabHeader *slab = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(central->largeMutex);
+    if (slabCount <= LARGE_CACHE_SLABS && central->largeCache[slabCount - 1U]) {
+      slab = central->largeCache[slabCount - 1U];
+      central->largeCache[slabCount - 1U] = slab->next;
+      central->largeCachedBytes -= total;
+    }
+  }
+
+  if (!slab) {
+    MemorySource source;
+    slab = static_cast<SlabHeader *>(central->reserve(total, (total >= HUGE_PAGE_SIZE) ? HUGE_PAGE_SIZE : SLAB_SIZE, source));
+    slab->source = source;
+
+    std::lock_guard<std::mutex> lock(central->largeMutex);
+    central->largeReservations++;
+  }
+
+  slab->poolIndex = LARGE_ALLOCATION;
+  slab->next = nullptr;
+  slab->size = total - SLAB_HEADER_SIZE;
+  slab->requestedSize = size;
+
+  {
+    std::lock_guard<std::mutex> lock(central->largeMutex);
+    central->largeAllocations++;
+    central->largeHighWater = std::max(central->largeHighWater, central->largeAllocations - central->largeFrees);
+    central->largeRequestedBytes += size;
+    central->largeReservedBytes += total;
+  }
+
+  return reinterpret_cast<char *>(slab) + SLAB_HEADER_SIZE;
+}
+
+void MemoryManager::deallocateLarge(SlabHeader *slab) {
+  size_t total = slab->size + SLAB_HEADER_SIZE;
+  size_t slabCount = total / SLAB_SIZE;
+
+  {
+    std::lock_guard<std::mutex> lock(central->largeMutex);
+    central->largeFrees++;
+    central->largeRequestedBytes -= slab->requestedSize;
+    central->largeReservedBytes -= total;
+
+    /* Kept for the next request of the same slab count while the cache has room, otherwise back to the system */
+    if (slabCount <= LARGE_CACHE_SLABS && central->largeCachedBytes + total <= central->largeCacheLimit) {
+      slab->next = central->largeCache[slabCount - 1U];
+      central->largeCache[slabCount - 1U] = slab;
+      central->largeCachedBytes += total;
+      return;
+    }
+  }
+
+  central->release(slab, total, slab->source);
+}
+
+void *MemoryManager::do_allocate(size_t bytes, size_t alignment) {
+  if (alignment > SLAB_HEADER_SIZE) {
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  /* A size class at least as big as the alignment is aligned to it, up to the 64 bytes the slab header keeps */
+  return allocate(std::max(bytes, alignment));
+}
+
+void MemoryManager::do_deallocate(void *ptr, size_t bytes, size_t alignment) {
+  if (alignment > SLAB_HEADER_SIZE) {
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    return;
+  }
+
+  deallocate(ptr);
+}
+
+bool MemoryManager::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
+
+MemoryManager::CentralPools::~CentralPools() {
+  releaseSlabs();
+}
+
+void MemoryManager::CentralPools::releaseSlabs() {
+  for (Pool &pool : pools) {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    while (pool.slabs) {
+      SlabHeader *next = pool.slabs->next;
+      if (pool.slabs->source != MemorySource::CHUNK) {
+        release(pool.slabs, SLAB_SIZE, pool.slabs->source);
+      }
+      pool.slabs = next;
+    }
+    pool.freeList = nullptr;
+    pool.slabCount = 0U;
+    pool.checkedOut = 0U;
+  }
+
+  /* Cached large allocations were each reserved on their own */
+  {
+    std::lock_guard<std::mutex> lock(largeMutex);
+    for (SlabHeader *&cached : largeCache) {
+      while (cached) {
+        SlabHeader *next = cached->next;
+        release(cached, cached->size + SLAB_HEADER_SIZE, cached->source);
+        cached = next;
+      }
+    }
+    largeCachedBytes = 0U;
+  }
+
+  /* Slabs carved from chunks go with their chunk */
+  std::vector<Chunk> released;
+  {
+    std::lock_guard<std::mutex> lock(systemMutex);
+    released.swap(chunks);
+    spareSlabs = nullptr;
+  }
+  for (const Chunk &chunk : released) {
+    release(chunk.memory, HUGE_PAGE_SIZE, chunk.source);
+  }
+}
+
+void *MemoryManager::CentralPools::reserve(size_t size, size_t alignment, MemorySource &source) {
+  auto start = std::chrono::steady_clock::now();
+  PoolOptions current;
+  {
+    std::lock_guard<std::mutex> lock(systemMutex);
+    current = options;
+  }
+
+  void *memory = current.mapMemory ? mapAligned(size, alignment) : nullptr;
+  bool mapFailed = current.mapMemory && !memory;
+  bool hugePages = false;
+  bool hugePagesFailed = false;
+
+  if (memory) {
+#if defined(MADV_HUGEPAGE)
+    if (current.hugePages) {
+      hugePages = madvise(memory, size, MADV_HUGEPAGE) == 0;
+      hugePagesFailed = !hugePages;
+    }
+#else
+    hugePagesFailed = current.hugePages;
+#endif
+    source = hugePages ? MemorySource::HUGE_PAGES : MemorySource::MAPPED;
+  } else {
+    /* Heap memory, either asked for or because mapping failed */
+    source = MemorySource::HEAP;
+    memory = std::aligned_alloc(alignment, size);
+    if (!memory) {
+      throw std::bad_alloc();
+    }
+  }
+
+  uint64_t faults = 0U;
+  if (current.prefault) {
+    /* Writing one byte per page is enough to fault it in, a huge page takes the first write only */
+    uint64_t faultsBefore = getPageFaults();
+    const size_t pageSize = 4096U;
+    volatile char *bytes = static_cast<volatile char *>(memory);
+    for (size_t offset = 0U; offset < size; offset += pageSize) {
+      bytes[offset] = 0;
+    }
+    faults = getPageFaults() - faultsBefore;
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::lock_guard<std::mutex> lock(systemMutex);
+  systemStats.reservations++;
+  systemStats.reserveSeconds += elapsed.count();
+  systemStats.prefaultFaults += faults;
+  systemStats.mappedBytes += (source != MemorySource::HEAP) ? size : 0U;
+  systemStats.hugePageBytes += hugePages ? size : 0U;
+  systemStats.mapFailures += mapFailed ? 1U : 0U;
+  systemStats.hugePageFailures += hugePagesFailed ? 1U : 0U;
+  return memory;
+}
+
+void MemoryManager::CentralPools::release(void *memory, size_t size, MemorySource source) {
+  if (source == MemorySource::HEAP) {
+    std::free(memory);
+    return;
+  }
+
+#if defined(__unix__)
+  {
+    std::lock_guard<std::mutex> lock(systemMutex);
+    systemStats.mappedBytes -= size;
+    systemStats.hugePageBytes -= (source == MemorySource::HUGE_PAGES) ? size : 0U;
+  }
+  munmap(memory, size);
+#endif
+}
+
+MemoryManager::SlabHeader *MemoryManager::CentralPools::takeSlab() {
+  PoolOptions current;
+  {
+    std::lock_guard<std::mutex> lock(systemMutex);
+    current = options;
+    if (current.mapMemory && spareSlabs) {
+      SlabHeader *slab = spareSlabs;
+      spareSlabs = slab->next;
+      return slab;
+    }
+  }
+
+  MemorySource source;
+  if (!current.mapMemory) {
+    SlabHeader *slab = static_cast<SlabHeader *>(reserve(SLAB_SIZE, SLAB_SIZE, source));
+    slab->source = source;
+    return slab;
+  }
+
+  /* Map a whole huge page worth of slabs at once, so the kernel can back them with one huge page */
+  char *chunk = static_cast<char *>(reserve(HUGE_PAGE_SIZE, HUGE_PAGE_SIZE, source));
+
+  std::lock_guard<std::mutex> lock(systemMutex);
+  chunks.push_back(Chunk{chunk, source});
+  for (size_t offset = HUGE_PAGE_SIZE; offset > SLAB_SIZE; offset -= SLAB_SIZE) {
+    SlabHeader *slab = reinterpret_cast<SlabHeader *>(chunk + offset - SLAB_SIZE);
+    slab->source = MemorySource::CHUNK;
+    slab->next = spareSlabs;
+    spareSlabs = slab;
+  }
+
+  SlabHeader *first = reinterpret_cast<SlabHeader *>(chunk);
+  first->source = MemorySource::CHUNK;
+  return first;
+}
+
+MemoryManager::ThreadCache::~ThreadCache() {
+  /* Hand the cached blocks back, unless the manager and all its slabs are already gone */
+  std::shared_ptr<CentralPools> pools = central.lock();
+  if (!pools) {
+    return;
+  }
+
+  if (generation == pools->generation.load(std::memory_order_acquire)) {
+    for (uint32_t i = 0U; i < POOL_COUNT; i++) {
+      flush(*pools, *this, i, counts[i]);
+    }
+  }
+
+  /* Keep the counts for the stats */
+  std::lock_guard<std::mutex> lock(pools->cachesMutex);
+  for (uint32_t i = 0U; i < POOL_COUNT; i++) {
+    pools->retiredAllocations[i] += counters.allocations[i].load(std::memory_order_relaxed);
+    pools->retiredFrees[i] += counters.frees[i].load(std::memory_order_relaxed);
+  }
+  pools->caches.erase(std::find(pools->caches.begin(), pools->caches.end(), this));
+}
+
+void MemoryManager::ThreadCache::drop() {
+  /* The blocks belonged to slabs that have been released, forget them without touching them */
+  std::fill(std::begin(blocks), std::end(blocks), nullptr);
+  std::fill(std::begin(counts), std::end(counts), 0U);
 }
 
 /** @} */
@@ -0,0 +1,116 @@
+/*******************************************************************************************************************************
+ * @file   profiler.cc
+ *
+ * @brief  Source file for the built-in instrumentation scopes and Chrome trace export
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <cstdio>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "profiler.h"
+
+namespace {
+/* Buffer of the calling thread. Buffers belong to the profiler and outlive their thread, so a trace keeps finished threads */
+thread_local void *currentBuffer = nullptr;
+
+void writeTimestamp(std::ostream &out, uint64_t nanoseconds) {
+  /* Trace timestamps are in microseconds, fractions keep the nanoseconds */
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(nanoseconds) * 1.0e-3);
+  out << buffer;
+}
+}  // namespace
+
+Profiler &Profiler::getInstance() {
+  /* Never destroyed, threads may still record while static destructors run */
+  static Profiler *instance = new Profiler();
+  return *instance;
+}
+
+void Profiler::setCapturing(bool capturing, bool jobs) {
+  capturingJobs.store(capturing && jobs, std::memory_order_relaxed);
+  this->capturing.store(capturing, std::memory_order_relaxed);
+}
+
+void Profiler::recordScope(const char *name, uint64_t startNs, uint64_t durationNs, const char *argName, uint64_t value) {
+  getThreadBuffer().events.push_back(ProfileEvent{name, argName, startNs, durationNs, value, false});
+}
+
+void Profiler::recordCounter(const char *name, uint64_t value) {
+  if (isCapturing()) {
+    getThreadBuffer().events.push_back(ProfileEvent{name, nullptr, now(), 0U, value, true});
+  }
+}
+
+void Profiler::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (std::unique_ptr<ThreadBuffer> &thread : threads) {
+    thread->events.clear();
+  }
+}
+
+size_t Profiler::getEventCount() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t count = 0U;
+  for (const std::unique_ptr<ThreadBuffer> &thread : threads) {
+    count += thread->events.size();
+  }
+  return count;
+}
+
+void Profiler::writeChromeTrace(std::ostream &out) const {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  uint64_t epochNs = UINT64_MAX;
+  for (const std::unique_ptr<ThreadBuffer> &thread : threads) {
+    for (const ProfileEvent &event : thread->events) {
+      epochNs = std::min(epochNs, event.startNs);
+    }
+  }
+
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+  bool first = true;
+  for (const std::unique_ptr<ThreadBuffer> &thread : threads) {
+    out << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread->threadId << ", \"args\": {\"name\": \"thread "
+        << thread->threadId << "\"}}";
+    first = false;
+
+    for (const ProfileEvent &event : thread->events) {
+      out << ",\n{\"name\": \"" << event.name << "\", \"cat\": \"physics\", \"pid\": 1, \"tid\": " << thread->threadId << ", \"ts\": ";
+      writeTimestamp(out, event.startNs - epochNs);
+
+      if (event.counter) {
+        out << ", \"ph\": \"C\", \"args\": {\"value\": " << event.value << "}}";
+        continue;
+      }
+
+      out << ", \"ph\": \"X\", \"dur\": ";
+      writeTimestamp(out, event.durationNs);
+      if (event.argName) {
+        out << ", \"args\": {\"" << event.argName << "\": " << event.value << "}";
+      }
+      out << "}";
+    }
+  }
+  out << "\n]}\n";
+}
+
+Profiler::ThreadBuffer &Profiler::getThreadBuffer() {
+  if (!currentBuffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+    buffer->threadId = static_cast<uint32_t>(threads.size());
+    buffer->events.reserve(INITIAL_EVENT_CAPACITY);
+    currentBuffer = buffer.get();
+    threads.push_back(std::move(buffer));
+  }
+
+  return *static_cast<ThreadBuffer *>(currentBuffer);
+}
@@ -0,0 +1,102 @@
+/*******************************************************************************************************************************
+ * @file   quaternion.cc
+ *
+ * @brief  Source file for a quaternion library
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cmath>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "quaternion.h"
+
+Quaternion::Quaternion() {
+  this->w = 1.0f;
+  this->x = 0.0f;
+  this->y = 0.0f;
+  this->z = 0.0f;
+}
+
+Quaternion::Quaternion(float w, float x, float y, float z) {
+  this->w = w;
+  this->x = x;
+  this->y = y;
+  this->z = z;
+}
+
+Quaternion Quaternion::fromAxisAngle(const Vector3D &axis, float angle) {
+  Vector3D unitAxis = axis.normalize();
+  float halfSin = std::sin(angle * 0.5f);
+
+  return Quaternion(std::cos(angle * 0.5f), unitAxis.x * halfSin, unitAxis.y * halfSin, unitAxis.z * halfSin);
+}
+
+Quaternion Quaternion::fromMatrix(const Matrix3D &rotation) {
+  const float(&m)[3][3] = rotation.matrix;
+  float trace = m[0][0] + m[1][1] + m[2][2];
+
+  /* Branch on the largest component so the square root never sees a tiny value */
+  if (trace > 0.0f) {
+    float s = std::sqrt(trace + 1.0f) * 2.0f;
+    return Quaternion(0.25f * s, (m[2][1] - m[1][2]) / s, (m[0][2] - m[2][0]) / s, (m[1][0] - m[0][1]) / s).normalize();
+  } else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+    float s = std::sqrt(1.0f + m[0][0] - m[1][1] - m[2][2]) * 2.0f;
+    return Quaternion((m[2][1] - m[1][2]) / s, 0.25f * s, (m[0][1] + m[1][0]) / s, (m[0][2] + m[2][0]) / s).normalize();
+  } else if (m[1][1] > m[2][2]) {
+    float s = std::sqrt(1.0f + m[1][1] - m[0][0] - m[2][2]) * 2.0f;
+    return Quaternion((m[0][2] - m[2][0]) / s, (m[0][1] + m[1][0]) / s, 0.25f * s, (m[1][2] + m[2][1]) / s).normalize();
+  } else {
+    float s = std::sqrt(1.0f + m[2][2] - m[0][0] - m[1][1]) * 2.0f;
+    return Quaternion((m[1][0] - m[0][1]) / s, (m[0][2] + m[2][0]) / s, (m[1][2] + m[2][1]) / s, 0.25f * s).normalize();
+  }
+}
+
+float Quaternion::lengthSquared() const {
+  return (this->w * this->w) + (this->x * this->x) + (this->y * this->y) + (this->z * this->z);
+}
+
+float Quaternion::length() const {
+  return std::sqrt(lengthSquared());
+}
+
+Quaternion Quaternion::normalize() const {
+  float quaternionLength = length();
+  return quaternionLength > 0.0f ? (*this * (1.0f / quaternionLength)) : Quaternion();
+}
+
+Quaternion Quaternion::conjugate() const {
+  return Quaternion(this->w, -this->x, -this->y, -this->z);
+}
+
+Vector3D Quaternion::rotate(const Vector3D &vector) const {
+  /* v' = v + 2w(q x v) + 2q x (q x v), cheaper than the two full products of q * v * q^-1 */
+  Vector3D axis(this->x, this->y, this->z);
+  Vector3D twiceCross = axis.crossProduct(vector) * 2.0f;
+
+  return vector + (twiceCross * this->w) + axis.crossProduct(twiceCross);
+}
+
+Quaternion Quaternion::integrate(const Vector3D &angularVelocity, float deltaTime) const {
+  Quaternion spin(0.0f, angularVelocity.x, angularVelocity.y, angularVelocity.z);
+  return (*this + (spin * *this) * (0.5f * deltaTime)).normalize();
+}
+
+Matrix3D Quaternion::toMatrix() const {
+  float xx = this->x * this->x;
+  float yy = this->y * this->y;
+  float zz = this->z * this->z;
+  float xy = this->x * this->y;
+  float xz = this->x * this->z;
+  float yz = this->y * this->z;
+  float wx = this->w * this->x;
+  float wy = this->w * this->y;
+  float wz = this->w * this->z;
+
+  return Matrix3D(1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz), 2.0f * (xz + wy), 2.0f * (xy + wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx), 2.0f * (xz - wy),
+                  2.0f * (yz + wx), 1.0f - 2.0f * (xx + yy));
+}
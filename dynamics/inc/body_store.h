@@ -0,0 +1,230 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   body_store.h
+ *
+ * @brief  Header file for the structure of arrays rigid body storage
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/* Inter-component Headers */
+#include "aligned_array.h"
+#include "matrix_3d.h"
+#include "quaternion.h"
+#include "shape.h"
+#include "vector_3d.h"
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup DynamicsModules
+ * @brief    Dynamics modules to interactions
+ * @{
+ */
+
+class RigidBody;
+
+/**
+ * @brief   Generational handle to a body
+ * @details The index picks a slot in the store's handle table and the generation must match the slot's, so a handle to a destroyed
+ *          body is detected in O(1) even after its slot has been reused. A default constructed handle is never valid
+ */
+struct BodyId {
+  uint32_t index{0xFFFFFFFFU}; /**< Slot in the handle table */
+  uint32_t generation{0U};     /**< Generation of the slot when the handle was issued, live generations start at 1 */
+
+  bool operator==(const BodyId &other) const {
+    return index == other.index && generation == other.generation;
+  }
+
+  bool operator!=(const BodyId &other) const {
+    return !(*this == other);
+  }
+};
+
+/**
+ * @brief   Everything needed to create a body. Many bodies can share one shape
+ */
+struct BodyDesc {
+  std::shared_ptr<Shape> shape;
+  Vector3D position;
+  Quaternion orientation;
+  Vector3D linearVelocity;
+  Vector3D angularVelocity;
+};
+
+/**
+ * @brief   Collision data of every sphere in a store, packed together so narrowphase kernels only stream what they need
+ */
+struct SpherePool {
+  AlignedArray<float> radius;
+  AlignedArray<uint32_t> body; /**< Store index of the body each entry belongs to */
+};
+
+/**
+ * @brief   Structure of arrays storage for rigid body state
+ * @details Every body is one index into a set of contiguous, cache line aligned columns, so the simulation loops stream through
+ *          memory instead of chasing pointers. Removal swaps the last body into the hole, so dense indices are not stable. BodyId
+ *          handles are, and map to the dense index through the handle table in O(1)
+ */
+class BodyStore {
+ public:
+  static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFU;
+
+  // State
+  Vector3DArray position;
+  QuaternionArray orientation;
+  Vector3DArray linearVelocity;
+  Vector3DArray angularVelocity;
+
+  // Force accumulators
+  Vector3DArray force;
+  Vector3DArray torque;
+
+  // Cached physics properties
+  AlignedArray<float> inverseMass;
+  Vector3DArray inverseInertia;       /**< Diagonal of the body space inverse inertia tensor */
+  AlignedArray<float> boundingRadius; /**< Largest half extent of the shape's bounding box */
+  AlignedArray<ShapeType> shapeType;  /**< Picks the shape pool and the narrowphase routine */
+  AlignedArray<uint32_t> shapeIndex;  /**< Entry of the body's shape in the pool of its type */
+  AlignedArray<uint32_t> broadphaseProxy;
+  AlignedArray<BodyId> ids; /**< Handle of the body at each dense index */
+
+  // Shape pools, one per shape type
+  SpherePool spheres;
+
+  // Sleeping
+  AlignedArray<float> sleepTime;      /**< How long the body has been under the sleep velocity thresholds */
+  AlignedArray<uint32_t> sleepIsland; /**< Sleeping island the body belongs to, or INVALID_INDEX while awake */
+
+  // Cold data
+  std::vector<std::shared_ptr<Shape>> shapes;
+  std::vector<RigidBody *> views; /**< RigidBody bound to each index, or nullptr */
+
+  size_t size() const;
+  void reserve(size_t capacity);
+
+  /**
+   * @brief   Remove every body. All outstanding handles become invalid
+   */
+  void clear();
+
+  /**
+   * @brief   Append a body, with mass properties taken from its shape
+   */
+  BodyId add(const BodyDesc &desc, RigidBody *view);
+
+  /**
+   * @brief   Append a copy of a body from another store
+   */
+  BodyId addCopy(const BodyStore &source, uint32_t sourceIndex, RigidBody *view);
+
+  /**
+   * @brief   Swap remove a body, O(1). The last body moves into its dense index
+   */
+  void remove(BodyId id);
+
+  bool isValid(BodyId id) const;
+
+  /**
+   * @brief   Dense index of a live body. The handle must be valid
+   */
+  uint32_t indexOf(BodyId id) const {
+    return slots[id.index].index;
+  }
+
+  /**
+   * @brief   Radius of a body whose shape is a sphere
+   */
+  float getSphereRadius(uint32_t index) const {
+    return spheres.radius[shapeIndex[index]];
+  }
+
+  bool isAwake(uint32_t index) const {
+    return sleepIsland[index] == INVALID_INDEX;
+  }
+
+  /**
+   * @brief   Put a group of touching bodies to sleep together. Their velocities are zeroed
+   * @param   indices Dense indices of the bodies in the island
+   */
+  void sleep(const uint32_t *indices, size_t count);
+
+  /**
+   * @brief   Wake a body and every other body asleep in its island, O(island size)
+   */
+  void wake(uint32_t index);
+
+  /**
+   * @brief   World space inverse inertia tensor of a body (R * I^-1 * R^T)
+   */
+  Matrix3D getWorldInverseInertia(uint32_t index) const;
+
+  /**
+   * @brief   Apply gravity and the accumulated forces to a body's velocities, then clear its force accumulators
+   */
+  void integrateVelocity(uint32_t index, float deltaTime, const Vector3D &gravity);
+
+  /**
+   * @brief   Move a body along its velocities
+   */
+  void integratePosition(uint32_t index, float deltaTime);
+
+  /**
+   * @brief   Semi-implicit Euler step for one body (Velocity then position), then clears its force accumulators
+   */
+  void integrateBody(uint32_t index, float deltaTime, const Vector3D &gravity);
+
+  /**
+   * @brief   integrateVelocity for a list of bodies, a SIMD pack of bodies at a time
+   * @details Every listed body must be dynamic, there is no per body mass check. Runs of consecutive indices are loaded
+   *          straight from the columns, anything else is gathered
+   * @param   indices Dense indices of the bodies, each listed once
+   * @param   count Number of indices
+   */
+  void integrateVelocities(const uint32_t *indices, uint32_t count, float deltaTime, const Vector3D &gravity);
+
+  /**
+   * @brief   integratePosition for a list of dynamic bodies, a SIMD pack of bodies at a time
+   */
+  void integratePositions(const uint32_t *indices, uint32_t count, float deltaTime);
+
+ private:
+  friend class PhysicsWorld; /**< Snapshots save and restore the handle table and sleeping islands */
+
+  struct Slot {
+    uint32_t index;      /**< Dense index while in use, next free slot while free */
+    uint32_t generation; /**< Generation handed out with the current (Or next) handle */
+  };
+
+  std::vector<Slot> slots;
+  uint32_t freeSlotHead{INVALID_INDEX};
+
+  /* Handles of the bodies in each sleeping island. Handles of bodies removed while asleep go stale and are skipped on wake */
+  std::vector<std::vector<BodyId>> sleepingIslands;
+  std::vector<uint32_t> freeIslands;
+
+  BodyId allocateSlot(uint32_t denseIndex);
+  void releaseSlot(uint32_t slot);
+
+  /**
+   * @brief   Add the collision data of the body at index to the pool of its shape type and record the entry
+   */
+  void addShape(uint32_t index, const Shape &shape);
+  void addShapeCopy(uint32_t index, const BodyStore &source, uint32_t sourceIndex);
+  void removeShape(uint32_t index);
+
+  /**
+   * @brief   Owning body of each entry in the pool of a shape type
+   */
+  AlignedArray<uint32_t> &getShapeOwners(ShapeType type);
+};
+
+/** @} */
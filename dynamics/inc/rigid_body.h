@@ -14,10 +14,12 @@
 
 /* Inter-component Headers */
 #include "matrix_3d.h"
+#include "memory_manager.h"
 #include "shape.h"
 #include "vector_3d.h"
 
 /* Intra-component Headers */
+#include "body_store.h"
 
 /**
  * @defgroup DynamicsModules
@@ -25,33 +27,52 @@
  * @{
  */
 
+/**
+ * @brief   View of one body in a BodyStore
+ * @details All state lives in the store and is reached through the body's generational handle. A body that isn't part of a world
+ *          keeps a private single body store, and is moved into the world's store when added
+ */
 class RigidBody {
  private:
-  std::shared_ptr<Shape> shape;
+  friend class PhysicsWorld;
 
-  // State variables
-  Vector3D position;
-  Matrix3D orientation;
-  Vector3D linearVelocity;
-  Vector3D angularVelocity;
+  BodyStore *store;
+  BodyId id;
+  std::unique_ptr<BodyStore> detachedStore; /**< Storage used while the body isn't in a world */
 
-  // Force accumulators
-  Vector3D force;
-  Vector3D torque;
+  /**
+   * @brief   View of a body that already lives in a store
+   */
+  RigidBody(BodyStore *store, BodyId id);
 
-  // Cached physics properties
-  float mass;
-  float inverseMass;
-  Matrix3D inertiaTensor;
-  Matrix3D inverseInertiaTensor;
+  uint32_t index() const {
+    return store->indexOf(id);
+  }
 
-  void updateInertiaTensor();
+  void attach(BodyStore *newStore);
+  void detach();
 
  public:
   explicit RigidBody(std::shared_ptr<Shape> shape);
+  ~RigidBody();
+
+  RigidBody(const RigidBody &) = delete;
+  RigidBody &operator=(const RigidBody &) = delete;
+
+  /**
+   * @brief   Bodies live in the engine's MemoryManager, see Shape::operator new
+   */
+  static void *operator new(size_t size) {
+    return MemoryManager::getInstance().allocate(size);
+  }
+
+  static void operator delete(void *ptr) {
+    MemoryManager::getInstance().deallocate(ptr);
+  }
 
-  // State
+  // State. Changing a sleeping body's state or pushing it wakes its island
   void setPosition(const Vector3D &pos);
+  void setOrientation(const Quaternion &orient);
   void setOrientation(const Matrix3D &orient);
   void setLinearVelocity(const Vector3D &vel);
   void setAngularVelocity(const Vector3D &angVel);
@@ -64,14 +85,37 @@ class RigidBody {
 
   // Getters
   Vector3D getPosition() const;
-  Matrix3D getOrientation() const;
+  Quaternion getOrientation() const;
+
+  /**
+   * @brief   Rotation matrix of the orientation, derived on every call
+   */
+  Matrix3D getRotationMatrix() const;
   Vector3D getLinearVelocity() const;
   Vector3D getAngularVelocity() const;
   float getMass() const;
   float getInverseMass() const;
   Matrix3D getInertiaTensor() const;
+
+  /**
+   * @brief   Get the shape's geometry, which may be shared with other bodies
+   * @details The shape's own transform is left as it was, the body's is getPosition() and getOrientation()
+   */
   std::shared_ptr<Shape> getShape() const;
 
+  BodyStore *getStore() const;
+  BodyId getId() const;
+
+  /**
+   * @brief   False while the body's island is asleep
+   */
+  bool isAwake() const;
+
+  /**
+   * @brief   Current dense index in the store. Changes when other bodies are removed
+   */
+  uint32_t getIndex() const;
+
   // Physics simulation
   void integrate(float deltaTime);
 };
@@ -0,0 +1,424 @@
+/*******************************************************************************************************************************
+ * @file   body_store.cc
+ *
+ * @brief  Source file for the structure of arrays rigid body storage
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <stdexcept>
+
+/* Inter-component Headers */
+#include "float_pack.h"
+#include "quaternion_pack.h"
+#include "sphere.h"
+#include "vector_pack.h"
+
+/* Intra-component Headers */
+#include "body_store.h"
+
+namespace {
+/* Bodies handled by one pack. A short last pack repeats its final body, which computes the same values and stores them again */
+struct PackLanes {
+  alignas(64) uint32_t indices[NATIVE_PACK_WIDTH];
+  bool contiguous; /**< Lanes are consecutive dense indices, so columns can be loaded directly */
+};
+
+PackLanes getPackLanes(const uint32_t *indices, uint32_t count, uint32_t first) {
+  PackLanes lanes;
+  const uint32_t valid = std::min<uint32_t>(count - first, NATIVE_PACK_WIDTH);
+
+  lanes.contiguous = (valid == NATIVE_PACK_WIDTH);
+  for (uint32_t lane = 0U; lane < NATIVE_PACK_WIDTH; lane++) {
+    lanes.indices[lane] = indices[first + std::min(lane, valid - 1U)];
+    lanes.contiguous = lanes.contiguous && (lanes.indices[lane] == lanes.indices[0U] + lane);
+  }
+
+  return lanes;
+}
+
+template <typename PackType, typename ArrayType>
+PackType loadPack(const ArrayType &array, const PackLanes &lanes) {
+  return lanes.contiguous ? PackType::load(array, lanes.indices[0U]) : PackType::gather(array, lanes.indices);
+}
+
+template <typename PackType, typename ArrayType>
+void storePack(const PackType &pack, ArrayType &array, const PackLanes &lanes) {
+  if (lanes.contiguous) {
+    pack.store(array, lanes.indices[0U]);
+  } else {
+    pack.scatter(array, lanes.indices);
+  }
+}
+}  // namespace
+
+size_t BodyStore::size() const {
+  return inverseMass.size();
+}
+
+void BodyStore::reserve(size_t capacity) {
+  position.reserve(capacity);
+  orientation.reserve(capacity);
+  linearVelocity.reserve(capacity);
+  angularVelocity.reserve(capacity);
+  force.reserve(capacity);
+  torque.reserve(capacity);
+  inverseMass.reserve(capacity);
+  inverseInertia.reserve(capacity);
+  boundingRadius.reserve(capacity);
+  shapeType.reserve(capacity);
+  shapeIndex.reserve(capacity);
+  broadphaseProxy.reserve(capacity);
+  ids.reserve(capacity);
+  sleepTime.reserve(capacity);
+  sleepIsland.reserve(capacity);
+  shapes.reserve(capacity);
+  views.reserve(capacity);
+}
+
+void BodyStore::clear() {
+  for (size_t i = 0U; i < ids.size(); i++) {
+    releaseSlot(ids[i].index);
+  }
+
+  position.clear();
+  orientation.clear();
+  linearVelocity.clear();
+  angularVelocity.clear();
+  force.clear();
+  torque.clear();
+  inverseMass.clear();
+  inverseInertia.clear();
+  boundingRadius.clear();
+  shapeType.clear();
+  shapeIndex.clear();
+  broadphaseProxy.clear();
+  ids.clear();
+  sleepTime.clear();
+  sleepIsland.clear();
+  shapes.clear();
+  views.clear();
+
+  spheres.radius.clear();
+  spheres.body.clear();
+
+  sleepingIslands.clear();
+  freeIslands.clear();
+}
+
+BodyId BodyStore::allocateSlot(uint32_t denseIndex) {
+  uint32_t slot;
+
+  if (freeSlotHead != INVALID_INDEX) {
+    slot = freeSlotHead;
+    freeSlotHead = slots[slot].index;
+  } else {
+    slot = static_cast<uint32_t>(slots.size());
+    slots.push_back(Slot{0U, 1U});
+  }
+
+  slots[slot].index = denseIndex;
+  return BodyId{slot, slots[slot].generation};
+}
+
+void BodyStore::releaseSlot(uint32_t slot) {
+  /* Bumping the generation invalidates every handle issued for this slot. Generation 0 is reserved for invalid handles */
+  slots[slot].generation++;
+  if (slots[slot].generation == 0U) {
+    slots[slot].generation = 1U;
+  }
+
+  slots[slot].index = freeSlotHead;
+  freeSlotHead = slot;
+}
+
+bool BodyStore::isValid(BodyId id) const {
+  return id.index < slots.size() && slots[id.index].generation == id.generation;
+}
+
+BodyId BodyStore::add(const BodyDesc &desc, RigidBody *view) {
+  const std::shared_ptr<Shape> &shape = desc.shape;
+  const uint32_t index = static_cast<uint32_t>(size());
+  BodyId id = allocateSlot(index);
+
+  position.push_back(desc.position);
+  orientation.push_back(desc.orientation);
+  linearVelocity.push_back(desc.linearVelocity);
+  angularVelocity.push_back(desc.angularVelocity);
+  force.push_back(Vector3D(0, 0, 0));
+  torque.push_back(Vector3D(0, 0, 0));
+
+  /* Checking if the mass is non-negative and not zero. Massless bodies are static */
+  float mass = shape->getMass();
+  inverseMass.push_back((mass > 0.0f) ? 1.0f / mass : 0.0f);
+
+  /* Shapes report their inertia tensor in their principal axes, so only the diagonal is kept */
+  Matrix3D inertia = shape->getInertiaTensor();
+  inverseInertia.push_back(Vector3D((inertia.matrix[0][0] > 0.0f) ? 1.0f / inertia.matrix[0][0] : 0.0f, (inertia.matrix[1][1] > 0.0f) ? 1.0f / inertia.matrix[1][1] : 0.0f,
+                                    (inertia.matrix[2][2] > 0.0f) ? 1.0f / inertia.matrix[2][2] : 0.0f));
+
+  shape->updateBoundingBox();
+  Vector3D halfExtent = (shape->getBoundingBoxMax() - shape->getBoundingBoxMin()) * 0.5f;
+  boundingRadius.push_back(std::max(halfExtent.x, std::max(halfExtent.y, halfExtent.z)));
+  addShape(index, *shape);
+  broadphaseProxy.push_back(INVALID_INDEX);
+  ids.push_back(id);
+  sleepTime.push_back(0.0f);
+  sleepIsland.push_back(INVALID_INDEX);
+
+  shapes.push_back(shape);
+  views.push_back(view);
+
+  return id;
+}
+
+BodyId BodyStore::addCopy(const BodyStore &source, uint32_t sourceIndex, RigidBody *view) {
+  const uint32_t index = static_cast<uint32_t>(size());
+  BodyId id = allocateSlot(index);
+
+  position.push_back(source.position.get(sourceIndex));
+  orientation.push_back(source.orientation.get(sourceIndex));
+  linearVelocity.push_back(source.linearVelocity.get(sourceIndex));
+  angularVelocity.push_back(source.angularVelocity.get(sourceIndex));
+  force.push_back(source.force.get(sourceIndex));
+  torque.push_back(source.torque.get(sourceIndex));
+  inverseMass.push_back(source.inverseMass[sourceIndex]);
+  inverseInertia.push_back(source.inverseInertia.get(sourceIndex));
+  boundingRadius.push_back(source.boundingRadius[sourceIndex]);
+  addShapeCopy(index, source, sourceIndex);
+  broadphaseProxy.push_back(INVALID_INDEX);
+  ids.push_back(id);
+
+  /* Islands don't carry over between stores, the body arrives awake */
+  sleepTime.push_back(0.0f);
+  sleepIsland.push_back(INVALID_INDEX);
+  shapes.push_back(source.shapes[sourceIndex]);
+  views.push_back(view);
+
+  return id;
+}
+
+void BodyStore::remove(BodyId id) {
+  uint32_t index = indexOf(id);
+  uint32_t last = static_cast<uint32_t>(size() - 1U);
+
+  removeShape(index);
+  position.swapRemove(index);
+  orientation.swapRemove(index);
+  linearVelocity.swapRemove(index);
+  angularVelocity.swapRemove(index);
+  force.swapRemove(index);
+  torque.swapRemove(index);
+  inverseMass.swapRemove(index);
+  inverseInertia.swapRemove(index);
+  boundingRadius.swapRemove(index);
+  shapeType.swapRemove(index);
+  shapeIndex.swapRemove(index);
+  broadphaseProxy.swapRemove(index);
+  ids.swapRemove(index);
+  sleepTime.swapRemove(index);
+  sleepIsland.swapRemove(index);
+
+  shapes[index] = std::move(shapes[last]);
+  shapes.pop_back();
+  views[index] = views[last];
+  views.pop_back();
+
+  /* The last body now lives at index, only its slot and its shape pool entry need to know */
+  releaseSlot(id.index);
+  if (index != last) {
+    slots[ids[index].index].index = index;
+    getShapeOwners(shapeType[index])[shapeIndex[index]] = index;
+  }
+}
+
+void BodyStore::addShape(uint32_t index, const Shape &shape) {
+  shapeType.push_back(shape.getType());
+
+  switch (shape.getType()) {
+    case ShapeType::SPHERE:
+      shapeIndex.push_back(static_cast<uint32_t>(spheres.radius.size()));
+      spheres.radius.push_back(static_cast<const Sphere &>(shape).getRadius());
+      spheres.body.push_back(index);
+      break;
+    default:
+      shapeIndex.push_back(INVALID_INDEX);
+      break;
+  }
+}
+
+void BodyStore::addShapeCopy(uint32_t index, const BodyStore &source, uint32_t sourceIndex) {
+  const uint32_t sourceEntry = source.shapeIndex[sourceIndex];
+  shapeType.push_back(source.shapeType[sourceIndex]);
+
+  switch (source.shapeType[sourceIndex]) {
+    case ShapeType::SPHERE:
+      shapeIndex.push_back(static_cast<uint32_t>(spheres.radius.size()));
+      spheres.radius.push_back(source.spheres.radius[sourceEntry]);
+      spheres.body.push_back(index);
+      break;
+    default:
+      shapeIndex.push_back(INVALID_INDEX);
+      break;
+  }
+}
+
+void BodyStore::removeShape(uint32_t index) {
+  const uint32_t entry = shapeIndex[index];
+
+  switch (shapeType[index]) {
+    case ShapeType::SPHERE:
+      /* Same swap and pop as the body columns, the entry moved into the hole tells its body where it went */
+      spheres.radius.swapRemove(entry);
+      spheres.body.swapRemove(entry);
+      if (entry < spheres.body.size()) {
+        shapeIndex[spheres.body[entry]] = entry;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+AlignedArray<uint32_t> &BodyStore::getShapeOwners(ShapeType type) {
+  switch (type) {
+    case ShapeType::SPHERE:
+      return spheres.body;
+    default:
+      throw std::invalid_argument("Unknown shape type");
+  }
+}
+
+void BodyStore::sleep(const uint32_t *indices, size_t count) {
+  uint32_t island;
+  if (!freeIslands.empty()) {
+    island = freeIslands.back();
+    freeIslands.pop_back();
+  } else {
+    island = static_cast<uint32_t>(sleepingIslands.size());
+    sleepingIslands.emplace_back();
+  }
+
+  std::vector<BodyId> &members = sleepingIslands[island];
+  members.clear();
+
+  for (size_t i = 0U; i < count; i++) {
+    uint32_t index = indices[i];
+    members.push_back(ids[index]);
+    sleepIsland[index] = island;
+    linearVelocity.set(index, Vector3D(0, 0, 0));
+    angularVelocity.set(index, Vector3D(0, 0, 0));
+  }
+}
+
+void BodyStore::wake(uint32_t index) {
+  uint32_t island = sleepIsland[index];
+  if (island == INVALID_INDEX) {
+    return;
+  }
+
+  for (BodyId member : sleepingIslands[island]) {
+    if (isValid(member)) {
+      uint32_t memberIndex = indexOf(member);
+      sleepIsland[memberIndex] = INVALID_INDEX;
+      sleepTime[memberIndex] = 0.0f;
+    }
+  }
+
+  sleepingIslands[island].clear();
+  freeIslands.push_back(island);
+}
+
+Matrix3D BodyStore::getWorldInverseInertia(uint32_t index) const {
+  Matrix3D rotation = orientation.get(index).toMatrix();
+  Vector3D inverse = inverseInertia.get(index);
+  Matrix3D scaled = rotation;
+
+  /* R * diag(I^-1), column by column */
+  for (unsigned int row = 0U; row < 3U; row++) {
+    scaled.matrix[row][0] *= inverse.x;
+    scaled.matrix[row][1] *= inverse.y;
+    scaled.matrix[row][2] *= inverse.z;
+  }
+
+  return scaled * rotation.transpose();
+}
+
+void BodyStore::integrateVelocity(uint32_t index, float deltaTime, const Vector3D &gravity) {
+  /* Objects with no mass don't move */
+  if (inverseMass[index] <= 0.0f) {
+    force.set(index, Vector3D(0, 0, 0));
+    torque.set(index, Vector3D(0, 0, 0));
+    return;
+  }
+
+  /* Velocity = Vinitial + Accel * dT */
+  linearVelocity.set(index, linearVelocity.get(index) + ((force.get(index) * inverseMass[index]) + gravity) * deltaTime);
+
+  /* AngularAccel = InverseInertiaTensor * Torque, with the torque taken into body space and the result brought back out */
+  Quaternion rotation = orientation.get(index);
+  Vector3D localTorque = rotation.conjugate().rotate(torque.get(index));
+  Vector3D localInverseInertia = inverseInertia.get(index);
+  Vector3D localAcceleration(localTorque.x * localInverseInertia.x, localTorque.y * localInverseInertia.y, localTorque.z * localInverseInertia.z);
+
+  /* Integrate the acceleration for velocity */
+  angularVelocity.set(index, angularVelocity.get(index) + rotation.rotate(localAcceleration) * deltaTime);
+
+  force.set(index, Vector3D(0, 0, 0));
+  torque.set(index, Vector3D(0, 0, 0));
+}
+
+void BodyStore::integratePosition(uint32_t index, float deltaTime) {
+  if (inverseMass[index] <= 0.0f) {
+    return;
+  }
+
+  /* Position = PosInitial + Vel * dT */
+  position.set(index, position.get(index) + (linearVelocity.get(index) * deltaTime));
+
+  /* Orientation = q + 0.5 * (0, w) * q * dT, normalized */
+  orientation.set(index, orientation.get(index).integrate(angularVelocity.get(index), deltaTime));
+}
+
+void BodyStore::integrateBody(uint32_t index, float deltaTime, const Vector3D &gravity) {
+  integrateVelocity(index, deltaTime, gravity);
+  integratePosition(index, deltaTime);
+}
+
+void BodyStore::integrateVelocities(const uint32_t *indices, uint32_t count, float deltaTime, const Vector3D &gravity) {
+  const FloatxN step(deltaTime);
+  const Vec3xN gravityPack(gravity);
+  const Vec3xN zero(Vector3D(0, 0, 0));
+
+  for (uint32_t first = 0U; first < count; first += NATIVE_PACK_WIDTH) {
+    const PackLanes lanes = getPackLanes(indices, count, first);
+    FloatxN mass = lanes.contiguous ? FloatxN::load(inverseMass.data() + lanes.indices[0U]) : FloatxN::gather(inverseMass.data(), lanes.indices);
+
+    /* Same steps as integrateVelocity, a pack of bodies at a time */
+    Vec3xN acceleration = loadPack<Vec3xN>(force, lanes).multiplyAdd(mass, gravityPack);
+    storePack(acceleration.multiplyAdd(step, loadPack<Vec3xN>(linearVelocity, lanes)), linearVelocity, lanes);
+
+    QuatxN rotation = loadPack<QuatxN>(orientation, lanes);
+    Vec3xN localTorque = rotation.conjugate().rotate(loadPack<Vec3xN>(torque, lanes));
+    Vec3xN localInverseInertia = loadPack<Vec3xN>(inverseInertia, lanes);
+    Vec3xN localAcceleration(localTorque.x * localInverseInertia.x, localTorque.y * localInverseInertia.y, localTorque.z * localInverseInertia.z);
+    storePack(rotation.rotate(localAcceleration).multiplyAdd(step, loadPack<Vec3xN>(angularVelocity, lanes)), angularVelocity, lanes);
+
+    storePack(zero, force, lanes);
+    storePack(zero, torque, lanes);
+  }
+}
+
+void BodyStore::integratePositions(const uint32_t *indices, uint32_t count, float deltaTime) {
+  const FloatxN step(deltaTime);
+
+  for (uint32_t first = 0U; first < count; first += NATIVE_PACK_WIDTH) {
+    const PackLanes lanes = getPackLanes(indices, count, first);
+
+    storePack(loadPack<Vec3xN>(linearVelocity, lanes).multiplyAdd(step, loadPack<Vec3xN>(position, lanes)), position, lanes);
+    storePack(loadPack<QuatxN>(orientation, lanes).integrate(loadPack<Vec3xN>(angularVelocity, lanes), step), orientation, lanes);
+  }
+}
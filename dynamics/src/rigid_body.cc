@@ -16,138 +16,149 @@
 /* Intra-component Headers */
 #include "rigid_body.h"
 
-void RigidBody::updateInertiaTensor() {
-  this->inertiaTensor = shape->getInertiaTensor();
-  this->inverseInertiaTensor = inertiaTensor.inverse();
+RigidBody::RigidBody(std::shared_ptr<Shape> shape) {
+  BodyDesc desc;
+  desc.shape = shape;
+  desc.position = shape->getPosition();
+  desc.orientation = shape->getOrientation();
 
-  /* Checking if the mass is non-negative and not zero */
-  this->inverseMass = (mass > 0.0f) ? 1.0f / mass : 0.0f;
+  this->detachedStore = std::make_unique<BodyStore>();
+  this->store = detachedStore.get();
+  this->id = store->add(desc, this);
 }
 
-RigidBody::RigidBody(std::shared_ptr<Shape> shape) {
-  this->shape = shape;
-  this->shape->getPosition();
-  this->orientation = Matrix3D();
+RigidBody::RigidBody(BodyStore *store, BodyId id) {
+  this->store = store;
+  this->id = id;
+  store->views[index()] = this;
+}
+
+RigidBody::~RigidBody() {
+  /* Don't leave a dangling view behind in a store we don't own */
+  if (store != detachedStore.get() && store->isValid(id)) {
+    store->views[index()] = nullptr;
+  }
+}
+
+void RigidBody::attach(BodyStore *newStore) {
+  BodyId newId = newStore->addCopy(*store, index(), this);
 
-  this->linearVelocity = Vector3D(0, 0, 0);
-  this->angularVelocity = Vector3D(0, 0, 0);
-  this->force = Vector3D(0, 0, 0);
-  this->torque = Vector3D(0, 0, 0);
+  this->store = newStore;
+  this->id = newId;
+  this->detachedStore.reset();
+}
+
+void RigidBody::detach() {
+  std::unique_ptr<BodyStore> ownStore = std::make_unique<BodyStore>();
+  BodyId newId = ownStore->addCopy(*store, index(), this);
+  store->remove(id);
 
-  this->position = getPosition();
-  this->mass = getMass();
-  updateInertiaTensor();
+  this->detachedStore = std::move(ownStore);
+  this->store = detachedStore.get();
+  this->id = newId;
 }
 
 void RigidBody::setPosition(const Vector3D &pos) {
-  this->position = pos;
-  this->shape->setPosition(pos);
+  store->wake(index());
+  store->position.set(index(), pos);
+}
+
+void RigidBody::setOrientation(const Quaternion &orient) {
+  store->wake(index());
+  store->orientation.set(index(), orient.normalize());
 }
 
 void RigidBody::setOrientation(const Matrix3D &orient) {
-  this->orientation = orient;
-  this->shape->setOrientation(orient);
+  setOrientation(Quaternion::fromMatrix(orient));
 }
 
 void RigidBody::setLinearVelocity(const Vector3D &vel) {
-  this->linearVelocity = vel;
+  store->wake(index());
+  store->linearVelocity.set(index(), vel);
 }
 
 void RigidBody::setAngularVelocity(const Vector3D &angVel) {
-  this->angularVelocity = angVel;
+  store->wake(index());
+  store->angularVelocity.set(index(), angVel);
 }
 
 void RigidBody::addForce(const Vector3D &force) {
-  this->force = this->force + force;
+  store->wake(index());
+  store->force.set(index(), store->force.get(index()) + force);
 }
 
 void RigidBody::addForceAtPoint(const Vector3D &force, const Vector3D &point) {
-  this->force = this->force + force;
+  uint32_t i = index();
+  store->wake(i);
+  store->force.set(i, store->force.get(i) + force);
 
   /* Torque = Force X Radius */
-  Vector3D radius = point - this->position;
-  this->torque = this->torque + (radius.crossProduct(force));
+  Vector3D radius = point - store->position.get(i);
+  store->torque.set(i, store->torque.get(i) + (radius.crossProduct(force)));
 }
 
 void RigidBody::addTorque(const Vector3D &torque) {
-  this->torque = this->torque + torque;
+  store->wake(index());
+  store->torque.set(index(), store->torque.get(index()) + torque);
 }
 
 void RigidBody::clearForces() {
-  this->force = Vector3D(0, 0, 0);
-  this->torque = Vector3D(0, 0, 0);
+  store->force.set(index(), Vector3D(0, 0, 0));
+  store->torque.set(index(), Vector3D(0, 0, 0));
 }
 
 Vector3D RigidBody::getPosition() const {
-  return this->shape->getPosition();
+  return store->position.get(index());
 }
 
-Matrix3D RigidBody::getOrientation() const {
-  return this->orientation;
+Quaternion RigidBody::getOrientation() const {
+  return store->orientation.get(index());
+}
+
+Matrix3D RigidBody::getRotationMatrix() const {
+  return store->orientation.get(index()).toMatrix();
 }
 
 Vector3D RigidBody::getLinearVelocity() const {
-  return this->linearVelocity;
+  return store->linearVelocity.get(index());
 }
 
 Vector3D RigidBody::getAngularVelocity() const {
-  return this->angularVelocity;
+  return store->angularVelocity.get(index());
 }
 
 float RigidBody::getMass() const {
-  return this->shape->getMass();
+  return store->shapes[index()]->getMass();
 }
 
 float RigidBody::getInverseMass() const {
-  if (this->shape->getMass() == 0.0f) {
-    /* Assume mass of 1 */
-    return 1.0f;
-  }
-
-  return (1.0f / this->shape->getMass());
+  return store->inverseMass[index()];
 }
 
 Matrix3D RigidBody::getInertiaTensor() const {
-  return this->shape->getInertiaTensor();
+  return store->shapes[index()]->getInertiaTensor();
 }
 
 std::shared_ptr<Shape> RigidBody::getShape() const {
-  return this->shape;
+  return store->shapes[index()];
 }
 
-void RigidBody::integrate(float deltaTime) {
-  /* Objects with no mass don't move */
-  if (inverseMass <= 0.0f) {
-    return;
-  }
-
-  /* Velocity = Vinitial + Accel * dT */
-  this->linearVelocity = this->linearVelocity + ((force * inverseMass) * deltaTime);
-
-  /* Position = PosInitial + Vel * dT */
-  this->position = this->position + (this->linearVelocity * deltaTime);
-
-  /* Torque = AngularAccel * InertiaTensor */
-  /* AngularAccel = InverseInertiaTensor * Torque */
-  Vector3D angularAcceleration = inverseInertiaTensor * torque;
-
-  /* Integrate the acceleration for velocity */
-  this->angularVelocity = this->angularVelocity + angularAcceleration * deltaTime;
-
-  /* Skew symmetric matrix instead of using cross products */
-  Matrix3D spin(0, -angularVelocity.z, angularVelocity.y, angularVelocity.z, 0, -angularVelocity.x, -angularVelocity.y, angularVelocity.x, 0);
+BodyStore *RigidBody::getStore() const {
+  return store;
+}
 
-  /* Update orientation quaternion (R' = R + (w x R)dt) */
-  this->orientation = this->orientation + ((spin * this->orientation) * deltaTime);
+BodyId RigidBody::getId() const {
+  return id;
+}
 
-  /* Normalize the orientation matrix to prevent drift */
-  if (!this->orientation.isOrthonormal()) {
-    this->orientation.orthonormalize();
-  }
+bool RigidBody::isAwake() const {
+  return store->isAwake(index());
+}
 
-  /* Update shapes position and orientation */
-  shape->setPosition(position);
-  shape->setOrientation(orientation);
+uint32_t RigidBody::getIndex() const {
+  return index();
+}
 
-  clearForces();
+void RigidBody::integrate(float deltaTime) {
+  store->integrateBody(index(), deltaTime, Vector3D(0, 0, 0));
 }
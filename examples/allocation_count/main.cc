@@ -0,0 +1,148 @@
+/*******************************************************************************************************************************
+ * @file   main.cc
+ *
+ * @brief  Main file for allocation_count example, checks that steady state stepping and replication never call malloc, with every broadphase
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <vector>
+
+/* Inter-component Headers */
+#include "physics_world.h"
+#include "sphere.h"
+#include "state_replication.h"
+
+/* Intra-component Headers */
+
+/* glibc's own entry points, so the hooks below can count calls and forward them */
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+}
+
+namespace {
+std::atomic<uint64_t> allocationCount{0U};
+
+const uint32_t BODY_COUNT = 2000U;
+const uint32_t WARM_UP_STEPS = 120U;
+const uint32_t MEASURED_STEPS = 240U;
+}  // namespace
+
+/* Counting hooks. Every heap allocation made by the engine (new, containers, aligned arrays, arenas) ends up in one of these */
+extern "C" {
+void *malloc(size_t size) {
+  allocationCount.fetch_add(1U, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+  allocationCount.fetch_add(1U, std::memory_order_relaxed);
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size) {
+  allocationCount.fetch_add(1U, std::memory_order_relaxed);
+  return __libc_realloc(pointer, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+  allocationCount.fetch_add(1U, std::memory_order_relaxed);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **pointer, size_t alignment, size_t size) {
+  allocationCount.fetch_add(1U, std::memory_order_relaxed);
+  *pointer = __libc_memalign(alignment, size);
+  return *pointer ? 0 : 12; /* ENOMEM */
+}
+}
+
+namespace {
+/**
+ * @brief   Settle the scene with one broadphase and count what the measured steps allocate
+ * @return  true if neither stepping nor replicating allocated
+ */
+bool countAllocations(BroadphaseType broadphase, const char *name, uint32_t threadCount) {
+  PhysicsWorld world;
+  world.setThreadCount(threadCount);
+  world.setBroadphase(broadphase);
+
+  /* A pile of spheres settling on a large static sphere, contacts appear and disappear while it settles */
+  BodyDesc ground;
+  ground.shape = std::make_shared<Sphere>(200.0f, 0.0f);
+  ground.position = Vector3D(0, -200, 0);
+  world.createBody(ground);
+
+  std::shared_ptr<Sphere> ball = std::make_shared<Sphere>(0.5f);
+  for (uint32_t i = 0U; i < BODY_COUNT; i++) {
+    BodyDesc desc;
+    desc.shape = ball;
+    desc.position = Vector3D((i % 15U) * 1.02f - 7.5f + 0.01f * (i % 3U), 0.6f + (i / 225U) * 1.02f, ((i / 15U) % 15U) * 1.02f - 7.5f);
+    world.createBody(desc);
+  }
+
+  /* Each step is also sent to an observer one step behind, into a packet buffer sized once */
+  ReplicationEncoder encoder;
+  ReplicationDecoder decoder;
+  encoder.reserve(BODY_COUNT + 1U);
+  decoder.reserve(BODY_COUNT + 1U);
+  std::vector<uint8_t> packet((BODY_COUNT + 1U) * 64U);
+  auto replicate = [&]() {
+    size_t size = encoder.encode(decoder.getLatestSequence(), packet);
+    return size > 0U && decoder.decode(std::span<const uint8_t>(packet.data(), size));
+  };
+
+  for (uint32_t step = 0U; step < WARM_UP_STEPS; step++) {
+    world.step();
+    encoder.capture(world);
+    replicate();
+  }
+
+  uint64_t before = allocationCount.load();
+  uint64_t worstStep = 0U;
+  uint64_t replicationTotal = 0U;
+  bool replicated = true;
+  for (uint32_t step = 0U; step < MEASURED_STEPS; step++) {
+    uint64_t stepStart = allocationCount.load();
+    world.step();
+    uint64_t replicationStart = allocationCount.load();
+    encoder.capture(world);
+    replicated = replicate() && replicated;
+    replicationTotal += allocationCount.load() - replicationStart;
+    worstStep = std::max(worstStep, replicationStart - stepStart);
+  }
+  uint64_t total = allocationCount.load() - before - replicationTotal;
+
+  std::printf("%-15s threads %u, %u steps after warm up: %llu allocations (worst step %llu), %zu bodies awake, replicating %llu allocations, %s\n", name,
+              world.getThreadCount(), MEASURED_STEPS, static_cast<unsigned long long>(total), static_cast<unsigned long long>(worstStep), world.getAwakeBodyCount(),
+              static_cast<unsigned long long>(replicationTotal), replicated ? "every packet decoded" : "DECODE FAILED");
+  return total == 0U && replicationTotal == 0U && replicated;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  uint32_t threadCount = (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : 1U;
+
+  /* Every broadphase, not just the one that happens to be cheapest, the default included */
+  bool valid = true;
+  valid = countAllocations(BroadphaseType::ALL_PAIRS, "all_pairs", threadCount) && valid;
+  valid = countAllocations(BroadphaseType::SWEEP_AND_PRUNE, "sweep_and_prune", threadCount) && valid;
+  valid = countAllocations(BroadphaseType::SPATIAL_HASH, "spatial_hash", threadCount) && valid;
+  valid = countAllocations(BroadphaseType::DYNAMIC_TREE, "dynamic_tree", threadCount) && valid;
+
+  /* What the engine's pools look like after the runs, for sizing them */
+  MemoryManager::getInstance().writeStatsJson(std::cout);
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
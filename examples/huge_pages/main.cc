@@ -0,0 +1,105 @@
+/*******************************************************************************************************************************
+ * @file   main.cc
+ *
+ * @brief  Main file for huge_pages example, compares how the memory manager's backing memory affects the first steps of a scene
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <sys/resource.h>
+
+/* Inter-component Headers */
+#include "physics_world.h"
+#include "sphere.h"
+
+/* Intra-component Headers */
+
+namespace {
+const uint32_t DEFAULT_BODY_COUNT = 100000U;
+const uint32_t TIMED_STEPS = 10U;
+
+uint64_t getPageFaults() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<uint64_t>(usage.ru_minflt) + static_cast<uint64_t>(usage.ru_majflt);
+}
+
+/* Faults taken up front by the memory manager's prefaulting, the rest of a phase's faults happened lazily on first touch */
+uint64_t getPrefaultFaults() {
+  return MemoryManager::getInstance().getSystemStats().prefaultFaults;
+}
+
+double getSeconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  const char *mode = (argc > 1) ? argv[1] : "huge-prefault";
+  uint32_t bodyCount = (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : DEFAULT_BODY_COUNT;
+
+  /* heap: aligned_alloc slabs, mmap: mapped 2MB chunks, huge: mapped and advised for huge pages, huge-prefault: also touched up front */
+  PoolOptions options;
+  options.mapMemory = std::strcmp(mode, "heap") != 0;
+  options.hugePages = std::strncmp(mode, "huge", 4U) == 0;
+  options.prefault = std::strcmp(mode, "huge-prefault") == 0;
+  options.slabsPerPool = 4U;
+
+  /* Has to run before the world exists, so everything the world allocates comes from the configured memory */
+  auto start = std::chrono::steady_clock::now();
+  uint64_t faults = getPageFaults();
+  MemoryManager::getInstance().initializePools(options);
+  std::printf("mode %s: initializePools %.3f ms, %llu page faults\n", mode, getSeconds(start) * 1000.0, static_cast<unsigned long long>(getPageFaults() - faults));
+
+  PhysicsWorld world;
+  world.setBroadphase(BroadphaseType::SPATIAL_HASH);
+
+  /* A loose grid of falling spheres, enough bodies that the store's columns span several huge pages */
+  std::shared_ptr<Sphere> ball = std::make_shared<Sphere>(0.25f);
+  std::vector<BodyDesc> descs(bodyCount);
+  for (uint32_t i = 0U; i < bodyCount; i++) {
+    descs[i].shape = ball;
+    descs[i].position = Vector3D((i % 100U) * 1.5f, (i / 10000U) * 1.5f, ((i / 100U) % 100U) * 1.5f);
+  }
+  std::vector<BodyId> ids(bodyCount);
+
+  start = std::chrono::steady_clock::now();
+  faults = getPageFaults();
+  world.createBodies(descs, ids);
+  std::printf("createBodies(%u) %.3f ms, %llu page faults\n", bodyCount, getSeconds(start) * 1000.0, static_cast<unsigned long long>(getPageFaults() - faults));
+
+  /* The first steps are where the arenas and broadphase grow, so they pay for any page faults */
+  double totalSeconds = 0.0;
+  uint64_t totalFaults = 0U;
+  uint64_t totalPrefaults = 0U;
+  for (uint32_t step = 0U; step < TIMED_STEPS; step++) {
+    start = std::chrono::steady_clock::now();
+    faults = getPageFaults();
+    uint64_t prefaults = getPrefaultFaults();
+    world.step();
+    double seconds = getSeconds(start);
+    uint64_t stepFaults = getPageFaults() - faults;
+    uint64_t stepPrefaults = getPrefaultFaults() - prefaults;
+    totalSeconds += seconds;
+    totalFaults += stepFaults;
+    totalPrefaults += stepPrefaults;
+    std::printf("step %u: %.3f ms, %llu page faults (%llu prefaulted)\n", step, seconds * 1000.0, static_cast<unsigned long long>(stepFaults),
+                static_cast<unsigned long long>(stepPrefaults));
+  }
+  std::printf("first %u steps: %.3f ms, %llu page faults (%llu prefaulted)\n", TIMED_STEPS, totalSeconds * 1000.0, static_cast<unsigned long long>(totalFaults),
+              static_cast<unsigned long long>(totalPrefaults));
+
+  /* Reservation time, prefault cost and how much memory the kernel agreed to back with huge pages */
+  MemoryManager::getInstance().writeStatsJson(std::cout);
+  return EXIT_SUCCESS;
+}
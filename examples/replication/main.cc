@@ -0,0 +1,246 @@
+/*******************************************************************************************************************************
+ * @file   main.cc
+ *
+ * @brief  Main file for replication example, streams a world to observers over a lossy local loopback and checks what they see
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+/* Inter-component Headers */
+#include "physics_world.h"
+#include "sphere.h"
+#include "state_replication.h"
+
+/* Intra-component Headers */
+
+namespace {
+const uint32_t DEFAULT_BODY_COUNT = 2000U;
+const uint32_t DEFAULT_TICK_COUNT = 600U;
+const uint32_t RESPAWN_INTERVAL = 25U; /**< Ticks between destroying a body and creating another, so slots get reused */
+const uint32_t TRUTH_HISTORY = 64U;    /**< Ticks of server state kept to check late packets against */
+
+/**
+ * @brief   One observer at the end of a simulated link. Packets and acks both take latency ticks and are lost at random
+ */
+struct Observer {
+  const char *name;
+  uint32_t latency;
+  float lossRate;
+  ReplicationDecoder decoder;
+  uint32_t acked{REPLICATION_NO_BASELINE};                         /**< Latest ack the server has received, acks arrive in order */
+  std::deque<std::pair<uint32_t, std::vector<uint8_t>>> packets{}; /**< (Arrival tick, packet) */
+  std::deque<std::pair<uint32_t, uint32_t>> acks{};                /**< (Arrival tick, acknowledged sequence) */
+  uint64_t bytes{0U};
+  uint64_t decoded{0U};
+  uint64_t rejected{0U};
+  double decodeSeconds{0.0};
+  uint64_t decodedBodies{0U};
+};
+
+/**
+ * @brief   Server side transforms of every slot at one tick
+ */
+struct Truth {
+  uint32_t sequence{REPLICATION_NO_BASELINE};
+  std::vector<BodyId> ids; /**< Indexed by slot, a default handle for an empty slot */
+  std::vector<Vector3D> positions;
+  std::vector<Quaternion> orientations;
+};
+
+void recordTruth(const BodyStore &store, uint32_t sequence, Truth &truth) {
+  truth.sequence = sequence;
+  truth.ids.assign(truth.ids.size(), BodyId());
+  for (uint32_t i = 0U; i < store.size(); i++) {
+    uint32_t slot = store.ids[i].index;
+    if (slot >= truth.ids.size()) {
+      truth.ids.resize(slot + 1U);
+      truth.positions.resize(slot + 1U);
+      truth.orientations.resize(slot + 1U);
+    }
+    truth.ids[slot] = store.ids[i];
+    truth.positions[slot] = store.position.get(i);
+    truth.orientations[slot] = store.orientation.get(i);
+  }
+}
+
+/* Angle between two orientations, either sign of a quaternion is the same rotation */
+float angleBetween(const Quaternion &a, const Quaternion &b) {
+  float dot = std::fabs(a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z) / std::sqrt(a.lengthSquared() * b.lengthSquared());
+  return 2.0f * std::acos(std::min(dot, 1.0f));
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  uint32_t bodyCount = (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : DEFAULT_BODY_COUNT;
+  uint32_t tickCount = (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : DEFAULT_TICK_COUNT;
+
+  /* A layer of spheres settling on a very large static sphere, almost flat under them, while more are dropped in from above. Most
+     of the layer falls asleep, the dropped ones wake whatever they land on */
+  PhysicsWorld world;
+  world.setBroadphase(BroadphaseType::SPATIAL_HASH);
+  world.setSleepThresholds(0.3f, 0.3f, 0.25f);
+  BodyDesc ground;
+  ground.shape = std::make_shared<Sphere>(1000.0f, 0.0f);
+  ground.position = Vector3D(0, -1000, 0);
+  world.createBody(ground);
+
+  std::shared_ptr<Sphere> ball = std::make_shared<Sphere>(0.5f);
+  const uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(bodyCount))));
+  for (uint32_t i = 0U; i < bodyCount; i++) {
+    BodyDesc desc;
+    desc.shape = ball;
+    desc.position = Vector3D((i % side) * 1.1f - side * 0.55f, 0.6f + 0.05f * (i % 7U), (i / side) * 1.1f - side * 0.55f);
+    world.createBody(desc);
+  }
+
+  ReplicationOptions options;
+  ReplicationEncoder encoder(options);
+  encoder.reserve(bodyCount + 1U);
+
+  std::vector<Observer> observers;
+  observers.push_back(Observer{"lan", 1U, 0.0f, ReplicationDecoder(options)});
+  observers.push_back(Observer{"wifi", 3U, 0.05f, ReplicationDecoder(options)});
+  observers.push_back(Observer{"mobile", 8U, 0.25f, ReplicationDecoder(options)});
+  for (Observer &observer : observers) {
+    observer.decoder.reserve(bodyCount + 1U);
+  }
+
+  std::vector<Truth> truths(TRUTH_HISTORY);
+  std::vector<uint8_t> packet;
+  std::mt19937 random(7U);
+  std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+  double captureSeconds = 0.0;
+  double encodeSeconds = 0.0;
+  uint64_t encodedPackets = 0U;
+  float positionError = 0.0f;
+  float orientationError = 0.0f;
+  bool valid = true;
+
+  for (uint32_t tick = 0U; tick < tickCount; tick++) {
+    world.step();
+
+    /* Bodies come and go, a destroyed body's slot is handed to the next one created */
+    if (tick % RESPAWN_INTERVAL == RESPAWN_INTERVAL - 1U) {
+      const BodyStore &store = world.getBodyStore();
+      world.destroyBody(store.ids[1U + (tick % (store.size() - 1U))]);
+
+      BodyDesc desc;
+      desc.shape = ball;
+      desc.position = Vector3D(static_cast<float>(tick % side) - side * 0.5f, 10.0f, static_cast<float>((tick * 7U) % side) - side * 0.5f);
+      world.createBody(desc);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t sequence = encoder.capture(world);
+    captureSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    recordTruth(world.getBodyStore(), sequence, truths[sequence % TRUTH_HISTORY]);
+
+    /* A packet per observer against its latest ack. Packets are sized to fit the worst case once and then reused */
+    packet.resize(encoder.getMaxPacketSize());
+    for (Observer &observer : observers) {
+      while (!observer.acks.empty() && observer.acks.front().first <= tick) {
+        observer.acked = observer.acks.front().second;
+        observer.acks.pop_front();
+      }
+
+      start = std::chrono::steady_clock::now();
+      size_t size = encoder.encode(observer.acked, packet);
+      encodeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      encodedPackets++;
+      valid = valid && size > 0U;
+      observer.bytes += size;
+
+      if (chance(random) >= observer.lossRate) {
+        observer.packets.emplace_back(tick + observer.latency, std::vector<uint8_t>(packet.begin(), packet.begin() + size));
+      }
+    }
+
+    /* Deliver, decode, check against the server's state at that tick and acknowledge */
+    for (Observer &observer : observers) {
+      while (!observer.packets.empty() && observer.packets.front().first <= tick) {
+        const std::vector<uint8_t> &data = observer.packets.front().second;
+        start = std::chrono::steady_clock::now();
+        bool decoded = observer.decoder.decode(data);
+        observer.decodeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        observer.packets.pop_front();
+
+        if (!decoded) {
+          observer.rejected++;
+          continue;
+        }
+        observer.decoded++;
+
+        const Truth &truth = truths[observer.decoder.getLatestSequence() % TRUTH_HISTORY];
+        valid = valid && truth.sequence == observer.decoder.getLatestSequence() && observer.decoder.getSlotCount() <= truth.ids.size();
+        for (uint32_t slot = 0U; valid && slot < truth.ids.size(); slot++) {
+          ReplicatedBody body;
+          bool present = observer.decoder.getBody(slot, body);
+          valid = present == (truth.ids[slot].generation != 0U) && (!present || body.id == truth.ids[slot]);
+          if (valid && present) {
+            Vector3D error = body.position - truth.positions[slot];
+            positionError = std::max({positionError, std::fabs(error.x), std::fabs(error.y), std::fabs(error.z)});
+            orientationError = std::max(orientationError, angleBetween(body.orientation, truth.orientations[slot]));
+            observer.decodedBodies++;
+          }
+        }
+
+        if (chance(random) >= observer.lossRate) {
+          observer.acks.emplace_back(tick + observer.latency, observer.decoder.getLatestSequence());
+        }
+      }
+    }
+  }
+
+  /* A packet against nothing, what a newly joined observer gets. Cut short or with a garbage header it has to be turned away
+     (Without sizing anything from the header), whole it has to decode */
+  size_t fullBytes = encoder.encode(REPLICATION_NO_BASELINE, packet);
+  ReplicationDecoder joining(options);
+  bool truncatedRejected = !joining.decode(std::span<const uint8_t>(packet.data(), fullBytes / 2U));
+
+  std::vector<uint8_t> damaged(packet.begin(), packet.begin() + fullBytes);
+  ReplicationPacketHeader header;
+  std::memcpy(&header, damaged.data(), sizeof(header));
+  header.slotCount = 0xFFFFFFFFU;
+  std::memcpy(damaged.data(), &header, sizeof(header));
+  bool garbageRejected = !joining.decode(damaged);
+  header.slotCount = options.maxSlots;
+  header.entryCount = 0xFFFFFFFFU;
+  std::memcpy(damaged.data(), &header, sizeof(header));
+  garbageRejected = garbageRejected && !joining.decode(damaged);
+
+  valid = valid && truncatedRejected && garbageRejected && joining.decode(std::span<const uint8_t>(packet.data(), fullBytes)) &&
+          joining.getLastEntryCount() == world.getBodyCount();
+  const double bodies = static_cast<double>(world.getBodyCount());
+  std::printf("%u ticks of %.0f bodies (%zu awake at the end), full state %.2f bytes per body, truncated packet %s, garbage header %s\n", tickCount, bodies,
+              world.getAwakeBodyCount(), static_cast<double>(fullBytes) / bodies, truncatedRejected ? "rejected" : "ACCEPTED", garbageRejected ? "rejected" : "ACCEPTED");
+  std::printf("capture %.1f ns per body, encode %.1f ns per body per observer\n", captureSeconds * 1e9 / (bodies * tickCount),
+              encodeSeconds * 1e9 / (bodies * static_cast<double>(encodedPackets)));
+  for (const Observer &observer : observers) {
+    std::printf("%-7s %u ticks latency, %2.0f%% loss: %.2f bytes per body per tick, %llu decoded, %llu rejected, decode %.1f ns per body\n", observer.name, observer.latency,
+                observer.lossRate * 100.0f, static_cast<double>(observer.bytes) / (bodies * tickCount), static_cast<unsigned long long>(observer.decoded),
+                static_cast<unsigned long long>(observer.rejected), observer.decodeSeconds * 1e9 / std::max(1.0, static_cast<double>(observer.decodedBodies)));
+    valid = valid && observer.decoded > 0U;
+  }
+
+  /* Half a grid step per axis. Each smallest-three component is off by half a step at most, the rebuilt largest one adds to that
+     the most when it is small, a few steps of angle in all */
+  const float orientationBound = 8.0f / static_cast<float>((1U << options.orientationBits) - 1U);
+  valid = valid && positionError <= options.positionPrecision * 0.5f + 1e-5f && orientationError <= orientationBound;
+  std::printf("max position error %.6f, max orientation error %.6f rad: %s\n", positionError, orientationError, valid ? "ok" : "MISMATCH");
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,106 @@
+/*******************************************************************************************************************************
+ * @file   main.cc
+ *
+ * @brief  Main file for rollback example, rewinds a settling pile a few frames at a time and checks the replay matches
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/* Inter-component Headers */
+#include "physics_world.h"
+#include "sphere.h"
+
+/* Intra-component Headers */
+
+namespace {
+const uint32_t DEFAULT_BODY_COUNT = 200U;
+const uint32_t FRAME_COUNT = 600U;
+const uint32_t ROLLBACK_INTERVAL = 10U; /**< Frames between rollbacks */
+const uint32_t ROLLBACK_FRAMES = 6U;    /**< How far each rollback rewinds, like a late input arriving in lockstep */
+const uint32_t STATE_SLOTS = 8U;
+
+/* Raw bits of the columns that matter, so the comparison catches any difference at all */
+std::vector<uint32_t> captureState(const BodyStore &store) {
+  std::vector<uint32_t> bits;
+  for (const AlignedArray<float> *column : {&store.position.x, &store.position.y, &store.position.z, &store.orientation.w, &store.orientation.x, &store.orientation.y,
+                                            &store.orientation.z, &store.linearVelocity.x, &store.linearVelocity.y, &store.linearVelocity.z, &store.angularVelocity.x,
+                                            &store.angularVelocity.y, &store.angularVelocity.z, &store.sleepTime}) {
+    size_t start = bits.size();
+    bits.resize(start + column->size());
+    std::memcpy(bits.data() + start, column->data(), column->size() * sizeof(float));
+  }
+  bits.insert(bits.end(), store.sleepIsland.data(), store.sleepIsland.data() + store.size());
+
+  return bits;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  uint32_t bodyCount = (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : DEFAULT_BODY_COUNT;
+
+  /* A pile of spheres settling on a large static sphere, so rollbacks cross contacts, waking and falling asleep */
+  PhysicsWorld world;
+  world.setBroadphase(BroadphaseType::SPATIAL_HASH);
+  BodyDesc ground;
+  ground.shape = std::make_shared<Sphere>(200.0f, 0.0f);
+  ground.position = Vector3D(0, -200, 0);
+  world.createBody(ground);
+
+  std::shared_ptr<Sphere> ball = std::make_shared<Sphere>(0.5f);
+  for (uint32_t i = 0U; i < bodyCount; i++) {
+    BodyDesc desc;
+    desc.shape = ball;
+    desc.position = Vector3D((i % 10U) * 1.02f - 5.0f + 0.01f * (i % 3U), 0.6f + (i / 100U) * 1.02f, ((i / 10U) % 10U) * 1.02f - 5.0f);
+    world.createBody(desc);
+  }
+  world.setStateSlotCount(STATE_SLOTS);
+
+  /* Loose thresholds, so islands fall asleep (And get woken) within the run */
+  world.setSleepThresholds(0.3f, 0.3f, 0.25f);
+
+  uint32_t rollbacks = 0U;
+  bool identical = true;
+  double saveSeconds = 0.0;
+  double restoreSeconds = 0.0;
+  for (uint32_t frame = 0U; frame < FRAME_COUNT && identical; frame++) {
+    auto start = std::chrono::steady_clock::now();
+    world.saveState(frame);
+    saveSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    world.step();
+
+    if (frame % ROLLBACK_INTERVAL == ROLLBACK_INTERVAL - 1U && frame >= ROLLBACK_FRAMES) {
+      /* Rewind to the start of an earlier frame and replay up to now, saving again on the way like a lockstep client would */
+      std::vector<uint32_t> expected = captureState(world.getBodyStore());
+      start = std::chrono::steady_clock::now();
+      identical = world.restoreState(frame - ROLLBACK_FRAMES);
+      restoreSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      for (uint32_t replay = frame - ROLLBACK_FRAMES; replay <= frame && identical; replay++) {
+        world.saveState(replay);
+        world.step();
+      }
+      identical = identical && captureState(world.getBodyStore()) == expected;
+      rollbacks++;
+    }
+  }
+
+  /* A state saved before a body was destroyed no longer fits the world */
+  size_t awake = world.getAwakeBodyCount();
+  world.saveState(0U);
+  world.destroyBody(world.getBodyStore().ids[1]);
+  bool rejected = !world.restoreState(0U);
+
+  std::printf("%u bodies (%zu awake at the end), %u rollbacks of %u frames: replay %s, stale state %s\n", bodyCount, awake, rollbacks, ROLLBACK_FRAMES + 1U,
+              identical ? "bit identical" : "DIVERGED", rejected ? "rejected" : "ACCEPTED");
+  std::printf("save %.2f us, restore %.2f us on average\n", saveSeconds * 1e6 / FRAME_COUNT, restoreSeconds * 1e6 / rollbacks);
+  return (identical && rejected) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,125 @@
+/*******************************************************************************************************************************
+ * @file   main.cc
+ *
+ * @brief  Main file for snapshot example, saves a settling pile mid-simulation and checks a reloaded world resumes bit for bit
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Inter-component Headers */
+#include "physics_world.h"
+#include "sphere.h"
+
+/* Intra-component Headers */
+
+namespace {
+const uint32_t DEFAULT_BODY_COUNT = 2000U;
+const uint32_t STEPS_BEFORE_SAVE = 400U;
+const uint32_t STEPS_AFTER_SAVE = 120U;
+
+double getMilliseconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool isColumnEqual(const AlignedArray<float> &a, const AlignedArray<float> &b) {
+  return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+bool isColumnEqual(const Vector3DArray &a, const Vector3DArray &b) {
+  return isColumnEqual(a.x, b.x) && isColumnEqual(a.y, b.y) && isColumnEqual(a.z, b.z);
+}
+
+/* Compares the bits, not the values, so -0 against 0 or a different NaN counts as a mismatch */
+bool isStateEqual(const BodyStore &a, const BodyStore &b) {
+  return a.size() == b.size() && std::memcmp(a.ids.data(), b.ids.data(), a.size() * sizeof(BodyId)) == 0 &&
+         std::memcmp(a.sleepIsland.data(), b.sleepIsland.data(), a.size() * sizeof(uint32_t)) == 0 && isColumnEqual(a.sleepTime, b.sleepTime) &&
+         isColumnEqual(a.position, b.position) && isColumnEqual(a.linearVelocity, b.linearVelocity) && isColumnEqual(a.angularVelocity, b.angularVelocity) &&
+         isColumnEqual(a.orientation.w, b.orientation.w) && isColumnEqual(a.orientation.x, b.orientation.x) && isColumnEqual(a.orientation.y, b.orientation.y) &&
+         isColumnEqual(a.orientation.z, b.orientation.z);
+}
+
+void buildPile(PhysicsWorld &world, uint32_t bodyCount) {
+  /* A pile of spheres settling on a large static sphere, so the snapshot catches contacts, warm start impulses and sleepers */
+  BodyDesc ground;
+  ground.shape = std::make_shared<Sphere>(200.0f, 0.0f);
+  ground.position = Vector3D(0, -200, 0);
+  world.createBody(ground);
+
+  std::shared_ptr<Sphere> ball = std::make_shared<Sphere>(0.5f);
+  std::shared_ptr<Sphere> bouncy = std::make_shared<Sphere>(0.5f, 2.0f);
+  bouncy->restitution = 0.8f;
+
+  std::vector<BodyId> ids;
+  for (uint32_t i = 0U; i < bodyCount; i++) {
+    BodyDesc desc;
+    desc.shape = (i % 7U == 0U) ? bouncy : ball;
+    desc.position = Vector3D((i % 15U) * 1.02f - 7.5f + 0.01f * (i % 3U), 0.6f + (i / 225U) * 1.02f, ((i / 15U) % 15U) * 1.02f - 7.5f);
+    ids.push_back(world.createBody(desc));
+  }
+
+  /* Holes in the handle table, so the free list has to survive the round trip */
+  for (uint32_t i = 0U; i < bodyCount; i += 97U) {
+    world.destroyBody(ids[i]);
+  }
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  uint32_t bodyCount = (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : DEFAULT_BODY_COUNT;
+  uint32_t threadCount = (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : 1U;
+  std::string path = (argc > 3) ? argv[3] : "world.snapshot";
+
+  PhysicsWorld world;
+  world.setBroadphase(BroadphaseType::SPATIAL_HASH);
+  buildPile(world, bodyCount);
+  for (uint32_t step = 0U; step < STEPS_BEFORE_SAVE; step++) {
+    world.step();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  if (!world.saveSnapshot(path)) {
+    std::printf("could not write %s\n", path.c_str());
+    return EXIT_FAILURE;
+  }
+  std::printf("saved %zu bodies (%zu awake) in %.3f ms, %ju bytes\n", world.getBodyCount(), world.getAwakeBodyCount(), getMilliseconds(start),
+              static_cast<uintmax_t>(std::filesystem::file_size(path)));
+
+  /* The loaded world runs on its own thread count, results must not depend on it */
+  PhysicsWorld loaded;
+  loaded.setThreadCount(threadCount);
+  start = std::chrono::steady_clock::now();
+  if (!loaded.loadSnapshot(path)) {
+    std::printf("could not load %s\n", path.c_str());
+    return EXIT_FAILURE;
+  }
+  std::printf("loaded in %.3f ms on %u threads\n", getMilliseconds(start), loaded.getThreadCount());
+
+  bool equal = isStateEqual(world.getBodyStore(), loaded.getBodyStore());
+  for (uint32_t step = 0U; step < STEPS_AFTER_SAVE && equal; step++) {
+    world.step();
+    loaded.step();
+    equal = isStateEqual(world.getBodyStore(), loaded.getBodyStore());
+    if (!equal) {
+      std::printf("diverged on step %u after the save\n", step);
+    }
+  }
+
+  /* A cut off file must be rejected and leave the world as it was */
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2U);
+  bool rejected = !loaded.loadSnapshot(path) && loaded.getBodyCount() == world.getBodyCount();
+  std::filesystem::remove(path);
+
+  std::printf("resume %s, truncated file %s\n", equal ? "bit identical" : "DIVERGED", rejected ? "rejected" : "ACCEPTED");
+  return (equal && rejected) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,88 @@
+/*******************************************************************************************************************************
+ * @file   main.cc
+ *
+ * @brief  Main file for spin_drift example, checks that fast spinning bodies keep unit length orientations
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+/* Inter-component Headers */
+#include "physics_world.h"
+#include "sphere.h"
+
+/* Intra-component Headers */
+
+namespace {
+const uint32_t STEP_COUNT = 600U;
+const float TIME_STEP = 1.0f / 60.0f;
+const float SPIN_RATES[] = {4.0f, 60.0f, 100.0f, 300.0f}; /**< rad/s, the fast ones add a lot of length each step */
+const float LENGTH_TOLERANCE = 1e-5f;
+
+/* How much rotate() scales a vector, |q|^2 for a quaternion that isn't unit length. Not a number once it has collapsed */
+float rotateScale(const Quaternion &orientation) {
+  return orientation.rotate(Vector3D(0, 0, 1)).length();
+}
+}  // namespace
+
+int main() {
+  /* Bodies far apart in zero gravity, so each keeps its spin and only integration touches the orientation. Nine bodies per rate
+     put some in full packs and some in the leftover lanes */
+  PhysicsWorld world;
+  world.setGravity(Vector3D(0, 0, 0));
+  world.setTimeStep(TIME_STEP);
+  world.setSleepingEnabled(false);
+
+  const Vector3D axis = Vector3D(1, 2, 3).normalize();
+  const uint32_t perRate = 9U;
+  std::shared_ptr<Sphere> ball = std::make_shared<Sphere>(0.5f);
+  for (float rate : SPIN_RATES) {
+    for (uint32_t i = 0U; i < perRate; i++) {
+      BodyDesc desc;
+      desc.shape = ball;
+      desc.position = Vector3D(static_cast<float>(world.getBodyCount()) * 10.0f, 0, 0);
+      desc.angularVelocity = axis * rate;
+      world.createBody(desc);
+    }
+  }
+
+  for (uint32_t step = 0U; step < STEP_COUNT; step++) {
+    world.step();
+  }
+
+  bool valid = true;
+  const BodyStore &store = world.getBodyStore();
+  for (uint32_t rate = 0U; rate < sizeof(SPIN_RATES) / sizeof(SPIN_RATES[0]); rate++) {
+    /* The world's packed integration, and the scalar one on its own */
+    float worldError = 0.0f;
+    float worldScale = 1.0f;
+    bool unit = true;
+    for (uint32_t i = rate * perRate; i < (rate + 1U) * perRate; i++) {
+      Quaternion orientation = store.orientation.get(i);
+      float error = std::fabs(1.0f - orientation.lengthSquared());
+      unit = unit && error <= LENGTH_TOLERANCE;
+      worldError = std::max(worldError, error);
+      worldScale = rotateScale(orientation);
+    }
+
+    Quaternion scalar;
+    for (uint32_t step = 0U; step < STEP_COUNT; step++) {
+      scalar = scalar.integrate(axis * SPIN_RATES[rate], TIME_STEP);
+    }
+    float scalarError = std::fabs(1.0f - scalar.lengthSquared());
+
+    unit = unit && scalarError <= LENGTH_TOLERANCE;
+    std::printf("%5.0f rad/s, %u steps: world |1 - |q|^2| %.2e (rotate scale %.6f), scalar %.2e (rotate scale %.6f): %s\n", SPIN_RATES[rate], STEP_COUNT, worldError,
+                worldScale, scalarError, rotateScale(scalar), unit ? "ok" : "DRIFTED");
+    valid = valid && unit;
+  }
+
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
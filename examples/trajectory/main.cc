@@ -0,0 +1,145 @@
+/*******************************************************************************************************************************
+ * @file   main.cc
+ *
+ * @brief  Main file for trajectory example, records a scene to disk while it runs and reads frames back out of order
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Inter-component Headers */
+#include "physics_world.h"
+#include "sphere.h"
+#include "trajectory_recorder.h"
+
+/* Intra-component Headers */
+
+namespace {
+const uint32_t DEFAULT_BODY_COUNT = 5000U;
+const uint32_t DEFAULT_STEP_COUNT = 300U;
+const uint32_t CHECKED_FRAME_STRIDE = 37U; /**< Every this many frames is kept in memory to check the file against */
+
+struct CheckedFrame {
+  uint64_t index;
+  std::vector<BodyId> ids;
+  std::vector<Vector3D> positions;
+  std::vector<Quaternion> orientations;
+};
+
+void buildScene(PhysicsWorld &world, uint32_t bodyCount) {
+  /* Spheres raining onto a large static sphere, some settle and sleep while others are still falling */
+  world.setBroadphase(BroadphaseType::SPATIAL_HASH);
+
+  BodyDesc ground;
+  ground.shape = std::make_shared<Sphere>(200.0f, 0.0f);
+  ground.position = Vector3D(0, -200, 0);
+  world.createBody(ground);
+
+  std::shared_ptr<Sphere> ball = std::make_shared<Sphere>(0.5f);
+  for (uint32_t i = 0U; i < bodyCount; i++) {
+    BodyDesc desc;
+    desc.shape = ball;
+    desc.position = Vector3D((i % 30U) * 1.1f - 16.5f, 0.6f + (i / 900U) * 1.1f, ((i / 30U) % 30U) * 1.1f - 16.5f);
+    desc.angularVelocity = Vector3D(0.1f * (i % 5U), 0.0f, 0.1f * (i % 3U));
+    world.createBody(desc);
+  }
+}
+
+/* Seconds taken by the steps, record() included */
+double runScene(uint32_t bodyCount, uint32_t stepCount, TrajectoryRecorder *recorder, std::vector<CheckedFrame> &checked) {
+  PhysicsWorld world;
+  buildScene(world, bodyCount);
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t step = 0U; step < stepCount; step++) {
+    world.step();
+    if (recorder) {
+      recorder->record(world);
+    }
+
+    if (step % CHECKED_FRAME_STRIDE == 0U) {
+      const BodyStore &store = world.getBodyStore();
+      CheckedFrame frame{step, {}, {}, {}};
+      for (uint32_t i = 0U; i < store.size(); i++) {
+        frame.ids.push_back(store.ids[i]);
+        frame.positions.push_back(store.position.get(i));
+        frame.orientations.push_back(store.orientation.get(i));
+      }
+      checked.push_back(std::move(frame));
+    }
+  }
+
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  uint32_t bodyCount = (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : DEFAULT_BODY_COUNT;
+  uint32_t stepCount = (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : DEFAULT_STEP_COUNT;
+  std::string path = (argc > 3) ? argv[3] : "world.trajectory";
+
+  /* Both runs keep the same frames, so the difference between them is the recorder */
+  std::vector<CheckedFrame> checked;
+  double plainSeconds = runScene(bodyCount, stepCount, nullptr, checked);
+  checked.clear();
+
+  TrajectoryOptions options;
+  TrajectoryRecorder recorder;
+  if (!recorder.open(path, options)) {
+    std::printf("could not create %s\n", path.c_str());
+    return EXIT_FAILURE;
+  }
+
+  double recordedSeconds = runScene(bodyCount, stepCount, &recorder, checked);
+  auto start = std::chrono::steady_clock::now();
+  bool written = recorder.close();
+  double drainSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  const double rawBytes = static_cast<double>(stepCount) * (bodyCount + 1U) * (7U * sizeof(float));
+  std::printf("%u steps of %u bodies: %.3f s plain, %.3f s recording (%+.1f%%), %.3f s draining on close, %llu stalls\n", stepCount, bodyCount, plainSeconds, recordedSeconds,
+              (recordedSeconds / plainSeconds - 1.0) * 100.0, drainSeconds, static_cast<unsigned long long>(recorder.getStallCount()));
+  std::printf("%llu frames, %llu bytes, %.2f bytes per body per frame (%.1fx smaller than raw floats)\n", static_cast<unsigned long long>(recorder.getWrittenFrames()),
+              static_cast<unsigned long long>(recorder.getWrittenBytes()), static_cast<double>(recorder.getWrittenBytes()) / (static_cast<double>(stepCount) * (bodyCount + 1U)),
+              rawBytes / static_cast<double>(recorder.getWrittenBytes()));
+
+  /* Read the kept frames back newest first, so every read seeks */
+  TrajectoryReader reader;
+  bool valid = written && reader.open(path) && reader.getFrameCount() == stepCount;
+  float positionError = 0.0f;
+  float orientationError = 0.0f;
+  TrajectoryFrame frame;
+  for (auto expected = checked.rbegin(); valid && expected != checked.rend(); ++expected) {
+    valid = reader.readFrame(expected->index, frame) && frame.ids.size() == expected->ids.size();
+    for (size_t i = 0U; valid && i < frame.ids.size(); i++) {
+      Vector3D position = frame.positions[i] - expected->positions[i];
+      positionError = std::max({positionError, std::fabs(position.x), std::fabs(position.y), std::fabs(position.z)});
+      orientationError = std::max({orientationError, std::fabs(frame.orientations[i].w - expected->orientations[i].w), std::fabs(frame.orientations[i].x - expected->orientations[i].x),
+                                   std::fabs(frame.orientations[i].y - expected->orientations[i].y), std::fabs(frame.orientations[i].z - expected->orientations[i].z)});
+      valid = frame.ids[i] == expected->ids[i];
+    }
+  }
+
+  start = std::chrono::steady_clock::now();
+  for (uint64_t index = 0U; valid && index < reader.getFrameCount(); index++) {
+    valid = reader.readFrame(index, frame);
+  }
+  double readSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::filesystem::remove(path);
+
+  /* Quantization error plus float rounding of the positions, which are tens of metres at most */
+  valid = valid && positionError <= options.positionPrecision * 0.5f + 1e-5f && orientationError <= 0.5f / TRAJECTORY_ORIENTATION_SCALE + 1e-6f;
+  std::printf("read back: max position error %.6f, max orientation error %.6f, all frames in order %.3f s, %s\n", positionError, orientationError, readSeconds,
+              valid ? "ok" : "MISMATCH");
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -10,9 +10,12 @@
  *******************************************************************************************************************************/
 
 /* Standard library Headers */
+#include <cstdint>
 
 /* Inter-component Headers */
 #include "matrix_3d.h"
+#include "memory_manager.h"
+#include "quaternion.h"
 #include "vector_3d.h"
 
 /* Intra-component Headers */
@@ -23,16 +26,45 @@
  * @{
  */
 
+/**
+ * @brief   Concrete type of a shape, used to pick collision routines without RTTI
+ */
+enum class ShapeType : uint8_t {
+  SPHERE, /**< Sphere */
+  COUNT   /**< Number of shape types, not a type itself */
+};
+
 class Shape {
  protected:
   Vector3D position;
-  Matrix3D orientation;
+  Quaternion orientation;
   Vector3D boundingBoxMin;
   Vector3D boundingBoxMax;
 
+  explicit Shape(ShapeType type) : type(type) {}
+
  public:
   virtual ~Shape() = default;
 
+  /**
+   * @brief   Shapes live in the engine's MemoryManager. std::allocate_shared with a PoolAllocator puts the shared_ptr control
+   *          block there too, std::make_shared bypasses both
+   */
+  static void *operator new(size_t size) {
+    return MemoryManager::getInstance().allocate(size);
+  }
+
+  static void operator delete(void *ptr) {
+    MemoryManager::getInstance().deallocate(ptr);
+  }
+
+  /**
+   * @brief   Concrete type of the shape, fixed at construction
+   */
+  ShapeType getType() const {
+    return this->type;
+  }
+
   /** @brief    Measurement of bounciness */
   float restitution{0.5f};
   /** @brief    Measurement of friction */
@@ -43,7 +75,7 @@ class Shape {
     this->position = pos;
   }
 
-  virtual void setOrientation(const Matrix3D &orient) {
+  virtual void setOrientation(const Quaternion &orient) {
     this->orientation = orient;
   }
 
@@ -51,10 +83,17 @@ class Shape {
     return this->position;
   }
 
-  virtual Matrix3D getOrientation() const {
+  virtual Quaternion getOrientation() const {
     return this->orientation;
   }
 
+  /**
+   * @brief   Rotation matrix of the orientation, derived on every call
+   */
+  Matrix3D getRotationMatrix() const {
+    return this->orientation.toMatrix();
+  }
+
   // Physics properties
   virtual float getMass() const = 0;
   virtual float getVolume() const = 0;
@@ -82,6 +121,9 @@ class Shape {
   float getFriction() const {
     return friction;
   }
+
+ private:
+  ShapeType type;
 };
 
 /** @} */
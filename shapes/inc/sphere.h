@@ -36,6 +36,7 @@ class Sphere : public Shape {
 
   float getRadius() const;
   void setRadius(float newRadius);
+  float getDensity() const;
 
   // Shape interface implementation
   float getMass() const override;
@@ -20,7 +20,7 @@ void Sphere::updateMass() {
   this->mass = this->density * getVolume();
 }
 
-Sphere::Sphere(float radius, float density) {
+Sphere::Sphere(float radius, float density) : Shape(ShapeType::SPHERE) {
   this->radius = radius;
   this->density = density;
 
@@ -38,6 +38,10 @@ void Sphere::setRadius(float newRadius) {
   this->radius = newRadius;
 }
 
+float Sphere::getDensity() const {
+  return this->density;
+}
+
 float Sphere::getMass() const {
   return this->mass;
 }
@@ -10,11 +10,24 @@
  *******************************************************************************************************************************/
 
 /* Standard library Headers */
+#include <array>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
 #include <vector>
 
 /* Inter-component Headers */
+#include "body_store.h"
+#include "broadphase.h"
 #include "collision.h"
+#include "contact_solver.h"
+#include "frame_arena.h"
+#include "job_system.h"
 #include "matrix_3d.h"
+#include "memory_manager.h"
+#include "profiler.h"
 #include "rigid_body.h"
 #include "shape.h"
 #include "vector_3d.h"
@@ -27,36 +40,287 @@
  * @{
  */
 
+/**
+ * @brief   Where the last step's time went and how much work it did
+ * @details Only filled in by profiling builds (make PROFILE=1), every field stays zero otherwise. Times are in seconds
+ */
+struct StepStats {
+  double stepSeconds;                /**< The whole step */
+  double buildActiveListSeconds;     /**< Gathering the awake bodies, including a rebuild after islands woke */
+  double detectCollisionsSeconds;    /**< Broadphase, narrowphase and contact merge together */
+  double broadphaseSeconds;          /**< Moving proxies and finding overlapping pairs */
+  double narrowphaseSeconds;         /**< Testing the pairs, on every thread */
+  double mergeContactsSeconds;       /**< Gathering the per-thread contact streams into pair order */
+  double integrateVelocitiesSeconds; /**< Applying gravity and forces to the velocities */
+  double resolveCollisionsSeconds;   /**< The contact solver */
+  double integratePositionsSeconds;  /**< Moving the bodies */
+  double updateSleepSeconds;         /**< Island building and putting bodies to sleep */
+  uint64_t activeBodies;             /**< Awake bodies, static ones included */
+  uint64_t broadphasePairs;          /**< Overlapping pairs from the broadphase */
+  uint64_t pairsTested;              /**< Pairs that went through the narrowphase, after the sleep filter */
+  uint64_t contacts;                 /**< Contacts produced */
+  uint64_t bodiesIntegrated;         /**< Awake bodies with mass */
+};
+
 class PhysicsWorld {
  public:
   PhysicsWorld();
+  ~PhysicsWorld();
+
+  PhysicsWorld(const PhysicsWorld &) = delete;
+  PhysicsWorld &operator=(const PhysicsWorld &) = delete;
 
   // World configuration
   void setGravity(const Vector3D &gravity);
   void setTimeStep(float step);
 
+  /**
+   * @brief   Switch the broadphase used for pair generation. Existing bodies are moved over to the new broadphase
+   */
+  void setBroadphase(BroadphaseType type);
+  BroadphaseType getBroadphaseType() const;
+
+  /**
+   * @brief   Set how many threads step() runs on, including the calling thread. 0 uses every hardware thread
+   * @details Results are identical for any thread count
+   */
+  void setThreadCount(uint32_t threadCount);
+  uint32_t getThreadCount() const;
+
+  /**
+   * @brief   Let islands of touching bodies that have come to rest go to sleep. Disabling wakes every body
+   */
+  void setSleepingEnabled(bool enabled);
+
+  /**
+   * @brief   Set when an island falls asleep
+   * @param   linearVelocity Speed every body in the island must stay under
+   * @param   angularVelocity Angular speed every body in the island must stay under, in rad/s
+   * @param   timeToSleep How long (seconds) the island must stay under both thresholds
+   */
+  void setSleepThresholds(float linearVelocity, float angularVelocity, float timeToSleep);
+
+  /**
+   * @brief   Set the number of contact solver iterations. More iterations give stiffer stacks at a higher cost
+   * @param   velocityIterations Passes over the contacts solving for velocities
+   * @param   positionIterations Passes solving the split impulse penetration recovery
+   */
+  void setSolverIterations(uint32_t velocityIterations, uint32_t positionIterations);
+  void setPositionCorrection(PositionCorrection mode);
+
+  /**
+   * @brief   Start each step's solve from the previous step's contact impulses
+   */
+  void setWarmStarting(bool enabled);
+
   // Object management
-  void addRigidBody(std::shared_ptr<RigidBody> body);
+  /**
+   * @brief   Move a body into the world's store. The RigidBody becomes a view of its slot in the world
+   */
+  BodyId addRigidBody(std::shared_ptr<RigidBody> body);
+
+  /**
+   * @brief   Take a body out of the world. Its state is copied back into the RigidBody, O(1)
+   */
   void removeRigidBody(std::shared_ptr<RigidBody> body);
 
+  BodyId createBody(const BodyDesc &desc);
+
+  /**
+   * @brief   Create a batch of bodies
+   * @param   descs Description of each body
+   * @param   ids Receives the handle of each body, must be at least as long as descs
+   */
+  void createBodies(std::span<const BodyDesc> descs, std::span<BodyId> ids);
+
+  /**
+   * @brief   Destroy a body, O(1). Stale handles are ignored. A RigidBody view of it keeps the body's last state
+   */
+  void destroyBody(BodyId id);
+  void destroyBodies(std::span<const BodyId> ids);
+
+  /**
+   * @brief   Check if a handle still refers to a live body, O(1)
+   */
+  bool isValid(BodyId id) const;
+
+  /**
+   * @brief   Get a RigidBody view of a live body, created on first use. Returns nullptr for stale handles
+   * @details Not const, the view can change the body. Read through getBodyStore() from a const world
+   */
+  std::shared_ptr<RigidBody> getBody(BodyId id);
+
   // Simulation
   void step();
   void reset();
 
   // Access
   size_t getBodyCount() const;
-  std::vector<std::shared_ptr<RigidBody>> getBodies() const;
+  size_t getAwakeBodyCount() const;
+  std::vector<std::shared_ptr<RigidBody>> getBodies();
+
+  /**
+   * @brief   Find every body whose bounds overlap the box. Uses the broadphase, so bounds are as of the last step
+   */
+  std::vector<std::shared_ptr<RigidBody>> queryAABB(const AABB &box);
+
+  /**
+   * @brief   Direct access to the structure of arrays body storage
+   */
+  const BodyStore &getBodyStore() const;
+
+  /**
+   * @brief   Timings and work counts of the last step, all zeros unless built with PROFILE=1
+   */
+  const StepStats &getStepStats() const;
+
+  // Snapshots
+  /**
+   * @brief   Write the whole simulation state to a binary snapshot in one sequential pass, see world_snapshot.h for the layout
+   * @details Body columns, shapes, the handle table, sleeping islands, cached contact impulses and the world settings. The thread
+   *          count is not saved, results don't depend on it
+   * @return  false if the file couldn't be written
+   */
+  bool saveSnapshot(const std::string &path) const;
+
+  /**
+   * @brief   Replace the world's contents with a snapshot. Stepping continues bit for bit like the world that was saved
+   * @details The file is memory mapped and each column copied into the store with one memcpy. Handles issued by the saved world
+   *          are valid in this one. Views of the current bodies are detached, as with reset()
+   * @return  false if the file is missing, truncated or from an incompatible writer, the world is left untouched
+   */
+  bool loadSnapshot(const std::string &path);
+
+  // Rollback
+  /**
+   * @brief   Set up a ring of state slots for saveState() and restoreState(), sized for the current bodies
+   * @details Slots are allocated here, so saving and restoring don't allocate unless the body count grows past this point.
+   *          Changing the count drops every saved state
+   */
+  void setStateSlotCount(uint32_t count);
+  uint32_t getStateSlotCount() const;
+
+  /**
+   * @brief   Copy the dynamic state of every body into a slot of the ring, a handful of memcpys
+   * @details Positions, orientations, velocities, force accumulators, sleeping state and the warm start impulses. Shapes, mass
+   *          properties and world settings are shared with the live world and aren't copied. Slot numbers wrap around the ring,
+   *          so a frame number can be used directly
+   * @return  false if there are no slots
+   */
+  bool saveState(uint32_t slot);
+
+  /**
+   * @brief   Put every body back to the state saved in a slot. Stepping on from it repeats the original steps bit for bit
+   * @return  false if the slot is empty or bodies were created or destroyed since it was saved, the world is left untouched
+   */
+  bool restoreState(uint32_t slot);
 
  private:
-  std::vector<std::shared_ptr<RigidBody>> bodies;
-  std::vector<Contact> contacts;
+  static constexpr uint32_t NARROWPHASE_GRAIN_SIZE = 64U; /**< Pairs per narrowphase job */
+  static constexpr uint32_t INTEGRATE_GRAIN_SIZE = 256U;  /**< Bodies per integration job, a multiple of every SIMD pack width */
+  static constexpr float DEFAULT_LINEAR_SLEEP_THRESHOLD = 0.05f;
+  static constexpr float DEFAULT_ANGULAR_SLEEP_THRESHOLD = 0.05f;
+  static constexpr float DEFAULT_TIME_TO_SLEEP = 0.5f;
+  static constexpr size_t CONTACT_STREAM_SLACK = 64U;     /**< Extra room in each contact stream on top of last step's contact count */
+
+  /**
+   * @brief   Position of a contact in the merged streams, sorted to put the contacts in pair order
+   */
+  struct ContactSortKey {
+    uint64_t pairKey;
+    uint32_t index;
+
+    bool operator<(const ContactSortKey &other) const {
+      return pairKey < other.pairKey || (pairKey == other.pairKey && index < other.index);
+    }
+  };
+
+  /**
+   * @brief   Dynamic state of every body, as copied by saveState()
+   */
+  struct SavedState {
+    uint64_t bodySetVersion{0U}; /**< bodySetVersion at the save, 0 while the slot is empty */
+    Vector3DArray position;
+    QuaternionArray orientation;
+    Vector3DArray linearVelocity;
+    Vector3DArray angularVelocity;
+    Vector3DArray force;
+    Vector3DArray torque;
+    AlignedArray<float> sleepTime;
+    AlignedArray<uint32_t> sleepIsland;
+    std::vector<std::vector<BodyId>> sleepingIslands;
+    std::vector<uint32_t> freeIslands;
+    std::vector<ContactSolver::CachedImpulse> impulseCache;
+  };
+
+  BodyStore bodyStore;
+  /* Owners of the views, indexed like bodyStore. Bodies created in bulk get their view lazily. The world's own containers
+     allocate from the memory manager */
+  std::pmr::vector<std::shared_ptr<RigidBody>> bodies{&MemoryManager::getInstance()};
+
+  /* Everything that only lives for one step comes from the job system's per-thread arenas. They are reset at the start of
+     step(), so once they have grown to fit the scene a step does no heap allocation */
+  FrameVector<Contact> contacts;
+  FrameVector<Contact> unsortedContacts;
+  FrameVector<ContactSortKey> contactSortKeys;
+  /* Contact stream of each job system thread, in that thread's arena */
+  std::pmr::vector<FrameVector<Contact>> workerContacts{&MemoryManager::getInstance()};
+  FrameVector<size_t> workerContactOffsets; /**< Start of each stream in contacts after the merge */
+  /* Pairs left after the sleep filter, per job system thread and shape type pair */
+  std::pmr::vector<std::array<FrameVector<BroadphasePair>, CollisionDetector::SHAPE_PAIR_COUNT>> workerPairs{&MemoryManager::getInstance()};
+  ContactSolver contactSolver;
+  std::unique_ptr<JobSystem> jobs;
+  std::unique_ptr<Broadphase> broadphase;
+  BroadphaseType broadphaseType;
 
   Vector3D gravity;
   float timeStep;
 
+  // Sleeping
+  bool sleepingEnabled;
+  float linearSleepThreshold;
+  float angularSleepThreshold;
+  float timeToSleep;
+  FrameVector<uint32_t> activeBodies;        /**< Awake bodies this step, the only ones that get moved, integrated or tested */
+  FrameVector<uint32_t> activeDynamicBodies; /**< Awake bodies with mass, the compacted list the integrator runs over */
+  FrameVector<uint32_t> islandParent;        /**< Union-find parent of each body, only valid for active bodies */
+  FrameVector<float> islandSleepTime;        /**< Shortest sleep time in each island, stored at the island's root */
+  FrameVector<uint64_t> sleepCandidates;     /**< (island root << 32 | body index) of bodies in islands ready to sleep */
+  FrameVector<uint32_t> islandScratch;
+
+  /* Ring of rollback slots. The body set version changes whenever bodies are created or destroyed, so a state saved before that
+     can't be restored over a different set of bodies */
+  std::vector<SavedState> savedStates;
+  uint64_t bodySetVersion{1U};
+
+  StepStats stepStats{};
+  std::atomic<uint64_t> pairsTested{0U}; /**< Narrowphase jobs add up their pairs here, profiling builds only */
+
+  AABB computeBoundingBox(uint32_t index) const;
+  void registerBody(BodyId id, std::shared_ptr<RigidBody> view);
+
+  /**
+   * @brief   Reset the frame arenas and point the per-step containers at them, reserving last step's sizes
+   */
+  void beginFrame();
+
+  bool isActiveDynamic(uint32_t index) const;
+  void buildActiveList();
+
   void detectCollisions();
+  void mergeContacts();
+
+  /**
+   * @brief   Wake sleeping islands that an awake body touches
+   * @return  true if anything woke up
+   */
+  bool wakeTouchedIslands();
   void resolveCollisions();
-  void integrateForces();
+  void integrateVelocities();
+  void integratePositions();
+
+  uint32_t findIsland(uint32_t index);
+  void updateSleep();
 };
 
 /** @} */
@@ -0,0 +1,190 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   state_replication.h
+ *
+ * @brief  Header file for encoding world state into compact delta packets for remote observers, and decoding them
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/* Inter-component Headers */
+#include "body_store.h"
+#include "quaternion.h"
+#include "vector_3d.h"
+
+/* Intra-component Headers */
+#include "physics_world.h"
+
+/**
+ * @defgroup WorldModules
+ * @brief    World modules for environment definitions
+ * @{
+ */
+
+/**
+ * @brief   Replication packet layout
+ * @details A ReplicationPacketHeader, then a little endian bit stream of entryCount entries in ascending handle slot order. An
+ *          entry is the gap to the previous entry's slot (Elias gamma), a 2 bit ReplicationEntry kind and, unless the body was
+ *          removed, a sleeping bit and the body's transform. Positions are quantized to a grid of positionPrecision metres,
+ *          orientations to smallest-three: the index of the largest component and the other three in orientationBits bits each.
+ *          An UPDATE is the change from the baseline, a SPAWN (New body, or a reused slot) carries the generation and the whole
+ *          transform. Slots the packet doesn't mention are as in the baseline
+ */
+constexpr uint32_t REPLICATION_NO_BASELINE = 0xFFFFFFFFU;  /**< Baseline sequence of a packet that carries every body */
+constexpr uint32_t REPLICATION_MAX_ORIENTATION_BITS = 10U; /**< So a smallest-three quaternion packs into 32 bits */
+
+struct ReplicationPacketHeader {
+  uint32_t sequence;   /**< Tick the packet brings the decoder to */
+  uint32_t baseline;   /**< Tick it is a delta against, or REPLICATION_NO_BASELINE */
+  uint32_t slotCount;  /**< Handle slots in use at the tick, one past the highest */
+  uint32_t entryCount; /**< Entries in the bit stream that follows */
+};
+
+static_assert(sizeof(ReplicationPacketHeader) == 16U, "The header layout is part of the packet format");
+
+enum class ReplicationEntry : uint32_t {
+  UPDATE,  /**< Transform or sleeping changed since the baseline */
+  SPAWN,   /**< Slot wasn't in the baseline or holds a different body now */
+  REMOVED, /**< Body in the baseline is gone */
+};
+
+struct ReplicationOptions {
+  float positionPrecision{0.001f}; /**< Metres per position quantum, the largest position error is half of this */
+  uint32_t orientationBits{10U};   /**< Bits per smallest-three component, at most REPLICATION_MAX_ORIENTATION_BITS */
+  uint32_t historyLength{32U};     /**< Ticks kept as possible baselines, an ack older than this gets a full packet */
+  uint32_t maxSlots{1U << 20U};    /**< Most handle slots a packet may carry, so a damaged header can't size a huge tick */
+};
+
+/**
+ * @brief   A body as last decoded by a ReplicationDecoder
+ */
+struct ReplicatedBody {
+  BodyId id;
+  Vector3D position;
+  Quaternion orientation;
+  bool asleep;
+};
+
+/**
+ * @brief   Body transforms of one tick, quantized and indexed by handle slot, as kept by both ends for delta coding
+ */
+struct ReplicationTick {
+  uint32_t sequence{REPLICATION_NO_BASELINE};
+  uint32_t slotCount{0U};
+  std::vector<uint32_t> generation;  /**< Generation of the body in each slot, 0 for an empty slot */
+  std::vector<int32_t> position;     /**< Quantized x, y, z per slot */
+  std::vector<uint32_t> orientation; /**< Packed smallest-three quaternion per slot */
+  std::vector<uint8_t> asleep;
+
+  void resize(uint32_t slots);
+};
+
+/**
+ * @brief   Turns the world's body transforms into delta packets against whatever each observer has acknowledged
+ * @details capture() quantizes the world once per tick into a ring of past ticks. encode() then writes the latest tick against a
+ *          baseline tick the observer acknowledged, so serving many observers costs one capture and one encode each. Bodies
+ *          whose quantized transform and sleeping state match the baseline aren't written at all, which covers every sleeping
+ *          body and anything resting. Once the ring is sized for the world's bodies, neither call allocates
+ */
+class ReplicationEncoder {
+ public:
+  explicit ReplicationEncoder(const ReplicationOptions &options = ReplicationOptions());
+
+  /**
+   * @brief   Size the ring of ticks for this many handle slots up front, so the first captures don't allocate either
+   */
+  void reserve(uint32_t slotCount);
+
+  /**
+   * @brief   Quantize the world's current body transforms as the next tick
+   * @return  Sequence number of the tick, for encode() and for observers to acknowledge
+   */
+  uint32_t capture(const PhysicsWorld &world);
+
+  /**
+   * @brief   Write the latest captured tick as a delta against a baseline tick
+   * @param   baseline Last tick the observer acknowledged, or REPLICATION_NO_BASELINE. A tick that has left the ring (Or was
+   *          never captured) is treated as no baseline, so the packet carries every body
+   * @return  Bytes written, 0 if nothing was captured yet, the tick has more than maxSlots slots or the packet doesn't fit,
+   *          getMaxPacketSize() always does
+   */
+  size_t encode(uint32_t baseline, std::span<uint8_t> packet) const;
+
+  /**
+   * @brief   Largest packet encode() can write for the latest tick
+   */
+  size_t getMaxPacketSize() const;
+
+  uint32_t getLatestSequence() const;
+  const ReplicationOptions &getOptions() const;
+
+ private:
+  ReplicationOptions options;
+  std::vector<ReplicationTick> ticks; /**< Ring of past ticks, indexed by sequence modulo its size */
+  uint32_t nextSequence{0U};
+  ReplicationTick empty; /**< Baseline with every slot empty */
+
+  const ReplicationTick *findTick(uint32_t sequence) const;
+};
+
+/**
+ * @brief   Rebuilds body transforms from the packets of a ReplicationEncoder with the same options
+ * @details Every decoded tick is kept in a ring like the encoder's, since the server may delta against any tick the observer has
+ *          acknowledged. Packets older than the latest decoded tick are ignored, so they can arrive out of order or not at all.
+ *          Decoding allocates nothing once the ring is sized for the world's bodies
+ */
+class ReplicationDecoder {
+ public:
+  explicit ReplicationDecoder(const ReplicationOptions &options = ReplicationOptions());
+
+  void reserve(uint32_t slotCount);
+
+  /**
+   * @brief   Forget every decoded tick, as for a new connection. The next packet has to be one without a baseline
+   */
+  void reset();
+
+  /**
+   * @brief   Apply a packet on top of its baseline
+   * @return  false if the packet is damaged, is stale, or its baseline is no longer (Or never was) in the ring. The decoded
+   *          state is left as it was
+   */
+  bool decode(std::span<const uint8_t> packet);
+
+  /**
+   * @brief   Sequence of the latest decoded tick, the one to acknowledge, or REPLICATION_NO_BASELINE before the first packet
+   */
+  uint32_t getLatestSequence() const;
+
+  /**
+   * @brief   Entries in the last packet decoded, the bodies that changed
+   */
+  uint32_t getLastEntryCount() const;
+
+  /**
+   * @brief   One past the highest handle slot in the latest tick
+   */
+  uint32_t getSlotCount() const;
+
+  /**
+   * @brief   Dequantized body in a slot of the latest tick
+   * @return  false if the slot is empty
+   */
+  bool getBody(uint32_t slot, ReplicatedBody &body) const;
+
+ private:
+  ReplicationOptions options;
+  std::vector<ReplicationTick> ticks;
+  uint32_t latest{REPLICATION_NO_BASELINE};
+  uint32_t lastEntryCount{0U};
+  ReplicationTick empty;
+};
+
+/** @} */
@@ -0,0 +1,237 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   trajectory_recorder.h
+ *
+ * @brief  Header file for streaming per-step body transforms to disk and reading them back
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Inter-component Headers */
+#include "aligned_array.h"
+#include "body_store.h"
+#include "quaternion.h"
+#include "vector_3d.h"
+
+/* Intra-component Headers */
+#include "physics_world.h"
+
+/**
+ * @defgroup WorldModules
+ * @brief    World modules for environment definitions
+ * @{
+ */
+
+/**
+ * @brief   Trajectory file layout
+ * @details A TrajectoryFileHeader, then chunks of up to framesPerChunk frames, then a table of TrajectoryChunkEntry and a
+ *          TrajectoryFooter at the very end. Each chunk starts with a TrajectoryChunkHeader and is decodable on its own: its first
+ *          frame is stored against zero and every later one against a prediction from the frames before it, the last value plus the
+ *          last change. A frame is a TrajectoryFrameHeader, the body handles if they changed since the last frame, then per body
+ *          the zigzag varint residuals of the quantized position (x, y, z) and orientation (w, x, y, z). Positions are quantized
+ *          to a grid of positionPrecision metres, orientation components to 1 / TRAJECTORY_ORIENTATION_SCALE. A file without a
+ *          footer (The writer died) is read by walking the chunk headers instead
+ */
+constexpr char TRAJECTORY_MAGIC[8] = {'P', 'H', 'Y', 'S', 'T', 'R', 'A', 'J'};
+constexpr uint32_t TRAJECTORY_VERSION = 1U;
+constexpr float TRAJECTORY_ORIENTATION_SCALE = 32767.0f;
+
+struct TrajectoryFileHeader {
+  char magic[8];    /**< TRAJECTORY_MAGIC */
+  uint32_t version; /**< TRAJECTORY_VERSION of the writer */
+  uint32_t framesPerChunk;
+  float positionPrecision; /**< Metres per position quantum */
+  uint32_t reserved[3];
+};
+
+struct TrajectoryChunkHeader {
+  uint64_t firstFrame; /**< Index of the chunk's first frame in the file */
+  uint32_t frameCount;
+  uint32_t byteSize; /**< Bytes of frame data after this header */
+};
+
+struct TrajectoryFrameHeader {
+  uint32_t bodyCount;
+  uint32_t flags; /**< TRAJECTORY_FRAME_IDS when the body handles follow */
+};
+
+constexpr uint32_t TRAJECTORY_FRAME_IDS = 1U << 0U;
+
+struct TrajectoryChunkEntry {
+  uint64_t firstFrame;
+  uint64_t offset; /**< Of the chunk header, from the start of the file */
+};
+
+struct TrajectoryFooter {
+  uint64_t indexOffset; /**< Of the chunk table, from the start of the file */
+  uint64_t chunkCount;
+  uint64_t frameCount;
+  char magic[8]; /**< TRAJECTORY_MAGIC, missing when the file wasn't closed */
+};
+
+static_assert(sizeof(TrajectoryFileHeader) == 32U, "The header layout is part of the file format");
+static_assert(sizeof(TrajectoryChunkHeader) == 16U, "The chunk header layout is part of the file format");
+static_assert(sizeof(TrajectoryFooter) == 32U, "The footer layout is part of the file format");
+
+struct TrajectoryOptions {
+  float positionPrecision{0.0001f}; /**< Metres per position quantum, the largest position error is half of this */
+  uint32_t framesPerChunk{64U};     /**< Frames between keyframes, the most a random access read has to decode */
+  uint32_t ringFrames{8U};          /**< Frames the simulation can run ahead of the writer thread before record() waits */
+};
+
+/**
+ * @brief   Body transforms of one recorded step, as decoded by TrajectoryReader
+ */
+struct TrajectoryFrame {
+  uint64_t index{0U};
+  std::vector<BodyId> ids;
+  std::vector<Vector3D> positions;
+  std::vector<Quaternion> orientations;
+};
+
+/**
+ * @brief   Streams the positions and orientations of every body to a trajectory file without stalling the simulation
+ * @details record() copies the store's columns into the next free frame of a single producer, single consumer ring and returns.
+ *          A writer thread takes frames off the ring, quantizes and delta encodes them and appends whole chunks to the file. The
+ *          ring's frame buffers are reused, so a steady body count allocates nothing per step on the simulation thread.
+ *          record() only waits if the writer falls ringFrames behind, getStallCount() says how often that happened
+ */
+class TrajectoryRecorder {
+ public:
+  TrajectoryRecorder();
+  ~TrajectoryRecorder();
+
+  TrajectoryRecorder(const TrajectoryRecorder &) = delete;
+  TrajectoryRecorder &operator=(const TrajectoryRecorder &) = delete;
+
+  /**
+   * @brief   Create the file and start the writer thread. A recorder that is already open is closed first
+   * @return  false if the file couldn't be created
+   */
+  bool open(const std::string &path, const TrajectoryOptions &options = TrajectoryOptions());
+
+  /**
+   * @brief   Queue the world's current body transforms as the next frame. Call once per step() from the simulation thread
+   */
+  void record(const PhysicsWorld &world);
+
+  /**
+   * @brief   Write out every queued frame, finish the file with its chunk table and stop the writer thread
+   * @return  false if any write failed
+   */
+  bool close();
+
+  bool isOpen() const;
+
+  uint64_t getRecordedFrames() const;
+  uint64_t getWrittenFrames() const;
+  uint64_t getWrittenBytes() const;
+
+  /**
+   * @brief   Number of record() calls that had to wait for the writer thread
+   */
+  uint64_t getStallCount() const;
+
+ private:
+  /**
+   * @brief   One step's transforms, copied column by column from the store
+   */
+  struct RingFrame {
+    AlignedArray<BodyId> ids;
+    Vector3DArray position;
+    QuaternionArray orientation;
+  };
+
+  TrajectoryOptions options;
+  std::ofstream file;
+  std::thread writer;
+
+  /* Single producer, single consumer ring. The simulation thread fills frames[head % size] and publishes it by bumping head, the
+     writer thread encodes frames[tail % size] and hands it back by bumping tail. The lock is only taken around a thread that is
+     parked, or about to park, on an empty or full ring */
+  std::vector<RingFrame> frames;
+  std::atomic<uint64_t> head{0U};
+  std::atomic<uint64_t> tail{0U};
+  std::atomic<bool> running{false};
+  std::atomic<bool> writerWaiting{false};   /**< The writer found the ring empty and is going to sleep */
+  std::atomic<bool> recorderWaiting{false}; /**< record() found the ring full and is going to sleep */
+  std::mutex wakeMutex;
+  std::condition_variable wakeCondition; /**< Wakes the writer when a frame is published, and the simulation thread when one frees up */
+
+  std::atomic<uint64_t> writtenFrames{0U};
+  std::atomic<uint64_t> writtenBytes{0U};
+  uint64_t stallCount{0U};
+  bool failed{false};
+
+  /* Writer thread state */
+  std::vector<uint8_t> chunk; /**< Encoded frames of the chunk being built */
+  uint32_t chunkFrames{0U};
+  uint64_t chunkFirstFrame{0U};
+  std::vector<TrajectoryChunkEntry> chunkIndex;
+  std::vector<BodyId> lastIds;         /**< Handles of the previous frame in the chunk */
+  std::vector<uint32_t> lastQuantized; /**< Quantized transforms of the previous frame in the chunk, 7 per body */
+  std::vector<uint32_t> lastDeltas;    /**< How far each of them moved in that frame */
+
+  void writerLoop();
+  void wake(const std::atomic<bool> &waiting);
+  void encodeFrame(const RingFrame &frame);
+  void flushChunk();
+  void writeBytes(const void *data, size_t size);
+};
+
+/**
+ * @brief   Random access to the frames of a trajectory file
+ * @details A read decodes forward from the start of the frame's chunk, or from the last frame read when that is earlier in the
+ *          same chunk, so stepping through frames in order decodes each one once
+ */
+class TrajectoryReader {
+ public:
+  /**
+   * @return  false if the file is missing or isn't a trajectory of a known version
+   */
+  bool open(const std::string &path);
+
+  uint64_t getFrameCount() const;
+  float getPositionPrecision() const;
+
+  /**
+   * @brief   Decode a frame
+   * @return  false if the frame doesn't exist or the file is damaged
+   */
+  bool readFrame(uint64_t index, TrajectoryFrame &frame);
+
+ private:
+  std::ifstream file;
+  TrajectoryFileHeader header{};
+  std::vector<TrajectoryChunkEntry> chunkIndex;
+  uint64_t frameCount{0U};
+
+  /* Decoder state, the chunk that is loaded and the last frame decoded from it */
+  static constexpr size_t NO_CHUNK = ~static_cast<size_t>(0U);
+  size_t loadedChunk{NO_CHUNK};
+  std::vector<uint8_t> chunk;
+  uint64_t chunkEndFrame{0U}; /**< One past the loaded chunk's last frame */
+  size_t chunkCursor{0U};     /**< Start of nextFrame in chunk */
+  uint64_t nextFrame{0U};
+  std::vector<BodyId> lastIds;
+  std::vector<uint32_t> lastQuantized;
+  std::vector<uint32_t> lastDeltas;
+
+  bool loadChunk(size_t chunkNumber);
+  bool decodeNextFrame();
+};
+
+/** @} */
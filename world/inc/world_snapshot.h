@@ -0,0 +1,142 @@
+#pragma once
+
+/*******************************************************************************************************************************
+ * @file   world_snapshot.h
+ *
+ * @brief  Header file for the binary world snapshot format
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <cstddef>
+#include <cstdint>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+
+/**
+ * @defgroup WorldModules
+ * @brief    World modules for environment definitions
+ * @{
+ */
+
+/**
+ * @brief   Snapshot file layout, see PhysicsWorld::saveSnapshot()
+ * @details A snapshot is a SnapshotHeader, a table of SnapshotSection entries, then the section payloads, each starting on a
+ *          SNAPSHOT_ALIGNMENT boundary. Body columns are stored exactly as the BodyStore holds them, one array per component, so
+ *          writing is one sequential pass and loading maps the file and copies each column with a single memcpy.
+ *          Values are in host byte order, loading checks byteOrder and rejects snapshots written on a machine of the other
+ *          endianness. Readers skip sections they don't know, so later versions can add sections without breaking old files
+ */
+constexpr char SNAPSHOT_MAGIC[8] = {'P', 'H', 'Y', 'S', 'S', 'N', 'A', 'P'};
+constexpr uint32_t SNAPSHOT_VERSION = 1U;
+constexpr uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304U;
+constexpr size_t SNAPSHOT_ALIGNMENT = 64U; /**< Alignment of every section payload in the file, a cache line */
+
+enum class SnapshotSectionId : uint32_t {
+  SETTINGS,   /**< One SnapshotSettings */
+  SHAPES,     /**< SnapshotShape per distinct shape */
+  BODY_SHAPE, /**< uint32_t per body, index into SHAPES */
+  POSITION_X, /**< float per body, and so on for every component of the store's columns */
+  POSITION_Y,
+  POSITION_Z,
+  ORIENTATION_W,
+  ORIENTATION_X,
+  ORIENTATION_Y,
+  ORIENTATION_Z,
+  LINEAR_VELOCITY_X,
+  LINEAR_VELOCITY_Y,
+  LINEAR_VELOCITY_Z,
+  ANGULAR_VELOCITY_X,
+  ANGULAR_VELOCITY_Y,
+  ANGULAR_VELOCITY_Z,
+  FORCE_X,
+  FORCE_Y,
+  FORCE_Z,
+  TORQUE_X,
+  TORQUE_Y,
+  TORQUE_Z,
+  INVERSE_MASS,
+  INVERSE_INERTIA_X,
+  INVERSE_INERTIA_Y,
+  INVERSE_INERTIA_Z,
+  BOUNDING_RADIUS,
+  SHAPE_TYPE, /**< uint8_t per body */
+  SHAPE_INDEX,
+  BODY_IDS, /**< SnapshotSlot per body, the handle of each dense index */
+  SLEEP_TIME,
+  SLEEP_ISLAND,
+  SPHERE_RADIUS, /**< float per sphere in the store's sphere pool */
+  SPHERE_BODY,
+  SLOTS,          /**< SnapshotSlot per handle table slot */
+  ISLAND_OFFSETS, /**< uint64_t per sleeping island plus one, start of each island in ISLAND_BODIES */
+  ISLAND_BODIES,  /**< SnapshotSlot per body handle listed in a sleeping island */
+  FREE_ISLANDS,   /**< uint32_t per free sleeping island */
+  IMPULSE_CACHE,  /**< SnapshotImpulse per cached contact impulse, for warm starting */
+  COUNT
+};
+
+struct SnapshotHeader {
+  char magic[8];         /**< SNAPSHOT_MAGIC */
+  uint32_t version;      /**< SNAPSHOT_VERSION of the writer */
+  uint32_t headerSize;   /**< sizeof(SnapshotHeader) of the writer */
+  uint32_t byteOrder;    /**< SNAPSHOT_BYTE_ORDER as the writer stored it */
+  uint32_t sectionCount; /**< Entries in the section table right after the header */
+  uint64_t fileSize;     /**< Total bytes, a shorter file is truncated */
+  uint64_t bodyCount;    /**< Bodies in the world */
+  uint32_t freeSlotHead; /**< First free slot of the handle table */
+  uint32_t reserved[5];
+};
+
+struct SnapshotSection {
+  uint32_t id;          /**< SnapshotSectionId */
+  uint32_t elementSize; /**< Bytes per element, checked against the reader's type */
+  uint64_t count;       /**< Number of elements */
+  uint64_t offset;      /**< Start of the payload from the start of the file, a multiple of SNAPSHOT_ALIGNMENT */
+};
+
+struct SnapshotSettings {
+  float gravity[3];
+  float timeStep;
+  float linearSleepThreshold;
+  float angularSleepThreshold;
+  float timeToSleep;
+  uint32_t sleepingEnabled;
+  uint32_t broadphaseType; /**< BroadphaseType */
+  uint32_t velocityIterations;
+  uint32_t positionIterations;
+  uint32_t positionCorrection; /**< PositionCorrection */
+  uint32_t warmStarting;
+  uint32_t reserved[3];
+};
+
+struct SnapshotShape {
+  uint32_t type; /**< ShapeType */
+  float restitution;
+  float friction;
+  float parameters[5]; /**< Per type. Sphere: radius, density */
+};
+
+struct SnapshotSlot {
+  uint32_t index;
+  uint32_t generation;
+};
+
+struct SnapshotImpulse {
+  uint64_t cacheKey;
+  SnapshotSlot bodyA;
+  SnapshotSlot bodyB;
+  float normalImpulse;
+  float tangentImpulse[3];
+};
+
+static_assert(sizeof(SnapshotHeader) == 64U, "The header layout is part of the file format");
+static_assert(sizeof(SnapshotSection) == 24U, "The section table layout is part of the file format");
+static_assert(sizeof(SnapshotSettings) == 64U, "The settings layout is part of the file format");
+static_assert(sizeof(SnapshotShape) == 32U, "The shape record layout is part of the file format");
+static_assert(sizeof(SnapshotImpulse) == 40U, "The impulse record layout is part of the file format");
+
+/** @} */
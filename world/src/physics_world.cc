@@ -19,6 +19,20 @@
 PhysicsWorld::PhysicsWorld() {
   this->gravity = Vector3D(0, -9.81f, 0);
   this->timeStep = 1.0f / 60.0f;
+  this->sleepingEnabled = true;
+  this->linearSleepThreshold = DEFAULT_LINEAR_SLEEP_THRESHOLD;
+  this->angularSleepThreshold = DEFAULT_ANGULAR_SLEEP_THRESHOLD;
+  this->timeToSleep = DEFAULT_TIME_TO_SLEEP;
+  this->broadphaseType = BroadphaseType::SWEEP_AND_PRUNE;
+  this->jobs = std::make_unique<JobSystem>();
+  this->broadphase = Broadphase::create(broadphaseType);
+  this->broadphase->setJobSystem(jobs.get());
+  this->contactSolver.setJobSystem(jobs.get());
+}
+
+PhysicsWorld::~PhysicsWorld() {
+  /* Bodies held elsewhere keep their state after the world is gone */
+  reset();
 }
 
 void PhysicsWorld::setGravity(const Vector3D &gravity) {
@@ -29,74 +43,545 @@ void PhysicsWorld::setTimeStep(float step) {
   this->timeStep = step;
 }
 
-void PhysicsWorld::addRigidBody(std::shared_ptr<RigidBody> body) {
-  bodies.push_back(body);
+void PhysicsWorld::setBroadphase(BroadphaseType type) {
+  broadphaseType = type;
+  broadphase = Broadphase::create(type);
+  broadphase->setJobSystem(jobs.get());
+
+  for (uint32_t i = 0; i < bodyStore.size(); i++) {
+    bodyStore.broadphaseProxy[i] = broadphase->createProxy(computeBoundingBox(i), i);
+  }
+}
+
+BroadphaseType PhysicsWorld::getBroadphaseType() const {
+  return broadphaseType;
+}
+
+void PhysicsWorld::setThreadCount(uint32_t threadCount) {
+  /* The old workers are joined before the broadphase and solver get the new pool. The frame vectors still point into the old
+     pool's arenas, beginFrame() only reads their sizes before pointing them at the new ones */
+  jobs.reset();
+  jobs = std::make_unique<JobSystem>(threadCount);
+  broadphase->setJobSystem(jobs.get());
+  contactSolver.setJobSystem(jobs.get());
+}
+
+uint32_t PhysicsWorld::getThreadCount() const {
+  return jobs->getThreadCount();
+}
+
+void PhysicsWorld::setSolverIterations(uint32_t velocityIterations, uint32_t positionIterations) {
+  contactSolver.setIterations(velocityIterations, positionIterations);
+}
+
+void PhysicsWorld::setPositionCorrection(PositionCorrection mode) {
+  contactSolver.setPositionCorrection(mode);
+}
+
+void PhysicsWorld::setWarmStarting(bool enabled) {
+  contactSolver.setWarmStarting(enabled);
+}
+
+void PhysicsWorld::setSleepingEnabled(bool enabled) {
+  sleepingEnabled = enabled;
+
+  if (!enabled) {
+    for (uint32_t i = 0; i < bodyStore.size(); i++) {
+      bodyStore.wake(i);
+    }
+  }
+}
+
+void PhysicsWorld::setSleepThresholds(float linearVelocity, float angularVelocity, float timeToSleep) {
+  this->linearSleepThreshold = linearVelocity;
+  this->angularSleepThreshold = angularVelocity;
+  this->timeToSleep = timeToSleep;
+}
+
+void PhysicsWorld::registerBody(BodyId id, std::shared_ptr<RigidBody> view) {
+  uint32_t index = bodyStore.indexOf(id);
+  bodySetVersion++;
+  bodies.push_back(std::move(view));
+  bodyStore.broadphaseProxy[index] = broadphase->createProxy(computeBoundingBox(index), index);
+}
+
+BodyId PhysicsWorld::addRigidBody(std::shared_ptr<RigidBody> body) {
+  /* Bodies can only be in one world at a time */
+  if (body->store != body->detachedStore.get()) {
+    return BodyId();
+  }
+
+  body->attach(&bodyStore);
+  registerBody(body->id, body);
+
+  return body->id;
 }
 
 void PhysicsWorld::removeRigidBody(std::shared_ptr<RigidBody> body) {
-  bodies.erase(std::remove(bodies.begin(), bodies.end(), body), bodies.end());
+  if (body->store == &bodyStore) {
+    destroyBody(body->id);
+  }
+}
+
+BodyId PhysicsWorld::createBody(const BodyDesc &desc) {
+  BodyId id = bodyStore.add(desc, nullptr);
+  registerBody(id, nullptr);
+
+  return id;
+}
+
+void PhysicsWorld::createBodies(std::span<const BodyDesc> descs, std::span<BodyId> ids) {
+  bodyStore.reserve(bodyStore.size() + descs.size());
+  bodies.reserve(bodies.size() + descs.size());
+
+  for (size_t i = 0; i < descs.size(); i++) {
+    ids[i] = createBody(descs[i]);
+  }
+}
+
+void PhysicsWorld::destroyBody(BodyId id) {
+  if (!bodyStore.isValid(id)) {
+    return;
+  }
+
+  uint32_t index = bodyStore.indexOf(id);
+  uint32_t last = static_cast<uint32_t>(bodyStore.size() - 1U);
+  bodySetVersion++;
+  broadphase->destroyProxy(bodyStore.broadphaseProxy[index]);
+
+  /* Anything resting on the body has to notice it is gone */
+  bodyStore.wake(index);
+
+  /* Swap remove, the last body moves into the freed index. A view takes the body's state with it */
+  if (bodyStore.views[index]) {
+    bodyStore.views[index]->detach();
+  } else {
+    bodyStore.remove(id);
+  }
+
+  bodies[index] = std::move(bodies[last]);
+  bodies.pop_back();
+
+  if (index != last) {
+    broadphase->setUserData(bodyStore.broadphaseProxy[index], index);
+  }
+}
+
+void PhysicsWorld::destroyBodies(std::span<const BodyId> ids) {
+  for (BodyId id : ids) {
+    destroyBody(id);
+  }
+}
+
+bool PhysicsWorld::isValid(BodyId id) const {
+  return bodyStore.isValid(id);
+}
+
+std::shared_ptr<RigidBody> PhysicsWorld::getBody(BodyId id) {
+  if (!bodyStore.isValid(id)) {
+    return nullptr;
+  }
+
+  uint32_t index = bodyStore.indexOf(id);
+  if (!bodies[index]) {
+    /* The view and its control block both come from the memory manager */
+    bodies[index] = std::shared_ptr<RigidBody>(new RigidBody(&bodyStore, id), std::default_delete<RigidBody>(), PoolAllocator<RigidBody>());
+  }
+
+  return bodies[index];
 }
 
 size_t PhysicsWorld::getBodyCount() const {
-  return bodies.size();
+  return bodyStore.size();
 }
 
-std::vector<std::shared_ptr<RigidBody>> PhysicsWorld::getBodies() const {
-  return bodies;
+size_t PhysicsWorld::getAwakeBodyCount() const {
+  size_t count = 0U;
+  for (uint32_t i = 0; i < bodyStore.size(); i++) {
+    count += bodyStore.isAwake(i) ? 1U : 0U;
+  }
+
+  return count;
+}
+
+std::vector<std::shared_ptr<RigidBody>> PhysicsWorld::getBodies() {
+  for (uint32_t i = 0; i < bodies.size(); i++) {
+    if (!bodies[i]) {
+      getBody(bodyStore.ids[i]);
+    }
+  }
+
+  return std::vector<std::shared_ptr<RigidBody>>(bodies.begin(), bodies.end());
+}
+
+std::vector<std::shared_ptr<RigidBody>> PhysicsWorld::queryAABB(const AABB &box) {
+  std::vector<uint32_t> indices;
+  broadphase->query(box, indices);
+
+  std::vector<std::shared_ptr<RigidBody>> result;
+  result.reserve(indices.size());
+  for (uint32_t index : indices) {
+    result.push_back(getBody(bodyStore.ids[index]));
+  }
+
+  return result;
+}
+
+const BodyStore &PhysicsWorld::getBodyStore() const {
+  return bodyStore;
+}
+
+const StepStats &PhysicsWorld::getStepStats() const {
+  return stepStats;
+}
+
+AABB PhysicsWorld::computeBoundingBox(uint32_t index) const {
+  Vector3D center = bodyStore.position.get(index);
+  float radius = bodyStore.boundingRadius[index];
+  Vector3D extent(radius, radius, radius);
+
+  return AABB{center - extent, center + extent};
+}
+
+bool PhysicsWorld::isActiveDynamic(uint32_t index) const {
+  /* Massless bodies are awake but never move, so they can't wake anything up or need a collision test against a sleeper */
+  return bodyStore.isAwake(index) && bodyStore.inverseMass[index] > 0.0f;
+}
+
+void PhysicsWorld::beginFrame() {
+  /* Nothing from last step is read past this point, so the sizes are taken before the arenas are rewound */
+  const uint32_t threadCount = jobs->getThreadCount();
+  const size_t lastContactCount = contacts.size();
+  const size_t activeCount = std::max(activeBodies.size(), activeDynamicBodies.size());
+  const size_t candidateCount = sleepCandidates.size();
+  jobs->resetFrameArenas();
+
+  FrameArena &arena = jobs->getFrameArena(0U);
+  rebindFrameVector(contacts, arena, lastContactCount);
+  rebindFrameVector(unsortedContacts, arena, lastContactCount);
+  rebindFrameVector(contactSortKeys, arena, lastContactCount);
+  rebindFrameVector(workerContactOffsets, arena, threadCount + 1U);
+  rebindFrameVector(activeBodies, arena, activeCount);
+  rebindFrameVector(activeDynamicBodies, arena, activeCount);
+  rebindFrameVector(islandParent, arena, bodyStore.size());
+  rebindFrameVector(islandSleepTime, arena, bodyStore.size());
+  rebindFrameVector(sleepCandidates, arena, candidateCount);
+  rebindFrameVector(islandScratch, arena, candidateCount);
+
+  /* Each thread appends to its own stream. Work stealing decides how the contacts split between threads, so every stream gets
+     room for all of last step's, which costs address space but keeps a lopsided step from growing the arenas. The pair
+     buckets only ever hold one job's pairs */
+  const size_t expectedContacts = lastContactCount + CONTACT_STREAM_SLACK;
+  workerContacts.resize(threadCount);
+  workerPairs.resize(threadCount);
+  for (uint32_t worker = 0U; worker < threadCount; worker++) {
+    rebindFrameVector(workerContacts[worker], jobs->getFrameArena(worker), expectedContacts);
+    for (FrameVector<BroadphasePair> &bucket : workerPairs[worker]) {
+      rebindFrameVector(bucket, jobs->getFrameArena(worker), NARROWPHASE_GRAIN_SIZE);
+    }
+  }
+}
+
+void PhysicsWorld::buildActiveList() {
+  PROFILE_SCOPE_STAT(scope, "buildActiveList", stepStats.buildActiveListSeconds);
+  activeBodies.clear();
+  activeDynamicBodies.clear();
+  for (uint32_t i = 0; i < bodyStore.size(); i++) {
+    if (bodyStore.isAwake(i)) {
+      activeBodies.push_back(i);
+
+      /* Static bodies are filtered out here once, so the integration kernels never branch on mass */
+      if (bodyStore.inverseMass[i] > 0.0f) {
+        activeDynamicBodies.push_back(i);
+      }
+    }
+  }
 }
 
 void PhysicsWorld::detectCollisions() {
+  PROFILE_SCOPE_STAT(scope, "detectCollisions", stepStats.detectCollisionsSeconds);
+
+  /* Refresh the broadphase bounds, sleeping bodies haven't moved. Then only run the narrowphase on overlapping pairs */
+  {
+    PROFILE_SCOPE_STAT(broadphaseScope, "broadphase", stepStats.broadphaseSeconds);
+    for (uint32_t index : activeBodies) {
+      broadphase->moveProxy(bodyStore.broadphaseProxy[index], computeBoundingBox(index));
+    }
+    broadphase->updatePairs();
+    PROFILE_VALUE(broadphaseScope, "pairs", broadphase->getPairs().size());
+  }
+
+  /* Streams are only cleared here, they were pointed at this step's arenas in beginFrame() */
+  for (FrameVector<Contact> &stream : workerContacts) {
+    stream.clear();
+  }
   contacts.clear();
 
-  /* Check all pairs of bodies. O(N^2) */
-  for (size_t i = 0; i < bodies.size(); i++) {
-    for (size_t j = i + 1; j < bodies.size(); j++) {
-      Contact contact;
-      if (CollisionDetector::sphereSphere(bodies[i].get(), bodies[j].get(), &contact)) {
-        contacts.push_back(contact);
+  const std::vector<BroadphasePair> &pairs = broadphase->getPairs();
+  PROFILE_ONLY(pairsTested.store(0U, std::memory_order_relaxed));
+  {
+    PROFILE_SCOPE_STAT(narrowphaseScope, "narrowphase", stepStats.narrowphaseSeconds);
+    jobs->parallelFor(static_cast<uint32_t>(pairs.size()), NARROWPHASE_GRAIN_SIZE, [this, &pairs](uint32_t begin, uint32_t end) {
+      /* Jobs run on several threads at once, so they only add to the statistics through an atomic */
+      PROFILE_JOB_SCOPE(jobScope, "narrowphaseJob");
+      const uint32_t worker = JobSystem::getWorkerIndex();
+      std::array<FrameVector<BroadphasePair>, CollisionDetector::SHAPE_PAIR_COUNT> &candidates = workerPairs[worker];
+
+      /* Nothing moved between bodies that are both asleep or static, their contacts can't have changed. The rest are bucketed
+         by shape types so each bucket goes through one batched routine */
+      for (FrameVector<BroadphasePair> &bucket : candidates) {
+        bucket.clear();
+      }
+      for (uint32_t i = begin; i < end; i++) {
+        if (isActiveDynamic(pairs[i].a) || isActiveDynamic(pairs[i].b)) {
+          candidates[CollisionDetector::getPairType(bodyStore, pairs[i])].push_back(pairs[i]);
+        }
+      }
+
+      PROFILE_ONLY(uint64_t tested = 0U);
+      for (uint32_t typeA = 0U; typeA < CollisionDetector::SHAPE_TYPE_COUNT; typeA++) {
+        for (uint32_t typeB = 0U; typeB < CollisionDetector::SHAPE_TYPE_COUNT; typeB++) {
+          const FrameVector<BroadphasePair> &bucket = candidates[(typeA * CollisionDetector::SHAPE_TYPE_COUNT) + typeB];
+          CollisionDetector::PairFunction function = CollisionDetector::PAIR_FUNCTIONS[typeA][typeB];
+
+          if (function && !bucket.empty()) {
+            function(bodyStore, bucket.data(), static_cast<uint32_t>(bucket.size()), workerContacts[worker]);
+            PROFILE_ONLY(tested += bucket.size());
+          }
+        }
       }
+
+      PROFILE_VALUE(jobScope, "pairs", tested);
+      PROFILE_ONLY(pairsTested.fetch_add(tested, std::memory_order_relaxed));
+    });
+  }
+
+  mergeContacts();
+
+  PROFILE_ONLY(stepStats.broadphasePairs = pairs.size());
+  PROFILE_ONLY(stepStats.pairsTested = pairsTested.load(std::memory_order_relaxed));
+  PROFILE_ONLY(stepStats.contacts = contacts.size());
+  PROFILE_COUNTER("contacts", contacts.size());
+}
+
+void PhysicsWorld::mergeContacts() {
+  PROFILE_SCOPE_STAT(scope, "mergeContacts", stepStats.mergeContactsSeconds);
+
+  /* Exclusive prefix sum of the stream sizes gives every stream its own range of the merged array */
+  const uint32_t streamCount = static_cast<uint32_t>(workerContacts.size());
+  workerContactOffsets.resize(streamCount + 1U);
+  workerContactOffsets[0] = 0U;
+  for (uint32_t stream = 0U; stream < streamCount; stream++) {
+    workerContactOffsets[stream + 1U] = workerContactOffsets[stream] + workerContacts[stream].size();
+  }
+
+  const size_t contactCount = workerContactOffsets[streamCount];
+  unsortedContacts.resize(contactCount);
+  jobs->parallelFor(streamCount, 1U, [this](uint32_t begin, uint32_t end) {
+    for (uint32_t stream = begin; stream < end; stream++) {
+      std::copy(workerContacts[stream].begin(), workerContacts[stream].end(), unsortedContacts.begin() + workerContactOffsets[stream]);
     }
+  });
+
+  /* Which thread found a contact depends on scheduling, sorting by body pair makes the order the same on any thread count
+     (And for any broadphase). A pair is only ever handled by one job, so breaking ties on the merged position keeps a pair's
+     contacts in order. This is a stable sort without the temporary buffer std::stable_sort would take from the heap */
+  contactSortKeys.resize(contactCount);
+  for (size_t i = 0U; i < contactCount; i++) {
+    contactSortKeys[i] = ContactSortKey{unsortedContacts[i].getPairKey(), static_cast<uint32_t>(i)};
+  }
+  std::sort(contactSortKeys.begin(), contactSortKeys.end());
+
+  contacts.resize(contactCount);
+  for (size_t i = 0U; i < contactCount; i++) {
+    contacts[i] = unsortedContacts[contactSortKeys[i].index];
   }
 }
 
-void PhysicsWorld::resolveCollisions() {
-  for (const auto &contact : contacts) {
-    if (!contact.bodyA || !contact.bodyB)
+bool PhysicsWorld::wakeTouchedIslands() {
+  bool woke = false;
+
+  for (const Contact &contact : contacts) {
+    if (contact.bodyA == BodyStore::INVALID_INDEX || contact.bodyB == BodyStore::INVALID_INDEX) {
       continue;
+    }
+
+    if (!bodyStore.isAwake(contact.bodyA) && isActiveDynamic(contact.bodyB)) {
+      bodyStore.wake(contact.bodyA);
+      woke = true;
+    } else if (!bodyStore.isAwake(contact.bodyB) && isActiveDynamic(contact.bodyA)) {
+      bodyStore.wake(contact.bodyB);
+      woke = true;
+    }
+  }
+
+  return woke;
+}
 
-    /* Calculate relative velocity */
-    Vector3D relativeVel = contact.bodyB->getLinearVelocity() - contact.bodyA->getLinearVelocity();
+void PhysicsWorld::resolveCollisions() {
+  PROFILE_SCOPE_STAT(scope, "resolveCollisions", stepStats.resolveCollisionsSeconds);
+  PROFILE_VALUE(scope, "contacts", contacts.size());
+  contactSolver.solve(bodyStore, contacts, timeStep, jobs->getFrameArena(0U));
+}
 
-    /* Calculate impulse */
-    float velAlongNormal = relativeVel.dotProduct(contact.normal);
-    if (velAlongNormal > 0)
-      continue; /* Bodies are seperating already */
+void PhysicsWorld::integrateVelocities() {
+  PROFILE_SCOPE_STAT(scope, "integrateVelocities", stepStats.integrateVelocitiesSeconds);
+  PROFILE_VALUE(scope, "bodies", activeDynamicBodies.size());
+  PROFILE_ONLY(stepStats.bodiesIntegrated = activeDynamicBodies.size());
 
-    float j = -(1.0f + contact.restitution) * velAlongNormal;
-    j /= contact.bodyA->getInverseMass() + contact.bodyB->getInverseMass();
+  /* Bodies integrate independently, so any split across threads gives the same result */
+  jobs->parallelFor(static_cast<uint32_t>(activeDynamicBodies.size()), INTEGRATE_GRAIN_SIZE, [this](uint32_t begin, uint32_t end) {
+    PROFILE_JOB_SCOPE(jobScope, "integrateVelocitiesJob");
+    PROFILE_VALUE(jobScope, "bodies", end - begin);
+    bodyStore.integrateVelocities(activeDynamicBodies.data() + begin, end - begin, timeStep, gravity);
+  });
+}
 
-    Vector3D impulse = contact.normal * j;
+void PhysicsWorld::integratePositions() {
+  PROFILE_SCOPE_STAT(scope, "integratePositions", stepStats.integratePositionsSeconds);
+  PROFILE_VALUE(scope, "bodies", activeDynamicBodies.size());
+  jobs->parallelFor(static_cast<uint32_t>(activeDynamicBodies.size()), INTEGRATE_GRAIN_SIZE, [this](uint32_t begin, uint32_t end) {
+    PROFILE_JOB_SCOPE(jobScope, "integratePositionsJob");
+    PROFILE_VALUE(jobScope, "bodies", end - begin);
+    bodyStore.integratePositions(activeDynamicBodies.data() + begin, end - begin, timeStep);
+  });
+}
 
-    // Apply impulse
-    contact.bodyA->setLinearVelocity(contact.bodyA->getLinearVelocity() - impulse * contact.bodyA->getInverseMass());
-    contact.bodyB->setLinearVelocity(contact.bodyB->getLinearVelocity() + impulse * contact.bodyB->getInverseMass());
+uint32_t PhysicsWorld::findIsland(uint32_t index) {
+  /* Path halving */
+  while (islandParent[index] != index) {
+    islandParent[index] = islandParent[islandParent[index]];
+    index = islandParent[index];
   }
+
+  return index;
 }
 
-void PhysicsWorld::integrateForces() {
-  for (auto &body : bodies) {
-    body->addForce(gravity * body->getMass());
-    body->integrate(timeStep);
+void PhysicsWorld::updateSleep() {
+  PROFILE_SCOPE_STAT(scope, "updateSleep", stepStats.updateSleepSeconds);
+  if (!sleepingEnabled) {
+    return;
+  }
+
+  const float linearThresholdSquared = linearSleepThreshold * linearSleepThreshold;
+  const float angularThresholdSquared = angularSleepThreshold * angularSleepThreshold;
+  islandParent.resize(bodyStore.size());
+  islandSleepTime.resize(bodyStore.size());
+
+  for (uint32_t index : activeBodies) {
+    islandParent[index] = index;
+    islandSleepTime[index] = timeToSleep;
+
+    if (bodyStore.inverseMass[index] <= 0.0f) {
+      continue;
+    }
+
+    Vector3D linear = bodyStore.linearVelocity.get(index);
+    Vector3D angular = bodyStore.angularVelocity.get(index);
+    if (linear.dotProduct(linear) > linearThresholdSquared || angular.dotProduct(angular) > angularThresholdSquared) {
+      bodyStore.sleepTime[index] = 0.0f;
+    } else {
+      bodyStore.sleepTime[index] += timeStep;
+    }
+  }
+
+  /* Islands are the connected components of the contact graph. Static bodies don't join islands, otherwise everything
+     resting on the same ground would be one island */
+  for (const Contact &contact : contacts) {
+    if (contact.bodyA == BodyStore::INVALID_INDEX || contact.bodyB == BodyStore::INVALID_INDEX) {
+      continue;
+    }
+
+    if (bodyStore.inverseMass[contact.bodyA] > 0.0f && bodyStore.inverseMass[contact.bodyB] > 0.0f) {
+      uint32_t rootA = findIsland(contact.bodyA);
+      uint32_t rootB = findIsland(contact.bodyB);
+
+      /* The lower index becomes the root so the islands don't depend on contact order */
+      if (rootA < rootB) {
+        islandParent[rootB] = rootA;
+      } else if (rootB < rootA) {
+        islandParent[rootA] = rootB;
+      }
+    }
+  }
+
+  /* An island can only sleep once its most recently moving body has been still long enough */
+  for (uint32_t index : activeBodies) {
+    if (bodyStore.inverseMass[index] > 0.0f) {
+      uint32_t root = findIsland(index);
+      islandSleepTime[root] = std::min(islandSleepTime[root], bodyStore.sleepTime[index]);
+    }
+  }
+
+  sleepCandidates.clear();
+  for (uint32_t index : activeBodies) {
+    if (bodyStore.inverseMass[index] > 0.0f) {
+      uint32_t root = findIsland(index);
+      if (islandSleepTime[root] >= timeToSleep) {
+        sleepCandidates.push_back((static_cast<uint64_t>(root) << 32U) | index);
+      }
+    }
+  }
+
+  /* Sorting groups the bodies of each island together */
+  std::sort(sleepCandidates.begin(), sleepCandidates.end());
+  for (size_t begin = 0U; begin < sleepCandidates.size();) {
+    uint64_t root = sleepCandidates[begin] >> 32U;
+
+    islandScratch.clear();
+    size_t end = begin;
+    while (end < sleepCandidates.size() && (sleepCandidates[end] >> 32U) == root) {
+      islandScratch.push_back(static_cast<uint32_t>(sleepCandidates[end] & 0xFFFFFFFFU));
+      end++;
+    }
+
+    bodyStore.sleep(islandScratch.data(), islandScratch.size());
+
+    /* The bounds were last refreshed before this step moved the island. Sleepers aren't refreshed again, so they get the bounds of
+       where they came to rest. That also keeps the bounds a function of the body state alone, which restoring a state relies on */
+    for (uint32_t index : islandScratch) {
+      broadphase->moveProxy(bodyStore.broadphaseProxy[index], computeBoundingBox(index));
+    }
+    begin = end;
   }
 }
 
 void PhysicsWorld::step() {
+  PROFILE_ONLY(stepStats = StepStats{});
+  PROFILE_SCOPE_STAT(scope, "step", stepStats.stepSeconds);
+
+  beginFrame();
+  buildActiveList();
   detectCollisions();
+
+  /* Bodies woken by a contact join this step, their other contacts are picked up next step */
+  if (wakeTouchedIslands()) {
+    buildActiveList();
+  }
+
+  /* Forces go into the velocities before the solve, so contacts can cancel gravity before it moves anything */
+  integrateVelocities();
   resolveCollisions();
-  integrateForces();
+  integratePositions();
+  updateSleep();
+
+  PROFILE_ONLY(stepStats.activeBodies = activeBodies.size());
+  PROFILE_COUNTER("activeBodies", activeBodies.size());
 }
 
 void PhysicsWorld::reset() {
-  bodies.clear();
+  /* Hand every viewed body its own storage again before the world's store is cleared */
+  while (!bodies.empty()) {
+    if (bodies.back()) {
+      bodies.back()->detach();
+    }
+    bodies.pop_back();
+  }
+
+  bodyStore.clear();
+  bodySetVersion++;
   contacts.clear();
+  contactSolver.clear();
+  broadphase = Broadphase::create(broadphaseType);
+  broadphase->setJobSystem(jobs.get());
 }
@@ -0,0 +1,580 @@
+/*******************************************************************************************************************************
+ * @file   state_replication.cc
+ *
+ * @brief  Source file for encoding world state into compact delta packets for remote observers, and decoding them
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "state_replication.h"
+
+namespace {
+constexpr float SQRT_2 = 1.41421356f;
+constexpr uint32_t POSITION_WIDTH_BITS = 6U;    /**< Holds a width of 0 to 32 bits */
+constexpr uint32_t ORIENTATION_WIDTH_BITS = 4U; /**< Holds a width of 0 to REPLICATION_MAX_ORIENTATION_BITS + 1 bits */
+
+/* Gap and generation gammas of at most 63 bits, the kind, the sleeping bit, the widest position and the widest orientation */
+constexpr size_t MAX_ENTRY_BITS = 63U + 2U + 1U + 63U + POSITION_WIDTH_BITS + (3U * 32U) + 1U + ORIENTATION_WIDTH_BITS + (3U * (REPLICATION_MAX_ORIENTATION_BITS + 1U));
+
+/**
+ * @brief   Writes values of up to 32 bits into a byte buffer, least significant bit first
+ */
+class BitWriter {
+ public:
+  BitWriter(uint8_t *data, size_t capacity) : cursor(data), end(data + capacity) {}
+
+  void write(uint32_t value, uint32_t bits) {
+    accumulator |= static_cast<uint64_t>(value) << count;
+    count += bits;
+
+    /* Whole words go out at once, the packet is little endian like the rest of the formats */
+    if (count >= 32U) {
+      if (static_cast<size_t>(end - cursor) < sizeof(uint32_t)) {
+        overflow = true;
+      } else {
+        uint32_t word = static_cast<uint32_t>(accumulator);
+        std::memcpy(cursor, &word, sizeof(word));
+        cursor += sizeof(word);
+      }
+      accumulator >>= 32U;
+      count -= 32U;
+    }
+  }
+
+  /* Elias gamma code of value >= 1: as many zero bits as value has bits after its leading one, then value from the top */
+  void writeGamma(uint32_t value) {
+    uint32_t length = static_cast<uint32_t>(std::bit_width(value)) - 1U;
+    write(1U << length, length + 1U);
+    if (length > 0U) {
+      write(value & ((1U << length) - 1U), length);
+    }
+  }
+
+  /**
+   * @brief   Flush the last partial word
+   * @return  Bytes written, 0 if the buffer ran out
+   */
+  size_t finish(const uint8_t *start) {
+    while (count > 0U && cursor != end) {
+      *cursor++ = static_cast<uint8_t>(accumulator);
+      accumulator >>= 8U;
+      count = (count > 8U) ? count - 8U : 0U;
+    }
+
+    return (overflow || count > 0U) ? 0U : static_cast<size_t>(cursor - start);
+  }
+
+ private:
+  uint8_t *cursor;
+  uint8_t *end;
+  uint64_t accumulator{0U};
+  uint32_t count{0U};
+  bool overflow{false};
+};
+
+/**
+ * @brief   Reads what a BitWriter wrote. Reading past the end gives zeros and sets the failed flag
+ */
+class BitReader {
+ public:
+  BitReader(const uint8_t *data, size_t size) : cursor(data), end(data + size) {}
+
+  uint32_t read(uint32_t bits) {
+    refill();
+    if (count < bits) {
+      failed = true;
+      return 0U;
+    }
+
+    uint32_t value = static_cast<uint32_t>(accumulator & ((static_cast<uint64_t>(1U) << bits) - 1U));
+    accumulator >>= bits;
+    count -= bits;
+    return value;
+  }
+
+  uint32_t readGamma() {
+    refill();
+    uint32_t length = static_cast<uint32_t>(std::countr_zero(accumulator));
+    if (length > 31U || length + 1U > count) {
+      failed = true;
+      return 0U;
+    }
+
+    accumulator >>= length + 1U;
+    count -= length + 1U;
+    return (1U << length) | read(length);
+  }
+
+  bool hasFailed() const {
+    return failed;
+  }
+
+ private:
+  const uint8_t *cursor;
+  const uint8_t *end;
+  uint64_t accumulator{0U};
+  uint32_t count{0U};
+  bool failed{false};
+
+  void refill() {
+    /* Whole bytes that fit in the accumulator, eight at a time away from the end of the packet */
+    if (static_cast<size_t>(end - cursor) >= sizeof(uint64_t)) {
+      uint64_t word;
+      std::memcpy(&word, cursor, sizeof(word));
+      accumulator |= word << count;
+      cursor += (63U - count) >> 3U;
+      count |= 56U;
+      return;
+    }
+
+    while (count <= 56U && cursor != end) {
+      accumulator |= static_cast<uint64_t>(*cursor++) << count;
+      count += 8U;
+    }
+  }
+};
+
+uint32_t zigzag(uint32_t value) {
+  return (value << 1U) ^ (0U - (value >> 31U));
+}
+
+uint32_t unzigzag(uint32_t code) {
+  return (code >> 1U) ^ (0U - (code & 1U));
+}
+
+int32_t quantizePosition(float value, float scale) {
+  /* Clamped so a body flung far away saturates instead of overflowing */
+  return static_cast<int32_t>(std::floor(std::clamp(value * scale, -2147483520.0f, 2147483520.0f) + 0.5f));
+}
+
+/* Smallest-three: the largest component is left out and rebuilt from the unit length, made positive by flipping the sign of the
+   whole quaternion (The same rotation). The other three are within +-1 / sqrt(2), so all of the range goes to where they can be */
+uint32_t packOrientation(const Quaternion &orientation, uint32_t bits) {
+  const float components[4] = {orientation.w, orientation.x, orientation.y, orientation.z};
+  uint32_t largest = 0U;
+  for (uint32_t i = 1U; i < 4U; i++) {
+    if (std::fabs(components[i]) > std::fabs(components[largest])) {
+      largest = i;
+    }
+  }
+
+  const float sign = (components[largest] < 0.0f) ? -1.0f : 1.0f;
+  const float maxCode = static_cast<float>((1U << bits) - 1U);
+  uint32_t packed = largest;
+  for (uint32_t i = 0U; i < 4U; i++) {
+    if (i != largest) {
+      float unit = std::clamp(components[i] * sign * SQRT_2 * 0.5f + 0.5f, 0.0f, 1.0f);
+      packed = (packed << bits) | static_cast<uint32_t>(unit * maxCode + 0.5f);
+    }
+  }
+
+  return packed;
+}
+
+Quaternion unpackOrientation(uint32_t packed, uint32_t bits) {
+  const uint32_t largest = packed >> (3U * bits);
+  const uint32_t mask = (1U << bits) - 1U;
+  const float maxCode = static_cast<float>(mask);
+
+  float components[4];
+  float sumSquared = 0.0f;
+  uint32_t shift = 3U * bits;
+  for (uint32_t i = 0U; i < 4U; i++) {
+    if (i != largest) {
+      shift -= bits;
+      components[i] = ((static_cast<float>((packed >> shift) & mask) / maxCode) * 2.0f - 1.0f) / SQRT_2;
+      sumSquared += components[i] * components[i];
+    }
+  }
+  components[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSquared));
+
+  return Quaternion(components[0], components[1], components[2], components[3]);
+}
+
+void writePosition(BitWriter &writer, const int32_t *position, const int32_t *baseline) {
+  /* Differences wrap around, zigzag keeps small negative ones small. All three share the width of the largest */
+  uint32_t codes[3];
+  for (uint32_t axis = 0U; axis < 3U; axis++) {
+    codes[axis] = zigzag(static_cast<uint32_t>(position[axis]) - static_cast<uint32_t>(baseline[axis]));
+  }
+
+  uint32_t width = static_cast<uint32_t>(std::bit_width(codes[0] | codes[1] | codes[2]));
+  writer.write(width, POSITION_WIDTH_BITS);
+  if (width > 0U) {
+    for (uint32_t axis = 0U; axis < 3U; axis++) {
+      writer.write(codes[axis], width);
+    }
+  }
+}
+
+bool readPosition(BitReader &reader, int32_t *position, const int32_t *baseline) {
+  uint32_t width = reader.read(POSITION_WIDTH_BITS);
+  if (width > 32U) {
+    return false;
+  }
+
+  for (uint32_t axis = 0U; axis < 3U; axis++) {
+    uint32_t code = (width > 0U) ? reader.read(width) : 0U;
+    position[axis] = static_cast<int32_t>(static_cast<uint32_t>(baseline[axis]) + unzigzag(code));
+  }
+  return true;
+}
+
+void writeOrientation(BitWriter &writer, uint32_t packed, uint32_t bits) {
+  writer.write(packed >> (3U * bits), 2U);
+  writer.write(packed & ((1U << (3U * bits)) - 1U), 3U * bits);
+}
+
+uint32_t readOrientation(BitReader &reader, uint32_t bits) {
+  uint32_t largest = reader.read(2U);
+  return (largest << (3U * bits)) | reader.read(3U * bits);
+}
+
+/* While the largest component stays the same the other three change a little each tick, so their differences are sent */
+void writeOrientationDelta(BitWriter &writer, uint32_t packed, uint32_t baseline, uint32_t bits) {
+  if ((packed >> (3U * bits)) != (baseline >> (3U * bits))) {
+    writer.write(0U, 1U);
+    writeOrientation(writer, packed, bits);
+    return;
+  }
+
+  const uint32_t mask = (1U << bits) - 1U;
+  uint32_t codes[3];
+  for (uint32_t i = 0U; i < 3U; i++) {
+    uint32_t shift = (2U - i) * bits;
+    codes[i] = zigzag(((packed >> shift) & mask) - ((baseline >> shift) & mask));
+  }
+
+  uint32_t width = static_cast<uint32_t>(std::bit_width(codes[0] | codes[1] | codes[2]));
+  writer.write(1U, 1U);
+  writer.write(width, ORIENTATION_WIDTH_BITS);
+  if (width > 0U) {
+    for (uint32_t i = 0U; i < 3U; i++) {
+      writer.write(codes[i], width);
+    }
+  }
+}
+
+bool readOrientationDelta(BitReader &reader, uint32_t baseline, uint32_t bits, uint32_t &packed) {
+  if (reader.read(1U) == 0U) {
+    packed = readOrientation(reader, bits);
+    return true;
+  }
+
+  const uint32_t mask = (1U << bits) - 1U;
+  uint32_t width = reader.read(ORIENTATION_WIDTH_BITS);
+  if (width > bits + 1U) {
+    return false;
+  }
+
+  packed = baseline & ~((1U << (3U * bits)) - 1U);
+  for (uint32_t i = 0U; i < 3U; i++) {
+    uint32_t shift = (2U - i) * bits;
+    uint32_t component = ((baseline >> shift) & mask) + unzigzag((width > 0U) ? reader.read(width) : 0U);
+    if (component > mask) {
+      return false;
+    }
+    packed |= component << shift;
+  }
+
+  return true;
+}
+
+ReplicationOptions sanitize(const ReplicationOptions &options) {
+  ReplicationOptions result = options;
+  result.orientationBits = std::clamp(result.orientationBits, 2U, REPLICATION_MAX_ORIENTATION_BITS);
+  result.historyLength = std::max(result.historyLength, 1U);
+  return result;
+}
+}  // namespace
+
+void ReplicationTick::resize(uint32_t slots) {
+  slotCount = slots;
+  generation.resize(slots);
+  position.resize(static_cast<size_t>(slots) * 3U);
+  orientation.resize(slots);
+  asleep.resize(slots);
+}
+
+ReplicationEncoder::ReplicationEncoder(const ReplicationOptions &options) : options(sanitize(options)), ticks(this->options.historyLength) {}
+
+void ReplicationEncoder::reserve(uint32_t slotCount) {
+  for (ReplicationTick &tick : ticks) {
+    tick.generation.reserve(slotCount);
+    tick.position.reserve(static_cast<size_t>(slotCount) * 3U);
+    tick.orientation.reserve(slotCount);
+    tick.asleep.reserve(slotCount);
+  }
+}
+
+uint32_t ReplicationEncoder::capture(const PhysicsWorld &world) {
+  const BodyStore &store = world.getBodyStore();
+  const uint32_t count = static_cast<uint32_t>(store.size());
+
+  uint32_t slotCount = 0U;
+  for (uint32_t i = 0U; i < count; i++) {
+    slotCount = std::max(slotCount, store.ids[i].index + 1U);
+  }
+
+  /* Bodies go to the slot of their handle, which stays put when other bodies are destroyed, unlike the dense index */
+  ReplicationTick &tick = ticks[nextSequence % ticks.size()];
+  tick.resize(slotCount);
+  std::fill(tick.generation.begin(), tick.generation.end(), 0U);
+
+  const float scale = 1.0f / options.positionPrecision;
+  for (uint32_t i = 0U; i < count; i++) {
+    const uint32_t slot = store.ids[i].index;
+    tick.generation[slot] = store.ids[i].generation;
+    int32_t *position = &tick.position[static_cast<size_t>(slot) * 3U];
+    position[0] = quantizePosition(store.position.x[i], scale);
+    position[1] = quantizePosition(store.position.y[i], scale);
+    position[2] = quantizePosition(store.position.z[i], scale);
+    tick.orientation[slot] = packOrientation(store.orientation.get(i), options.orientationBits);
+    tick.asleep[slot] = store.isAwake(i) ? 0U : 1U;
+  }
+
+  tick.sequence = nextSequence;
+  return nextSequence++;
+}
+
+size_t ReplicationEncoder::encode(uint32_t baseline, std::span<uint8_t> packet) const {
+  const ReplicationTick *current = (nextSequence > 0U) ? findTick(nextSequence - 1U) : nullptr;
+  if (!current || current->slotCount > options.maxSlots || packet.size() < sizeof(ReplicationPacketHeader)) {
+    return 0U;
+  }
+
+  const ReplicationTick *base = (baseline < current->sequence) ? findTick(baseline) : nullptr;
+  if (!base) {
+    base = &empty;
+  }
+
+  const uint32_t bits = options.orientationBits;
+  BitWriter writer(packet.data() + sizeof(ReplicationPacketHeader), packet.size() - sizeof(ReplicationPacketHeader));
+  uint32_t entryCount = 0U;
+  uint32_t nextSlot = 0U;
+
+  /* Slots past the current slot count are dropped by the decoder without entries */
+  for (uint32_t slot = 0U; slot < current->slotCount; slot++) {
+    const uint32_t generation = current->generation[slot];
+    const uint32_t baseGeneration = (slot < base->slotCount) ? base->generation[slot] : 0U;
+    const int32_t *position = &current->position[static_cast<size_t>(slot) * 3U];
+
+    ReplicationEntry kind;
+    if (generation == 0U) {
+      if (baseGeneration == 0U) {
+        continue;
+      }
+      kind = ReplicationEntry::REMOVED;
+    } else if (generation == baseGeneration) {
+      /* Sleeping bodies don't move, so they drop out here along with anything else at rest */
+      const int32_t *basePosition = &base->position[static_cast<size_t>(slot) * 3U];
+      if (position[0] == basePosition[0] && position[1] == basePosition[1] && position[2] == basePosition[2] &&
+          current->orientation[slot] == base->orientation[slot] && current->asleep[slot] == base->asleep[slot]) {
+        continue;
+      }
+      kind = ReplicationEntry::UPDATE;
+    } else {
+      kind = ReplicationEntry::SPAWN;
+    }
+
+    writer.writeGamma(slot - nextSlot + 1U);
+    writer.write(static_cast<uint32_t>(kind), 2U);
+    nextSlot = slot + 1U;
+    entryCount++;
+
+    if (kind == ReplicationEntry::REMOVED) {
+      continue;
+    }
+
+    writer.write(current->asleep[slot], 1U);
+    if (kind == ReplicationEntry::UPDATE) {
+      writePosition(writer, position, &base->position[static_cast<size_t>(slot) * 3U]);
+      writeOrientationDelta(writer, current->orientation[slot], base->orientation[slot], bits);
+    } else {
+      const int32_t origin[3] = {0, 0, 0};
+      writer.writeGamma(generation);
+      writePosition(writer, position, origin);
+      writeOrientation(writer, current->orientation[slot], bits);
+    }
+  }
+
+  size_t size = writer.finish(packet.data() + sizeof(ReplicationPacketHeader));
+  if (size == 0U && entryCount > 0U) {
+    return 0U;
+  }
+
+  ReplicationPacketHeader header{current->sequence, (base == &empty) ? REPLICATION_NO_BASELINE : baseline, current->slotCount, entryCount};
+  std::memcpy(packet.data(), &header, sizeof(header));
+  return sizeof(header) + size;
+}
+
+size_t ReplicationEncoder::getMaxPacketSize() const {
+  const ReplicationTick *current = (nextSequence > 0U) ? findTick(nextSequence - 1U) : nullptr;
+  const size_t slotCount = current ? current->slotCount : 0U;
+
+  /* A word of slack for the writer flushing whole words */
+  return sizeof(ReplicationPacketHeader) + ((slotCount * MAX_ENTRY_BITS) + 7U) / 8U + sizeof(uint32_t);
+}
+
+uint32_t ReplicationEncoder::getLatestSequence() const {
+  return (nextSequence > 0U) ? nextSequence - 1U : REPLICATION_NO_BASELINE;
+}
+
+const ReplicationOptions &ReplicationEncoder::getOptions() const {
+  return options;
+}
+
+const ReplicationTick *ReplicationEncoder::findTick(uint32_t sequence) const {
+  const ReplicationTick &tick = ticks[sequence % ticks.size()];
+  return (sequence != REPLICATION_NO_BASELINE && tick.sequence == sequence) ? &tick : nullptr;
+}
+
+ReplicationDecoder::ReplicationDecoder(const ReplicationOptions &options) : options(sanitize(options)), ticks(this->options.historyLength) {}
+
+void ReplicationDecoder::reserve(uint32_t slotCount) {
+  for (ReplicationTick &tick : ticks) {
+    tick.generation.reserve(slotCount);
+    tick.position.reserve(static_cast<size_t>(slotCount) * 3U);
+    tick.orientation.reserve(slotCount);
+    tick.asleep.reserve(slotCount);
+  }
+}
+
+void ReplicationDecoder::reset() {
+  for (ReplicationTick &tick : ticks) {
+    tick.sequence = REPLICATION_NO_BASELINE;
+  }
+  latest = REPLICATION_NO_BASELINE;
+  lastEntryCount = 0U;
+}
+
+bool ReplicationDecoder::decode(std::span<const uint8_t> packet) {
+  ReplicationPacketHeader header;
+  if (packet.size() < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, packet.data(), sizeof(header));
+
+  /* Checked before anything is sized from the header, so damage can't make it allocate more than the options allow */
+  if (header.slotCount > options.maxSlots || header.entryCount > header.slotCount) {
+    return false;
+  }
+
+  if (header.sequence == REPLICATION_NO_BASELINE || (latest != REPLICATION_NO_BASELINE && header.sequence <= latest)) {
+    return false;
+  }
+
+  const ReplicationTick *base = &empty;
+  if (header.baseline != REPLICATION_NO_BASELINE) {
+    const ReplicationTick &tick = ticks[header.baseline % ticks.size()];
+    if (header.baseline >= header.sequence || tick.sequence != header.baseline) {
+      return false;
+    }
+    base = &tick;
+  }
+
+  /* The tick being written over is older than anything the encoder would use as a baseline. It is marked empty until the packet
+     has decoded, so a damaged one doesn't leave a half written tick behind */
+  ReplicationTick &tick = ticks[header.sequence % ticks.size()];
+  if (&tick == base) {
+    return false;
+  }
+  tick.sequence = REPLICATION_NO_BASELINE;
+  tick.resize(header.slotCount);
+
+  const uint32_t kept = std::min(base->slotCount, header.slotCount);
+  std::copy_n(base->generation.begin(), kept, tick.generation.begin());
+  std::fill(tick.generation.begin() + kept, tick.generation.end(), 0U);
+  std::copy_n(base->position.begin(), static_cast<size_t>(kept) * 3U, tick.position.begin());
+  std::copy_n(base->orientation.begin(), kept, tick.orientation.begin());
+  std::copy_n(base->asleep.begin(), kept, tick.asleep.begin());
+
+  const uint32_t bits = options.orientationBits;
+  BitReader reader(packet.data() + sizeof(header), packet.size() - sizeof(header));
+  uint32_t nextSlot = 0U;
+  for (uint32_t entry = 0U; entry < header.entryCount; entry++) {
+    const uint32_t gap = reader.readGamma();
+    const uint32_t kind = reader.read(2U);
+    if (reader.hasFailed() || gap > header.slotCount - nextSlot) {
+      return false;
+    }
+
+    const uint32_t slot = nextSlot + gap - 1U;
+    nextSlot = slot + 1U;
+    int32_t *position = &tick.position[static_cast<size_t>(slot) * 3U];
+
+    if (kind == static_cast<uint32_t>(ReplicationEntry::REMOVED)) {
+      tick.generation[slot] = 0U;
+    } else if (kind == static_cast<uint32_t>(ReplicationEntry::UPDATE)) {
+      if (tick.generation[slot] == 0U) {
+        return false;
+      }
+
+      int32_t basePosition[3] = {position[0], position[1], position[2]};
+      tick.asleep[slot] = static_cast<uint8_t>(reader.read(1U));
+      if (!readPosition(reader, position, basePosition) || !readOrientationDelta(reader, tick.orientation[slot], bits, tick.orientation[slot])) {
+        return false;
+      }
+    } else if (kind == static_cast<uint32_t>(ReplicationEntry::SPAWN)) {
+      const int32_t origin[3] = {0, 0, 0};
+      tick.asleep[slot] = static_cast<uint8_t>(reader.read(1U));
+      tick.generation[slot] = reader.readGamma();
+      if (!readPosition(reader, position, origin)) {
+        return false;
+      }
+      tick.orientation[slot] = readOrientation(reader, bits);
+    } else {
+      return false;
+    }
+  }
+
+  if (reader.hasFailed()) {
+    return false;
+  }
+
+  tick.sequence = header.sequence;
+  latest = header.sequence;
+  lastEntryCount = header.entryCount;
+  return true;
+}
+
+uint32_t ReplicationDecoder::getLatestSequence() const {
+  return latest;
+}
+
+uint32_t ReplicationDecoder::getLastEntryCount() const {
+  return lastEntryCount;
+}
+
+uint32_t ReplicationDecoder::getSlotCount() const {
+  return (latest != REPLICATION_NO_BASELINE) ? ticks[latest % ticks.size()].slotCount : 0U;
+}
+
+bool ReplicationDecoder::getBody(uint32_t slot, ReplicatedBody &body) const {
+  if (latest == REPLICATION_NO_BASELINE) {
+    return false;
+  }
+
+  const ReplicationTick &tick = ticks[latest % ticks.size()];
+  if (slot >= tick.slotCount || tick.generation[slot] == 0U) {
+    return false;
+  }
+
+  const float precision = options.positionPrecision;
+  body.id = BodyId{slot, tick.generation[slot]};
+  const int32_t *position = &tick.position[static_cast<size_t>(slot) * 3U];
+  body.position = Vector3D(position[0] * precision, position[1] * precision, position[2] * precision);
+  body.orientation = unpackOrientation(tick.orientation[slot], options.orientationBits);
+  body.asleep = tick.asleep[slot] != 0U;
+  return true;
+}
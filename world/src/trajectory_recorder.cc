@@ -0,0 +1,440 @@
+/*******************************************************************************************************************************
+ * @file   trajectory_recorder.cc
+ *
+ * @brief  Source file for streaming per-step body transforms to disk and reading them back
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "trajectory_recorder.h"
+
+namespace {
+constexpr uint32_t VALUES_PER_BODY = 7U; /**< Position x, y, z then orientation w, x, y, z */
+
+uint32_t quantize(float value, float scale) {
+  /* Clamped so a body flung far away saturates instead of overflowing */
+  float scaled = std::clamp(value * scale, -2147483520.0f, 2147483520.0f);
+  return static_cast<uint32_t>(static_cast<int32_t>(std::lrint(scaled)));
+}
+
+/* Residuals are taken with unsigned wrap around, zigzag maps small negative ones to small codes so they varint encode to a byte too */
+void putResidual(std::vector<uint8_t> &out, uint32_t residual) {
+  uint32_t code = (residual << 1U) ^ (0U - (residual >> 31U));
+
+  while (code >= 0x80U) {
+    out.push_back(static_cast<uint8_t>(code | 0x80U));
+    code >>= 7U;
+  }
+  out.push_back(static_cast<uint8_t>(code));
+}
+
+bool getResidual(const uint8_t *&cursor, const uint8_t *end, uint32_t &residual) {
+  uint32_t code = 0U;
+  for (uint32_t shift = 0U; shift < 35U; shift += 7U) {
+    if (cursor == end) {
+      return false;
+    }
+
+    uint8_t byte = *cursor++;
+    code |= static_cast<uint32_t>(byte & 0x7FU) << shift;
+    if ((byte & 0x80U) == 0U) {
+      residual = (code >> 1U) ^ (0U - (code & 1U));
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template <typename T>
+void appendBytes(std::vector<uint8_t> &out, const T *data, size_t count) {
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data);
+  out.insert(out.end(), bytes, bytes + count * sizeof(T));
+}
+}  // namespace
+
+TrajectoryRecorder::TrajectoryRecorder() = default;
+
+TrajectoryRecorder::~TrajectoryRecorder() {
+  close();
+}
+
+bool TrajectoryRecorder::open(const std::string &path, const TrajectoryOptions &options) {
+  close();
+
+  file.open(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return false;
+  }
+
+  this->options = options;
+  this->options.framesPerChunk = std::max(this->options.framesPerChunk, 1U);
+  frames = std::vector<RingFrame>(std::max(options.ringFrames, 1U));
+  head.store(0U, std::memory_order_relaxed);
+  tail.store(0U, std::memory_order_relaxed);
+  writtenFrames.store(0U, std::memory_order_relaxed);
+  writtenBytes.store(0U, std::memory_order_relaxed);
+  stallCount = 0U;
+  failed = false;
+  chunk.clear();
+  chunkFrames = 0U;
+  chunkFirstFrame = 0U;
+  chunkIndex.clear();
+
+  TrajectoryFileHeader header{};
+  std::memcpy(header.magic, TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC));
+  header.version = TRAJECTORY_VERSION;
+  header.framesPerChunk = this->options.framesPerChunk;
+  header.positionPrecision = this->options.positionPrecision;
+  writeBytes(&header, sizeof(header));
+
+  running.store(true, std::memory_order_relaxed);
+  writer = std::thread(&TrajectoryRecorder::writerLoop, this);
+  return !failed;
+}
+
+void TrajectoryRecorder::record(const PhysicsWorld &world) {
+  if (!writer.joinable()) {
+    return;
+  }
+
+  const uint64_t position = head.load(std::memory_order_relaxed);
+  if (position - tail.load(std::memory_order_acquire) == frames.size()) {
+    stallCount++;
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    recorderWaiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    wakeCondition.wait(lock, [this, position]() { return position - tail.load(std::memory_order_acquire) < frames.size(); });
+    recorderWaiting.store(false, std::memory_order_relaxed);
+  }
+
+  /* The writer is done with this frame, so it is only touched here until it is published */
+  const BodyStore &store = world.getBodyStore();
+  const size_t count = store.size();
+  RingFrame &frame = frames[position % frames.size()];
+  frame.ids.assign(store.ids.data(), count);
+  frame.position.x.assign(store.position.x.data(), count);
+  frame.position.y.assign(store.position.y.data(), count);
+  frame.position.z.assign(store.position.z.data(), count);
+  frame.orientation.w.assign(store.orientation.w.data(), count);
+  frame.orientation.x.assign(store.orientation.x.data(), count);
+  frame.orientation.y.assign(store.orientation.y.data(), count);
+  frame.orientation.z.assign(store.orientation.z.data(), count);
+
+  head.store(position + 1U, std::memory_order_release);
+  wake(writerWaiting);
+}
+
+bool TrajectoryRecorder::close() {
+  if (!writer.joinable()) {
+    return !failed;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    running.store(false, std::memory_order_relaxed);
+  }
+  wakeCondition.notify_all();
+  writer.join();
+
+  /* The writer has drained the ring and flushed its last chunk, the table and footer finish the file */
+  TrajectoryFooter footer{};
+  footer.indexOffset = writtenBytes.load(std::memory_order_relaxed);
+  footer.chunkCount = chunkIndex.size();
+  footer.frameCount = writtenFrames.load(std::memory_order_relaxed);
+  std::memcpy(footer.magic, TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC));
+  writeBytes(chunkIndex.data(), chunkIndex.size() * sizeof(TrajectoryChunkEntry));
+  writeBytes(&footer, sizeof(footer));
+
+  file.close();
+  failed = failed || file.fail();
+  return !failed;
+}
+
+bool TrajectoryRecorder::isOpen() const {
+  return writer.joinable();
+}
+
+uint64_t TrajectoryRecorder::getRecordedFrames() const {
+  return head.load(std::memory_order_relaxed);
+}
+
+uint64_t TrajectoryRecorder::getWrittenFrames() const {
+  return writtenFrames.load(std::memory_order_relaxed);
+}
+
+uint64_t TrajectoryRecorder::getWrittenBytes() const {
+  return writtenBytes.load(std::memory_order_relaxed);
+}
+
+uint64_t TrajectoryRecorder::getStallCount() const {
+  return stallCount;
+}
+
+void TrajectoryRecorder::writerLoop() {
+  while (true) {
+    const uint64_t position = tail.load(std::memory_order_relaxed);
+    if (position == head.load(std::memory_order_acquire)) {
+      std::unique_lock<std::mutex> lock(wakeMutex);
+      writerWaiting.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      wakeCondition.wait(lock, [this, position]() { return position != head.load(std::memory_order_acquire) || !running.load(std::memory_order_relaxed); });
+      writerWaiting.store(false, std::memory_order_relaxed);
+
+      /* Every frame published before close() is written first */
+      if (position == head.load(std::memory_order_acquire)) {
+        break;
+      }
+    }
+
+    encodeFrame(frames[position % frames.size()]);
+    tail.store(position + 1U, std::memory_order_release);
+    wake(recorderWaiting);
+  }
+
+  flushChunk();
+}
+
+void TrajectoryRecorder::wake(const std::atomic<bool> &waiting) {
+  /* Pairs with the fence a thread makes between raising its flag and checking the ring. Either it sees what was just published,
+     or this sees its flag. Under the lock it is then either asleep or yet to check, so the wake-up can't be missed */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    wakeCondition.notify_all();
+  }
+}
+
+void TrajectoryRecorder::encodeFrame(const RingFrame &frame) {
+  const uint32_t count = static_cast<uint32_t>(frame.ids.size());
+  const float positionScale = 1.0f / options.positionPrecision;
+
+  /* Deltas follow bodies by dense index, which removals reorder. A frame whose handles changed is stored against zero instead */
+  const bool idsChanged = count != lastIds.size() || (count > 0U && std::memcmp(frame.ids.data(), lastIds.data(), count * sizeof(BodyId)) != 0);
+  TrajectoryFrameHeader header{count, idsChanged ? TRAJECTORY_FRAME_IDS : 0U};
+  appendBytes(chunk, &header, 1U);
+  if (idsChanged) {
+    appendBytes(chunk, frame.ids.data(), count);
+    lastIds.assign(frame.ids.data(), frame.ids.data() + count);
+    lastQuantized.assign(static_cast<size_t>(count) * VALUES_PER_BODY, 0U);
+    lastDeltas.assign(static_cast<size_t>(count) * VALUES_PER_BODY, 0U);
+  }
+
+  /* Each value is predicted to move by as much as it did last frame, so a body in free flight or at rest costs a byte per value */
+  uint32_t *last = lastQuantized.data();
+  uint32_t *lastDelta = lastDeltas.data();
+  for (uint32_t i = 0U; i < count; i++, last += VALUES_PER_BODY, lastDelta += VALUES_PER_BODY) {
+    const uint32_t values[VALUES_PER_BODY] = {quantize(frame.position.x[i], positionScale),
+                                              quantize(frame.position.y[i], positionScale),
+                                              quantize(frame.position.z[i], positionScale),
+                                              quantize(frame.orientation.w[i], TRAJECTORY_ORIENTATION_SCALE),
+                                              quantize(frame.orientation.x[i], TRAJECTORY_ORIENTATION_SCALE),
+                                              quantize(frame.orientation.y[i], TRAJECTORY_ORIENTATION_SCALE),
+                                              quantize(frame.orientation.z[i], TRAJECTORY_ORIENTATION_SCALE)};
+
+    for (uint32_t value = 0U; value < VALUES_PER_BODY; value++) {
+      uint32_t delta = values[value] - last[value];
+      putResidual(chunk, delta - lastDelta[value]);
+      last[value] = values[value];
+      lastDelta[value] = delta;
+    }
+  }
+
+  if (++chunkFrames == options.framesPerChunk) {
+    flushChunk();
+  }
+}
+
+void TrajectoryRecorder::flushChunk() {
+  if (chunkFrames == 0U) {
+    return;
+  }
+
+  chunkIndex.push_back(TrajectoryChunkEntry{chunkFirstFrame, writtenBytes.load(std::memory_order_relaxed)});
+  TrajectoryChunkHeader header{chunkFirstFrame, chunkFrames, static_cast<uint32_t>(chunk.size())};
+  writeBytes(&header, sizeof(header));
+  writeBytes(chunk.data(), chunk.size());
+  writtenFrames.fetch_add(chunkFrames, std::memory_order_relaxed);
+
+  /* The next chunk starts from scratch so it can be decoded without this one. The buffers keep their capacity */
+  chunkFirstFrame += chunkFrames;
+  chunkFrames = 0U;
+  chunk.clear();
+  lastIds.clear();
+  lastQuantized.clear();
+  lastDeltas.clear();
+}
+
+void TrajectoryRecorder::writeBytes(const void *data, size_t size) {
+  file.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+  writtenBytes.fetch_add(size, std::memory_order_relaxed);
+  failed = failed || !file;
+}
+
+bool TrajectoryReader::open(const std::string &path) {
+  file = std::ifstream(path, std::ios::binary);
+  chunkIndex.clear();
+  frameCount = 0U;
+  loadedChunk = NO_CHUNK;
+
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || std::memcmp(header.magic, TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC)) != 0 ||
+      header.version != TRAJECTORY_VERSION || !(header.positionPrecision > 0.0f)) {
+    return false;
+  }
+
+  file.seekg(0, std::ios::end);
+  const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+
+  TrajectoryFooter footer{};
+  if (fileSize >= sizeof(header) + sizeof(footer)) {
+    file.seekg(static_cast<std::streamoff>(fileSize - sizeof(footer)));
+    file.read(reinterpret_cast<char *>(&footer), sizeof(footer));
+  }
+
+  if (file && std::memcmp(footer.magic, TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC)) == 0 && footer.chunkCount <= fileSize / sizeof(TrajectoryChunkEntry) &&
+      footer.indexOffset + footer.chunkCount * sizeof(TrajectoryChunkEntry) + sizeof(footer) == fileSize) {
+    chunkIndex.resize(footer.chunkCount);
+    file.seekg(static_cast<std::streamoff>(footer.indexOffset));
+    file.read(reinterpret_cast<char *>(chunkIndex.data()), static_cast<std::streamsize>(chunkIndex.size() * sizeof(TrajectoryChunkEntry)));
+    frameCount = footer.frameCount;
+    return static_cast<bool>(file);
+  }
+
+  /* No footer, the recording was cut short. Every complete chunk is still readable by walking the chunk headers */
+  file.clear();
+  uint64_t offset = sizeof(header);
+  TrajectoryChunkHeader chunkHeader{};
+  while (offset + sizeof(chunkHeader) <= fileSize) {
+    file.seekg(static_cast<std::streamoff>(offset));
+    if (!file.read(reinterpret_cast<char *>(&chunkHeader), sizeof(chunkHeader)) || chunkHeader.firstFrame != frameCount ||
+        offset + sizeof(chunkHeader) + chunkHeader.byteSize > fileSize) {
+      break;
+    }
+
+    chunkIndex.push_back(TrajectoryChunkEntry{chunkHeader.firstFrame, offset});
+    frameCount += chunkHeader.frameCount;
+    offset += sizeof(chunkHeader) + chunkHeader.byteSize;
+  }
+
+  file.clear();
+  return true;
+}
+
+uint64_t TrajectoryReader::getFrameCount() const {
+  return frameCount;
+}
+
+float TrajectoryReader::getPositionPrecision() const {
+  return header.positionPrecision;
+}
+
+bool TrajectoryReader::readFrame(uint64_t index, TrajectoryFrame &frame) {
+  if (index >= frameCount) {
+    return false;
+  }
+
+  auto entry = std::upper_bound(chunkIndex.begin(), chunkIndex.end(), index, [](uint64_t value, const TrajectoryChunkEntry &chunkEntry) { return value < chunkEntry.firstFrame; });
+  const size_t chunkNumber = static_cast<size_t>(entry - chunkIndex.begin()) - 1U;
+
+  /* Going backwards, or to another chunk, restarts from the chunk's first frame */
+  if ((chunkNumber != loadedChunk || index < nextFrame) && !loadChunk(chunkNumber)) {
+    return false;
+  }
+
+  while (nextFrame <= index) {
+    if (!decodeNextFrame()) {
+      loadedChunk = NO_CHUNK;
+      return false;
+    }
+  }
+
+  const size_t count = lastIds.size();
+  const float precision = header.positionPrecision;
+  const float orientationStep = 1.0f / TRAJECTORY_ORIENTATION_SCALE;
+  frame.index = index;
+  frame.ids.assign(lastIds.begin(), lastIds.end());
+  frame.positions.resize(count);
+  frame.orientations.resize(count);
+
+  const uint32_t *values = lastQuantized.data();
+  for (size_t i = 0U; i < count; i++, values += VALUES_PER_BODY) {
+    frame.positions[i] = Vector3D(static_cast<int32_t>(values[0]) * precision, static_cast<int32_t>(values[1]) * precision, static_cast<int32_t>(values[2]) * precision);
+    frame.orientations[i] = Quaternion(static_cast<int32_t>(values[3]) * orientationStep, static_cast<int32_t>(values[4]) * orientationStep,
+                                       static_cast<int32_t>(values[5]) * orientationStep, static_cast<int32_t>(values[6]) * orientationStep);
+  }
+
+  return true;
+}
+
+bool TrajectoryReader::loadChunk(size_t chunkNumber) {
+  loadedChunk = NO_CHUNK;
+
+  TrajectoryChunkHeader chunkHeader{};
+  file.seekg(static_cast<std::streamoff>(chunkIndex[chunkNumber].offset));
+  if (!file.read(reinterpret_cast<char *>(&chunkHeader), sizeof(chunkHeader))) {
+    file.clear();
+    return false;
+  }
+
+  chunk.resize(chunkHeader.byteSize);
+  if (!file.read(reinterpret_cast<char *>(chunk.data()), static_cast<std::streamsize>(chunk.size()))) {
+    file.clear();
+    return false;
+  }
+
+  loadedChunk = chunkNumber;
+  chunkEndFrame = chunkHeader.firstFrame + chunkHeader.frameCount;
+  chunkCursor = 0U;
+  nextFrame = chunkHeader.firstFrame;
+  lastIds.clear();
+  lastQuantized.clear();
+  lastDeltas.clear();
+  return true;
+}
+
+bool TrajectoryReader::decodeNextFrame() {
+  const uint8_t *cursor = chunk.data() + chunkCursor;
+  const uint8_t *end = chunk.data() + chunk.size();
+
+  TrajectoryFrameHeader frameHeader{};
+  if (nextFrame >= chunkEndFrame || static_cast<size_t>(end - cursor) < sizeof(frameHeader)) {
+    return false;
+  }
+  std::memcpy(&frameHeader, cursor, sizeof(frameHeader));
+  cursor += sizeof(frameHeader);
+
+  if ((frameHeader.flags & TRAJECTORY_FRAME_IDS) != 0U) {
+    if (static_cast<size_t>(end - cursor) / sizeof(BodyId) < frameHeader.bodyCount) {
+      return false;
+    }
+    lastIds.resize(frameHeader.bodyCount);
+    std::memcpy(static_cast<void *>(lastIds.data()), cursor, frameHeader.bodyCount * sizeof(BodyId));
+    cursor += frameHeader.bodyCount * sizeof(BodyId);
+    lastQuantized.assign(static_cast<size_t>(frameHeader.bodyCount) * VALUES_PER_BODY, 0U);
+    lastDeltas.assign(static_cast<size_t>(frameHeader.bodyCount) * VALUES_PER_BODY, 0U);
+  } else if (frameHeader.bodyCount != lastIds.size()) {
+    return false;
+  }
+
+  for (size_t i = 0U; i < lastQuantized.size(); i++) {
+    uint32_t residual;
+    if (!getResidual(cursor, end, residual)) {
+      return false;
+    }
+    lastDeltas[i] += residual;
+    lastQuantized[i] += lastDeltas[i];
+  }
+
+  chunkCursor = static_cast<size_t>(cursor - chunk.data());
+  nextFrame++;
+  return true;
+}
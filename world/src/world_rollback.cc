@@ -0,0 +1,130 @@
+/*******************************************************************************************************************************
+ * @file   world_rollback.cc
+ *
+ * @brief  Source file for saving and restoring world state in memory
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+
+/* Inter-component Headers */
+
+/* Intra-component Headers */
+#include "physics_world.h"
+
+namespace {
+void copyColumn(AlignedArray<float> &destination, const AlignedArray<float> &source) {
+  destination.assign(source.data(), source.size());
+}
+
+void copyColumn(AlignedArray<uint32_t> &destination, const AlignedArray<uint32_t> &source) {
+  destination.assign(source.data(), source.size());
+}
+
+void copyColumn(Vector3DArray &destination, const Vector3DArray &source) {
+  copyColumn(destination.x, source.x);
+  copyColumn(destination.y, source.y);
+  copyColumn(destination.z, source.z);
+}
+
+void copyColumn(QuaternionArray &destination, const QuaternionArray &source) {
+  copyColumn(destination.w, source.w);
+  copyColumn(destination.x, source.x);
+  copyColumn(destination.y, source.y);
+  copyColumn(destination.z, source.z);
+}
+}  // namespace
+
+void PhysicsWorld::setStateSlotCount(uint32_t count) {
+  savedStates.clear();
+  savedStates.resize(count);
+
+  /* Sized for today's bodies, and a contact or so per body for the impulse cache */
+  const size_t bodyCount = bodyStore.size();
+  for (SavedState &state : savedStates) {
+    state.position.reserve(bodyCount);
+    state.orientation.reserve(bodyCount);
+    state.linearVelocity.reserve(bodyCount);
+    state.angularVelocity.reserve(bodyCount);
+    state.force.reserve(bodyCount);
+    state.torque.reserve(bodyCount);
+    state.sleepTime.reserve(bodyCount);
+    state.sleepIsland.reserve(bodyCount);
+    state.impulseCache.reserve(std::max(bodyCount, contactSolver.impulseCache.size()));
+  }
+}
+
+uint32_t PhysicsWorld::getStateSlotCount() const {
+  return static_cast<uint32_t>(savedStates.size());
+}
+
+bool PhysicsWorld::saveState(uint32_t slot) {
+  if (savedStates.empty()) {
+    return false;
+  }
+
+  SavedState &state = savedStates[slot % savedStates.size()];
+  state.bodySetVersion = bodySetVersion;
+  copyColumn(state.position, bodyStore.position);
+  copyColumn(state.orientation, bodyStore.orientation);
+  copyColumn(state.linearVelocity, bodyStore.linearVelocity);
+  copyColumn(state.angularVelocity, bodyStore.angularVelocity);
+  copyColumn(state.force, bodyStore.force);
+  copyColumn(state.torque, bodyStore.torque);
+  copyColumn(state.sleepTime, bodyStore.sleepTime);
+  copyColumn(state.sleepIsland, bodyStore.sleepIsland);
+
+  /* Assigning over the slot's old contents reuses their capacity, islands included */
+  state.sleepingIslands = bodyStore.sleepingIslands;
+  state.freeIslands = bodyStore.freeIslands;
+  state.impulseCache = contactSolver.impulseCache;
+  return true;
+}
+
+bool PhysicsWorld::restoreState(uint32_t slot) {
+  if (savedStates.empty()) {
+    return false;
+  }
+
+  const SavedState &state = savedStates[slot % savedStates.size()];
+  if (state.bodySetVersion != bodySetVersion) {
+    return false;
+  }
+
+  /* The next step refreshes the bounds of awake bodies only, a sleeper's bounds are where it came to rest. Those of bodies asleep in
+     the saved state are put back here, unless the body is asleep now at the same position. Checked before the positions are
+     overwritten */
+  for (const std::vector<BodyId> &island : state.sleepingIslands) {
+    for (BodyId member : island) {
+      if (!bodyStore.isValid(member)) {
+        continue;
+      }
+
+      uint32_t index = bodyStore.indexOf(member);
+      Vector3D saved = state.position.get(index);
+      Vector3D current = bodyStore.position.get(index);
+      if (bodyStore.isAwake(index) || saved.x != current.x || saved.y != current.y || saved.z != current.z) {
+        float radius = bodyStore.boundingRadius[index];
+        Vector3D extent(radius, radius, radius);
+        broadphase->moveProxy(bodyStore.broadphaseProxy[index], AABB{saved - extent, saved + extent});
+      }
+    }
+  }
+
+  copyColumn(bodyStore.position, state.position);
+  copyColumn(bodyStore.orientation, state.orientation);
+  copyColumn(bodyStore.linearVelocity, state.linearVelocity);
+  copyColumn(bodyStore.angularVelocity, state.angularVelocity);
+  copyColumn(bodyStore.force, state.force);
+  copyColumn(bodyStore.torque, state.torque);
+  copyColumn(bodyStore.sleepTime, state.sleepTime);
+  copyColumn(bodyStore.sleepIsland, state.sleepIsland);
+  bodyStore.sleepingIslands = state.sleepingIslands;
+  bodyStore.freeIslands = state.freeIslands;
+  contactSolver.impulseCache = state.impulseCache;
+
+  return true;
+}
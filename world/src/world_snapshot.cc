@@ -0,0 +1,528 @@
+/*******************************************************************************************************************************
+ * @file   world_snapshot.cc
+ *
+ * @brief  Source file for saving and loading world snapshots
+ *
+ * @date   2026-10-18
+ * @author Aryan Kashem
+ *******************************************************************************************************************************/
+
+/* Standard library Headers */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* Inter-component Headers */
+#include "sphere.h"
+
+/* Intra-component Headers */
+#include "physics_world.h"
+#include "world_snapshot.h"
+
+namespace {
+
+static_assert(sizeof(BodyId) == sizeof(SnapshotSlot), "Handles are written to the file as the store holds them");
+
+size_t alignSnapshotOffset(size_t offset) {
+  return (offset + SNAPSHOT_ALIGNMENT - 1U) & ~(SNAPSHOT_ALIGNMENT - 1U);
+}
+
+/**
+ * @brief   Run visit(id, column) over every per-body column of a store that goes into a snapshot
+ * @details Broadphase proxies are left out, loading creates new ones. Shapes and views are cold data handled separately
+ */
+template <typename Store, typename Visitor>
+void visitBodyColumns(Store &store, Visitor &&visit) {
+  visit(SnapshotSectionId::POSITION_X, store.position.x);
+  visit(SnapshotSectionId::POSITION_Y, store.position.y);
+  visit(SnapshotSectionId::POSITION_Z, store.position.z);
+  visit(SnapshotSectionId::ORIENTATION_W, store.orientation.w);
+  visit(SnapshotSectionId::ORIENTATION_X, store.orientation.x);
+  visit(SnapshotSectionId::ORIENTATION_Y, store.orientation.y);
+  visit(SnapshotSectionId::ORIENTATION_Z, store.orientation.z);
+  visit(SnapshotSectionId::LINEAR_VELOCITY_X, store.linearVelocity.x);
+  visit(SnapshotSectionId::LINEAR_VELOCITY_Y, store.linearVelocity.y);
+  visit(SnapshotSectionId::LINEAR_VELOCITY_Z, store.linearVelocity.z);
+  visit(SnapshotSectionId::ANGULAR_VELOCITY_X, store.angularVelocity.x);
+  visit(SnapshotSectionId::ANGULAR_VELOCITY_Y, store.angularVelocity.y);
+  visit(SnapshotSectionId::ANGULAR_VELOCITY_Z, store.angularVelocity.z);
+  visit(SnapshotSectionId::FORCE_X, store.force.x);
+  visit(SnapshotSectionId::FORCE_Y, store.force.y);
+  visit(SnapshotSectionId::FORCE_Z, store.force.z);
+  visit(SnapshotSectionId::TORQUE_X, store.torque.x);
+  visit(SnapshotSectionId::TORQUE_Y, store.torque.y);
+  visit(SnapshotSectionId::TORQUE_Z, store.torque.z);
+  visit(SnapshotSectionId::INVERSE_MASS, store.inverseMass);
+  visit(SnapshotSectionId::INVERSE_INERTIA_X, store.inverseInertia.x);
+  visit(SnapshotSectionId::INVERSE_INERTIA_Y, store.inverseInertia.y);
+  visit(SnapshotSectionId::INVERSE_INERTIA_Z, store.inverseInertia.z);
+  visit(SnapshotSectionId::BOUNDING_RADIUS, store.boundingRadius);
+  visit(SnapshotSectionId::SHAPE_TYPE, store.shapeType);
+  visit(SnapshotSectionId::SHAPE_INDEX, store.shapeIndex);
+  visit(SnapshotSectionId::BODY_IDS, store.ids);
+  visit(SnapshotSectionId::SLEEP_TIME, store.sleepTime);
+  visit(SnapshotSectionId::SLEEP_ISLAND, store.sleepIsland);
+}
+
+SnapshotShape describeShape(const Shape &shape) {
+  SnapshotShape record{};
+  record.type = static_cast<uint32_t>(shape.getType());
+  record.restitution = shape.getRestitution();
+  record.friction = shape.getFriction();
+
+  switch (shape.getType()) {
+    case ShapeType::SPHERE: {
+      const Sphere &sphere = static_cast<const Sphere &>(shape);
+      record.parameters[0] = sphere.getRadius();
+      record.parameters[1] = sphere.getDensity();
+      break;
+    }
+    default:
+      break;
+  }
+
+  return record;
+}
+
+bool isValidShape(const SnapshotShape &record) {
+  switch (static_cast<ShapeType>(record.type)) {
+    case ShapeType::SPHERE:
+      return std::isfinite(record.parameters[0]) && record.parameters[0] > 0.0f && std::isfinite(record.parameters[1]);
+    default:
+      return false;
+  }
+}
+
+std::shared_ptr<Shape> createShape(const SnapshotShape &record) {
+  std::shared_ptr<Shape> shape;
+
+  switch (static_cast<ShapeType>(record.type)) {
+    case ShapeType::SPHERE:
+      shape = std::allocate_shared<Sphere>(PoolAllocator<Sphere>(), record.parameters[0], record.parameters[1]);
+      break;
+    default:
+      return nullptr;
+  }
+
+  shape->restitution = record.restitution;
+  shape->friction = record.friction;
+  return shape;
+}
+
+/**
+ * @brief   Collects the sections of a snapshot, then writes the file front to back in one pass
+ */
+class SnapshotWriter {
+ public:
+  template <typename T>
+  void add(SnapshotSectionId id, const T *data, size_t count) {
+    sections.push_back(Pending{id, static_cast<uint32_t>(sizeof(T)), count, data});
+  }
+
+  bool write(const std::string &path, SnapshotHeader header) const {
+    /* Every offset is known before the first byte goes out, so the header and table are final when written */
+    std::vector<SnapshotSection> table(sections.size());
+    size_t cursor = alignSnapshotOffset(sizeof(SnapshotHeader) + sections.size() * sizeof(SnapshotSection));
+
+    for (size_t i = 0U; i < sections.size(); i++) {
+      table[i] = SnapshotSection{static_cast<uint32_t>(sections[i].id), sections[i].elementSize, sections[i].count, cursor};
+      cursor = alignSnapshotOffset(cursor + sections[i].count * sections[i].elementSize);
+    }
+
+    header.sectionCount = static_cast<uint32_t>(sections.size());
+    header.fileSize = cursor;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      return false;
+    }
+
+    static constexpr std::array<char, SNAPSHOT_ALIGNMENT> PADDING{};
+    size_t written = sizeof(SnapshotHeader) + table.size() * sizeof(SnapshotSection);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(SnapshotSection)));
+
+    for (size_t i = 0U; i < sections.size(); i++) {
+      file.write(PADDING.data(), static_cast<std::streamsize>(table[i].offset - written));
+      written = table[i].offset + table[i].count * table[i].elementSize;
+      file.write(static_cast<const char *>(sections[i].data), static_cast<std::streamsize>(table[i].count * table[i].elementSize));
+    }
+    file.write(PADDING.data(), static_cast<std::streamsize>(cursor - written));
+
+    return static_cast<bool>(file.flush());
+  }
+
+ private:
+  struct Pending {
+    SnapshotSectionId id;
+    uint32_t elementSize;
+    uint64_t count;
+    const void *data;
+  };
+
+  std::vector<Pending> sections;
+};
+
+/**
+ * @brief   Read-only view of a whole file, memory mapped where the platform allows and read into a buffer elsewhere
+ */
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string &path) {
+#if defined(__unix__)
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+      return;
+    }
+
+    struct stat status;
+    if (::fstat(descriptor, &status) == 0 && status.st_size > 0) {
+      void *address = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+      if (address != MAP_FAILED) {
+        /* The columns are copied out front to back */
+        ::madvise(address, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+        bytes = static_cast<const uint8_t *>(address);
+        length = static_cast<size_t>(status.st_size);
+        mapped = true;
+      }
+    }
+    ::close(descriptor);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+      return;
+    }
+
+    /* Operator new aligns to at least 16 bytes, enough for every type a section holds */
+    buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (file.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
+      bytes = buffer.data();
+      length = buffer.size();
+    }
+#endif
+  }
+
+  ~MappedFile() {
+#if defined(__unix__)
+    if (mapped) {
+      ::munmap(const_cast<uint8_t *>(bytes), length);
+    }
+#endif
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const uint8_t *getData() const {
+    return bytes;
+  }
+
+  size_t getSize() const {
+    return length;
+  }
+
+ private:
+  const uint8_t *bytes{nullptr};
+  size_t length{0U};
+  bool mapped{false};
+  std::vector<uint8_t> buffer;
+};
+
+/**
+ * @brief   Checks a snapshot's header and section table and hands out typed views of the payloads, nothing is copied
+ */
+class SnapshotReader {
+ public:
+  bool open(const uint8_t *data, size_t size) {
+    if (!data || size < sizeof(SnapshotHeader)) {
+      return false;
+    }
+
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || header.version != SNAPSHOT_VERSION ||
+        header.byteOrder != SNAPSHOT_BYTE_ORDER || header.headerSize < sizeof(SnapshotHeader) || header.fileSize > size) {
+      return false;
+    }
+
+    const uint64_t tableEnd = header.headerSize + static_cast<uint64_t>(header.sectionCount) * sizeof(SnapshotSection);
+    if (tableEnd > header.fileSize) {
+      return false;
+    }
+
+    this->data = data;
+    sections.fill(nullptr);
+    for (uint32_t i = 0U; i < header.sectionCount; i++) {
+      const SnapshotSection *section = reinterpret_cast<const SnapshotSection *>(data + header.headerSize) + i;
+      if (section->offset % SNAPSHOT_ALIGNMENT != 0U || section->offset < tableEnd || section->offset > header.fileSize ||
+          section->elementSize == 0U || section->count > (header.fileSize - section->offset) / section->elementSize) {
+        return false;
+      }
+
+      /* Sections from later writers are skipped */
+      if (section->id < sections.size() && !sections[section->id]) {
+        sections[section->id] = section;
+      }
+    }
+
+    return true;
+  }
+
+  const SnapshotHeader &getHeader() const {
+    return header;
+  }
+
+  /**
+   * @return  false if the section is missing or its elements aren't the size of T
+   */
+  template <typename T>
+  bool get(SnapshotSectionId id, std::span<const T> &values) const {
+    const SnapshotSection *section = sections[static_cast<size_t>(id)];
+    if (!section || section->elementSize != sizeof(T)) {
+      return false;
+    }
+
+    values = std::span<const T>(reinterpret_cast<const T *>(data + section->offset), section->count);
+    return true;
+  }
+
+ private:
+  SnapshotHeader header{};
+  const uint8_t *data{nullptr};
+  std::array<const SnapshotSection *, static_cast<size_t>(SnapshotSectionId::COUNT)> sections{};
+};
+
+}  // namespace
+
+bool PhysicsWorld::saveSnapshot(const std::string &path) const {
+  static_assert(sizeof(BodyStore::Slot) == sizeof(SnapshotSlot), "Slots are written to the file as the store holds them");
+  const size_t bodyCount = bodyStore.size();
+
+  SnapshotHeader header{};
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+  header.version = SNAPSHOT_VERSION;
+  header.headerSize = sizeof(SnapshotHeader);
+  header.byteOrder = SNAPSHOT_BYTE_ORDER;
+  header.bodyCount = bodyCount;
+  header.freeSlotHead = bodyStore.freeSlotHead;
+
+  SnapshotSettings settings{};
+  settings.gravity[0] = gravity.x;
+  settings.gravity[1] = gravity.y;
+  settings.gravity[2] = gravity.z;
+  settings.timeStep = timeStep;
+  settings.linearSleepThreshold = linearSleepThreshold;
+  settings.angularSleepThreshold = angularSleepThreshold;
+  settings.timeToSleep = timeToSleep;
+  settings.sleepingEnabled = sleepingEnabled ? 1U : 0U;
+  settings.broadphaseType = static_cast<uint32_t>(broadphaseType);
+  settings.velocityIterations = contactSolver.velocityIterations;
+  settings.positionIterations = contactSolver.positionIterations;
+  settings.positionCorrection = static_cast<uint32_t>(contactSolver.positionCorrection);
+  settings.warmStarting = contactSolver.warmStarting ? 1U : 0U;
+
+  /* Bodies usually share a handful of shapes, each distinct one is stored once */
+  std::vector<SnapshotShape> shapes;
+  std::vector<uint32_t> bodyShapes(bodyCount);
+  std::unordered_map<const Shape *, uint32_t> shapeIndices;
+  for (size_t i = 0U; i < bodyCount; i++) {
+    auto [entry, inserted] = shapeIndices.try_emplace(bodyStore.shapes[i].get(), static_cast<uint32_t>(shapes.size()));
+    if (inserted) {
+      shapes.push_back(describeShape(*bodyStore.shapes[i]));
+    }
+    bodyShapes[i] = entry->second;
+  }
+
+  /* Sleeping islands are flattened into one list of handles and the start of each island */
+  std::vector<uint64_t> islandOffsets{0U};
+  std::vector<BodyId> islandBodies;
+  for (const std::vector<BodyId> &island : bodyStore.sleepingIslands) {
+    islandBodies.insert(islandBodies.end(), island.begin(), island.end());
+    islandOffsets.push_back(islandBodies.size());
+  }
+
+  std::vector<SnapshotImpulse> impulses;
+  impulses.reserve(contactSolver.impulseCache.size());
+  for (const ContactSolver::CachedImpulse &cached : contactSolver.impulseCache) {
+    impulses.push_back(SnapshotImpulse{cached.cacheKey, SnapshotSlot{cached.bodyA.index, cached.bodyA.generation}, SnapshotSlot{cached.bodyB.index, cached.bodyB.generation},
+                                       cached.normalImpulse, {cached.tangentImpulse.x, cached.tangentImpulse.y, cached.tangentImpulse.z}});
+  }
+
+  SnapshotWriter writer;
+  writer.add(SnapshotSectionId::SETTINGS, &settings, 1U);
+  writer.add(SnapshotSectionId::SHAPES, shapes.data(), shapes.size());
+  writer.add(SnapshotSectionId::BODY_SHAPE, bodyShapes.data(), bodyShapes.size());
+  visitBodyColumns(bodyStore, [&writer](SnapshotSectionId id, const auto &column) { writer.add(id, column.data(), column.size()); });
+  writer.add(SnapshotSectionId::SPHERE_RADIUS, bodyStore.spheres.radius.data(), bodyStore.spheres.radius.size());
+  writer.add(SnapshotSectionId::SPHERE_BODY, bodyStore.spheres.body.data(), bodyStore.spheres.body.size());
+  writer.add(SnapshotSectionId::SLOTS, bodyStore.slots.data(), bodyStore.slots.size());
+  writer.add(SnapshotSectionId::ISLAND_OFFSETS, islandOffsets.data(), islandOffsets.size());
+  writer.add(SnapshotSectionId::ISLAND_BODIES, islandBodies.data(), islandBodies.size());
+  writer.add(SnapshotSectionId::FREE_ISLANDS, bodyStore.freeIslands.data(), bodyStore.freeIslands.size());
+  writer.add(SnapshotSectionId::IMPULSE_CACHE, impulses.data(), impulses.size());
+
+  return writer.write(path, header);
+}
+
+bool PhysicsWorld::loadSnapshot(const std::string &path) {
+  MappedFile file(path);
+  SnapshotReader reader;
+  if (!reader.open(file.getData(), file.getSize())) {
+    return false;
+  }
+
+  const SnapshotHeader &header = reader.getHeader();
+  const uint64_t bodyCount = header.bodyCount;
+  std::span<const SnapshotSettings> settings;
+  std::span<const SnapshotShape> shapes;
+  std::span<const uint32_t> bodyShapes;
+  std::span<const float> sphereRadius;
+  std::span<const uint32_t> sphereBody;
+  std::span<const SnapshotSlot> slots;
+  std::span<const uint64_t> islandOffsets;
+  std::span<const SnapshotSlot> islandBodies;
+  std::span<const uint32_t> freeIslands;
+  std::span<const SnapshotImpulse> impulses;
+
+  bool valid = bodyCount < BodyStore::INVALID_INDEX && reader.get(SnapshotSectionId::SETTINGS, settings) && settings.size() == 1U &&
+               reader.get(SnapshotSectionId::SHAPES, shapes) && reader.get(SnapshotSectionId::BODY_SHAPE, bodyShapes) &&
+               reader.get(SnapshotSectionId::SPHERE_RADIUS, sphereRadius) && reader.get(SnapshotSectionId::SPHERE_BODY, sphereBody) &&
+               reader.get(SnapshotSectionId::SLOTS, slots) && reader.get(SnapshotSectionId::ISLAND_OFFSETS, islandOffsets) &&
+               reader.get(SnapshotSectionId::ISLAND_BODIES, islandBodies) && reader.get(SnapshotSectionId::FREE_ISLANDS, freeIslands) &&
+               reader.get(SnapshotSectionId::IMPULSE_CACHE, impulses);
+
+  visitBodyColumns(bodyStore, [&reader, &valid, bodyCount](SnapshotSectionId id, const auto &column) {
+    std::span<const typename std::decay_t<decltype(column)>::value_type> values;
+    valid = valid && reader.get(id, values) && values.size() == bodyCount;
+  });
+
+  if (!valid || bodyShapes.size() != bodyCount || sphereBody.size() != sphereRadius.size() || islandOffsets.empty() || slots.size() >= BodyStore::INVALID_INDEX) {
+    return false;
+  }
+
+  /* Everything the next step indexes with must be in range, and the handle table has to agree with the bodies, before the world
+     is touched. A bad file is rejected instead of corrupting the world */
+  const SnapshotSettings &setting = settings[0];
+  valid = setting.broadphaseType <= static_cast<uint32_t>(BroadphaseType::DYNAMIC_TREE) &&
+          setting.positionCorrection <= static_cast<uint32_t>(PositionCorrection::SPLIT_IMPULSE);
+
+  for (size_t i = 0U; valid && i < shapes.size(); i++) {
+    valid = isValidShape(shapes[i]);
+  }
+
+  std::span<const uint8_t> shapeTypes;
+  std::span<const uint32_t> shapeEntries;
+  std::span<const SnapshotSlot> ids;
+  std::span<const uint32_t> sleepIslands;
+  reader.get(SnapshotSectionId::SHAPE_TYPE, shapeTypes);
+  reader.get(SnapshotSectionId::SHAPE_INDEX, shapeEntries);
+  reader.get(SnapshotSectionId::BODY_IDS, ids);
+  reader.get(SnapshotSectionId::SLEEP_ISLAND, sleepIslands);
+
+  const size_t islandCount = islandOffsets.size() - 1U;
+  std::vector<uint8_t> slotUsed(slots.size(), 0U);
+  for (size_t i = 0U; valid && i < bodyCount; i++) {
+    valid = bodyShapes[i] < shapes.size() && shapes[bodyShapes[i]].type == shapeTypes[i] && shapeTypes[i] == static_cast<uint8_t>(ShapeType::SPHERE) &&
+            shapeEntries[i] < sphereRadius.size() && sphereBody[shapeEntries[i]] == i && ids[i].index < slots.size() && slots[ids[i].index].index == i &&
+            slots[ids[i].index].generation == ids[i].generation && (sleepIslands[i] == BodyStore::INVALID_INDEX || sleepIslands[i] < islandCount);
+    if (valid) {
+      slotUsed[ids[i].index] = 1U;
+    }
+  }
+
+  /* The free list must visit every other slot once and end */
+  uint32_t freeSlot = header.freeSlotHead;
+  for (size_t remaining = slots.size() - bodyCount; valid && remaining > 0U; remaining--) {
+    valid = freeSlot < slots.size() && !slotUsed[freeSlot];
+    if (valid) {
+      slotUsed[freeSlot] = 1U;
+      freeSlot = slots[freeSlot].index;
+    }
+  }
+  valid = valid && freeSlot == BodyStore::INVALID_INDEX;
+
+  for (size_t i = 0U; valid && i < islandCount; i++) {
+    valid = islandOffsets[0] == 0U && islandOffsets[i] <= islandOffsets[i + 1U] && islandOffsets[i + 1U] <= islandBodies.size();
+  }
+  valid = valid && islandOffsets.back() == islandBodies.size();
+
+  for (size_t i = 0U; valid && i < freeIslands.size(); i++) {
+    valid = freeIslands[i] < islandCount;
+  }
+
+  for (size_t i = 1U; valid && i < impulses.size(); i++) {
+    valid = impulses[i - 1U].cacheKey < impulses[i].cacheKey;
+  }
+
+  if (!valid) {
+    return false;
+  }
+
+  reset();
+
+  setGravity(Vector3D(setting.gravity[0], setting.gravity[1], setting.gravity[2]));
+  setTimeStep(setting.timeStep);
+  setSleepThresholds(setting.linearSleepThreshold, setting.angularSleepThreshold, setting.timeToSleep);
+  sleepingEnabled = setting.sleepingEnabled != 0U;
+  setSolverIterations(setting.velocityIterations, setting.positionIterations);
+  setPositionCorrection(static_cast<PositionCorrection>(setting.positionCorrection));
+  setWarmStarting(setting.warmStarting != 0U);
+
+  visitBodyColumns(bodyStore, [&reader](SnapshotSectionId id, auto &column) {
+    std::span<const typename std::decay_t<decltype(column)>::value_type> values;
+    reader.get(id, values);
+    column.assign(values.data(), values.size());
+  });
+  bodyStore.spheres.radius.assign(sphereRadius.data(), sphereRadius.size());
+  bodyStore.spheres.body.assign(sphereBody.data(), sphereBody.size());
+  bodyStore.broadphaseProxy.resize(bodyCount);
+
+  std::vector<std::shared_ptr<Shape>> shapeTable(shapes.size());
+  for (size_t i = 0U; i < shapes.size(); i++) {
+    shapeTable[i] = createShape(shapes[i]);
+  }
+  bodyStore.shapes.resize(bodyCount);
+  for (size_t i = 0U; i < bodyCount; i++) {
+    bodyStore.shapes[i] = shapeTable[bodyShapes[i]];
+  }
+  bodyStore.views.assign(bodyCount, nullptr);
+  bodies.assign(bodyCount, nullptr);
+
+  bodyStore.slots.resize(slots.size());
+  std::memcpy(bodyStore.slots.data(), slots.data(), slots.size_bytes());
+  bodyStore.freeSlotHead = header.freeSlotHead;
+
+  bodyStore.sleepingIslands.resize(islandCount);
+  for (size_t i = 0U; i < islandCount; i++) {
+    std::vector<BodyId> &island = bodyStore.sleepingIslands[i];
+    island.reserve(islandOffsets[i + 1U] - islandOffsets[i]);
+    for (uint64_t member = islandOffsets[i]; member < islandOffsets[i + 1U]; member++) {
+      island.push_back(BodyId{islandBodies[member].index, islandBodies[member].generation});
+    }
+  }
+  bodyStore.freeIslands.assign(freeIslands.begin(), freeIslands.end());
+
+  contactSolver.impulseCache.resize(impulses.size());
+  for (size_t i = 0U; i < impulses.size(); i++) {
+    const SnapshotImpulse &impulse = impulses[i];
+    contactSolver.impulseCache[i] = ContactSolver::CachedImpulse{impulse.cacheKey, BodyId{impulse.bodyA.index, impulse.bodyA.generation}, BodyId{impulse.bodyB.index, impulse.bodyB.generation},
+                                                                 impulse.normalImpulse, Vector3D(impulse.tangentImpulse[0], impulse.tangentImpulse[1], impulse.tangentImpulse[2])};
+  }
+
+  /* Contacts come out in pair order whatever the broadphase, so a fresh one gives the same steps as the saved world's */
+  setBroadphase(static_cast<BroadphaseType>(setting.broadphaseType));
+  return true;
+}